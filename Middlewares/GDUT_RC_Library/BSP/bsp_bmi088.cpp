@@ -0,0 +1,327 @@
+#include "bsp_bmi088.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numbers>
+
+namespace gdut {
+
+namespace {
+
+// 加速度计寄存器
+constexpr uint8_t acc_chip_id = 0x00;
+constexpr uint8_t acc_data = 0x12;
+constexpr uint8_t acc_conf = 0x40;
+constexpr uint8_t acc_range = 0x41;
+constexpr uint8_t acc_pwr_conf = 0x7C;
+constexpr uint8_t acc_pwr_ctrl = 0x7D;
+constexpr uint8_t acc_softreset = 0x7E;
+constexpr uint8_t acc_chip_id_value = 0x1E;
+constexpr uint8_t acc_conf_bwp_normal = 0xA0;
+constexpr uint8_t acc_pwr_conf_active = 0x00;
+constexpr uint8_t acc_pwr_ctrl_on = 0x04;
+
+// 陀螺仪寄存器
+constexpr uint8_t gyro_chip_id = 0x00;
+constexpr uint8_t gyro_data = 0x02;
+constexpr uint8_t gyro_range = 0x0F;
+constexpr uint8_t gyro_bandwidth = 0x10;
+constexpr uint8_t gyro_softreset = 0x14;
+constexpr uint8_t gyro_int_ctrl = 0x15;
+constexpr uint8_t gyro_int3_int4_io_conf = 0x16;
+constexpr uint8_t gyro_int3_int4_io_map = 0x18;
+constexpr uint8_t gyro_chip_id_value = 0x0F;
+constexpr uint8_t gyro_int_ctrl_data_ready = 0x80;
+constexpr uint8_t gyro_int3_push_pull_high = 0x01;
+constexpr uint8_t gyro_int3_map_data_ready = 0x01;
+
+constexpr uint8_t softreset_cmd = 0xB6;
+constexpr uint8_t read_flag = 0x80;
+constexpr uint8_t dummy_byte = 0xFF;
+
+// 加速度计帧中数据从第 2 字节开始，温度位于 0x22（MSB）/0x23（LSB）
+constexpr std::size_t accel_offset = 2;
+constexpr std::size_t temperature_offset = accel_offset + (0x22 - acc_data);
+
+constexpr float standard_gravity = 9.80665F;
+
+int16_t load_le16(const uint8_t *p) {
+  return static_cast<int16_t>(static_cast<uint16_t>(p[0]) |
+                              (static_cast<uint16_t>(p[1]) << 8U));
+}
+
+struct register_write {
+  bmi088_chip chip;
+  uint8_t reg;
+  uint8_t value;
+  uint32_t delay_ms;
+};
+
+struct register_check {
+  bmi088_chip chip;
+  uint8_t reg;
+  uint8_t mask;
+  uint8_t value;
+};
+
+} // namespace
+
+bmi088::bmi088(bmi088_transport &transport) : m_transport(&transport) {
+  // 读命令之后的字节在 MOSI 上发送 0xFF
+  std::fill(std::begin(m_gyro_tx), std::end(m_gyro_tx), dummy_byte);
+  std::fill(std::begin(m_accel_tx), std::end(m_accel_tx), dummy_byte);
+  m_gyro_tx[0] = gyro_data | read_flag;
+  m_accel_tx[0] = acc_data | read_flag;
+  reset_stats();
+}
+
+std::error_code bmi088::init(const bmi088_config &config) {
+  using enum bmi088_chip;
+  stop();
+
+  uint8_t value = 0;
+  // 加速度计上电后处于 I2C 模式，片选的一个上升沿切换到 SPI，本次读数无效
+  if (std::error_code ec = read_register(accel, acc_chip_id, value)) {
+    return ec;
+  }
+  if (std::error_code ec =
+          write_register(accel, acc_softreset, softreset_cmd)) {
+    return ec;
+  }
+  m_transport->delay_ms(1);
+  // 软复位后回到 I2C 模式，再切换一次
+  if (std::error_code ec = read_register(accel, acc_chip_id, value)) {
+    return ec;
+  }
+  if (std::error_code ec = read_register(accel, acc_chip_id, value)) {
+    return ec;
+  }
+  if (value != acc_chip_id_value) {
+    return bmi088_error_code::accel_not_found;
+  }
+
+  if (std::error_code ec =
+          write_register(gyro, gyro_softreset, softreset_cmd)) {
+    return ec;
+  }
+  m_transport->delay_ms(30);
+  if (std::error_code ec = read_register(gyro, gyro_chip_id, value)) {
+    return ec;
+  }
+  if (value != gyro_chip_id_value) {
+    return bmi088_error_code::gyro_not_found;
+  }
+
+  const uint8_t accel_conf =
+      acc_conf_bwp_normal | std::to_underlying(config.accel_odr);
+  const register_write writes[] = {
+      {accel, acc_pwr_conf, acc_pwr_conf_active, 1},
+      {accel, acc_pwr_ctrl, acc_pwr_ctrl_on, 5},
+      {accel, acc_conf, accel_conf, 0},
+      {accel, acc_range, std::to_underlying(config.accel_range), 0},
+      {gyro, gyro_range, std::to_underlying(config.gyro_range), 0},
+      {gyro, gyro_bandwidth, std::to_underlying(config.gyro_odr), 0},
+      {gyro, gyro_int_ctrl, gyro_int_ctrl_data_ready, 0},
+      {gyro, gyro_int3_int4_io_conf, gyro_int3_push_pull_high, 0},
+      {gyro, gyro_int3_int4_io_map, gyro_int3_map_data_ready, 0},
+  };
+  for (const register_write &write : writes) {
+    if (std::error_code ec =
+            write_register(write.chip, write.reg, write.value)) {
+      return ec;
+    }
+    if (write.delay_ms != 0U) {
+      m_transport->delay_ms(write.delay_ms);
+    }
+  }
+
+  // GYRO_BANDWIDTH 的 bit7 读出恒为 1，只比较低 4 位
+  const register_check checks[] = {
+      {accel, acc_conf, 0xFF, accel_conf},
+      {accel, acc_range, 0x03, std::to_underlying(config.accel_range)},
+      {gyro, gyro_range, 0xFF, std::to_underlying(config.gyro_range)},
+      {gyro, gyro_bandwidth, 0x0F, std::to_underlying(config.gyro_odr)},
+  };
+  for (const register_check &check : checks) {
+    if (std::error_code ec = read_register(check.chip, check.reg, value)) {
+      return ec;
+    }
+    if ((value & check.mask) != check.value) {
+      return bmi088_error_code::config_rejected;
+    }
+  }
+
+  const auto gyro_full_scale = static_cast<float>(
+      2000U >> std::to_underlying(config.gyro_range)); // °/s
+  const auto accel_full_scale = static_cast<float>(
+      3U << std::to_underlying(config.accel_range)); // g
+  m_gyro_scale = gyro_full_scale / 32768.0F * std::numbers::pi_v<float> /
+                 180.0F;
+  m_accel_scale = accel_full_scale / 32768.0F * standard_gravity;
+  return {};
+}
+
+void bmi088::start() noexcept {
+  interrupt_lock lock;
+  // 停止期间的间隔不计入采样周期统计
+  m_has_last_trigger = false;
+  m_running = true;
+}
+
+void bmi088::on_data_ready(uint32_t timestamp) {
+  if (!m_running) {
+    return;
+  }
+
+  if (m_has_last_trigger) {
+    const uint32_t period = timestamp - m_last_trigger;
+    m_stats.period_min = std::min(m_stats.period_min, period);
+    m_stats.period_max = std::max(m_stats.period_max, period);
+  }
+  m_last_trigger = timestamp;
+  m_has_last_trigger = true;
+
+  if (m_reading) {
+    ++m_stats.dropped_busy;
+    return;
+  }
+  m_reading = true;
+  m_trigger = timestamp;
+  if (!m_transport->exchange(
+          bmi088_chip::gyro, m_gyro_tx, m_gyro_rx,
+          [this](std::error_code ec) { on_gyro_done(ec); })) {
+    fail();
+  }
+}
+
+void bmi088::on_gyro_done(std::error_code ec) {
+  if (ec) {
+    fail();
+    return;
+  }
+  // 在陀螺仪读取的完成回调中提交，总线空闲时立即开始
+  auto on_done = [this](std::error_code result) { on_accel_done(result); };
+  if (!m_transport->exchange(bmi088_chip::accel, m_accel_tx, m_accel_rx,
+                             std::move(on_done))) {
+    fail();
+  }
+}
+
+void bmi088::on_accel_done(std::error_code ec) {
+  if (ec) {
+    fail();
+    return;
+  }
+  push(decode(m_trigger, m_gyro_rx, m_accel_rx));
+  m_stats.latency_max =
+      std::max(m_stats.latency_max, m_transport->now() - m_trigger);
+  m_reading = false;
+}
+
+void bmi088::fail() {
+  ++m_stats.bus_errors;
+  m_reading = false;
+}
+
+void bmi088::push(const bmi088_raw_sample &sample) {
+  const uint32_t head = m_head.load(std::memory_order_relaxed);
+  if (head - m_tail.load(std::memory_order_acquire) >= ring_size) {
+    ++m_stats.dropped_full;
+    return;
+  }
+  m_ring[head & (ring_size - 1U)] = sample;
+  // release：样本写入先于 head 更新对消费者可见
+  m_head.store(head + 1U, std::memory_order_release);
+  ++m_stats.samples;
+}
+
+std::size_t bmi088::read_raw(std::span<bmi088_raw_sample> out) {
+  const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+  const uint32_t head = m_head.load(std::memory_order_acquire);
+  const std::size_t count =
+      std::min<std::size_t>(head - tail, out.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = m_ring[(tail + i) & (ring_size - 1U)];
+  }
+  // 复制完成后才归还槽位给生产者
+  m_tail.store(tail + static_cast<uint32_t>(count),
+               std::memory_order_release);
+  return count;
+}
+
+std::size_t bmi088::read(std::span<bmi088_sample> out) {
+  const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+  const uint32_t head = m_head.load(std::memory_order_acquire);
+  const std::size_t count =
+      std::min<std::size_t>(head - tail, out.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = convert(m_ring[(tail + i) & (ring_size - 1U)]);
+  }
+  m_tail.store(tail + static_cast<uint32_t>(count),
+               std::memory_order_release);
+  return count;
+}
+
+bmi088_stats bmi088::stats() const noexcept {
+  interrupt_lock lock;
+  return m_stats;
+}
+
+void bmi088::reset_stats() noexcept {
+  interrupt_lock lock;
+  m_stats = {};
+  m_stats.period_min = std::numeric_limits<uint32_t>::max();
+  m_has_last_trigger = false;
+}
+
+bmi088_sample bmi088::convert(const bmi088_raw_sample &raw) const {
+  bmi088_sample sample{};
+  sample.timestamp = raw.timestamp;
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    sample.gyro[axis] = static_cast<float>(raw.gyro[axis]) * m_gyro_scale;
+    sample.accel[axis] = static_cast<float>(raw.accel[axis]) * m_accel_scale;
+  }
+  sample.temperature = static_cast<float>(raw.temperature) * 0.125F + 23.0F;
+  return sample;
+}
+
+bmi088_raw_sample
+bmi088::decode(uint32_t timestamp,
+               std::span<const uint8_t, gyro_frame_size> gyro_frame,
+               std::span<const uint8_t, accel_frame_size> accel_frame) {
+  bmi088_raw_sample sample{};
+  sample.timestamp = timestamp;
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    sample.gyro[axis] = load_le16(&gyro_frame[1 + axis * 2]);
+    sample.accel[axis] = load_le16(&accel_frame[accel_offset + axis * 2]);
+  }
+  // 温度为 11 位有符号数：MSB 为高 8 位，LSB 的高 3 位为低 3 位
+  int32_t temperature =
+      (static_cast<int32_t>(accel_frame[temperature_offset]) << 3) |
+      (accel_frame[temperature_offset + 1] >> 5);
+  if (temperature > 1023) {
+    temperature -= 2048;
+  }
+  sample.temperature = static_cast<int16_t>(temperature);
+  return sample;
+}
+
+std::error_code bmi088::write_register(bmi088_chip chip, uint8_t reg,
+                                       uint8_t value) {
+  m_reg_tx[0] = reg & static_cast<uint8_t>(~read_flag);
+  m_reg_tx[1] = value;
+  return m_transport->transfer(chip, {m_reg_tx, 2}, {});
+}
+
+std::error_code bmi088::read_register(bmi088_chip chip, uint8_t reg,
+                                      uint8_t &value) {
+  // 加速度计的读时序在地址字节之后多一个哑字节
+  const std::size_t skip = chip == bmi088_chip::accel ? 1U : 0U;
+  m_reg_tx[0] = reg | read_flag;
+  std::error_code ec =
+      m_transport->transfer(chip, {m_reg_tx, 1}, {m_reg_rx, 1 + skip});
+  value = m_reg_rx[skip];
+  return ec;
+}
+
+} // namespace gdut
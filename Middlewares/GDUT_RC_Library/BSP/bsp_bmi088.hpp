@@ -0,0 +1,342 @@
+#ifndef BSP_BMI088_HPP
+#define BSP_BMI088_HPP
+
+#include "bsp_function.hpp"
+#include "bsp_platform.hpp"
+#include "bsp_uncopyable.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+
+namespace gdut {
+
+/**
+ * @brief BMI088 驱动错误码（总线传输错误沿用 transport 上报的错误码）
+ */
+enum class bmi088_error_code : uint32_t {
+  none = 0,
+  accel_not_found, ///< 加速度计芯片 ID 不匹配（片选或接线错误）
+  gyro_not_found,  ///< 陀螺仪芯片 ID 不匹配（片选或接线错误）
+  config_rejected  ///< 写入的量程/输出频率回读不一致
+};
+
+/**
+ * @brief bmi088_error_code 的 std::error_category 实现
+ */
+class bmi088_error_category : public std::error_category {
+public:
+  constexpr bmi088_error_category() noexcept = default;
+
+  const char *name() const noexcept override { return "bmi088_error_code"; }
+
+  std::string message(int ev) const override {
+    switch (static_cast<bmi088_error_code>(ev)) {
+    case bmi088_error_code::none:
+      return "No error";
+    case bmi088_error_code::accel_not_found:
+      return "Accelerometer chip ID mismatch";
+    case bmi088_error_code::gyro_not_found:
+      return "Gyroscope chip ID mismatch";
+    case bmi088_error_code::config_rejected:
+      return "Configuration read-back mismatch";
+    default:
+      return "Unknown error";
+    }
+  }
+
+  static const bmi088_error_category &instance() {
+    static bmi088_error_category instance;
+    return instance;
+  }
+};
+
+inline std::error_code make_error_code(bmi088_error_code e) {
+  return {static_cast<int>(e), bmi088_error_category::instance()};
+}
+
+} // namespace gdut
+
+namespace std {
+
+/// 启用 gdut::bmi088_error_code 到 std::error_code 的隐式转换
+template <> struct is_error_code_enum<gdut::bmi088_error_code> : true_type {};
+
+} // namespace std
+
+namespace gdut {
+
+/// 陀螺仪量程（GYRO_RANGE 寄存器取值）
+enum class bmi088_gyro_range : uint8_t {
+  dps2000 = 0x00,
+  dps1000 = 0x01,
+  dps500 = 0x02,
+  dps250 = 0x03,
+  dps125 = 0x04
+};
+
+/// 陀螺仪输出频率 / 滤波带宽（GYRO_BANDWIDTH 寄存器取值）
+enum class bmi088_gyro_odr : uint8_t {
+  hz2000_bw532 = 0x00,
+  hz2000_bw230 = 0x01,
+  hz1000_bw116 = 0x02,
+  hz400_bw47 = 0x03,
+  hz200_bw23 = 0x04,
+  hz100_bw12 = 0x05,
+  hz200_bw64 = 0x06,
+  hz100_bw32 = 0x07
+};
+
+/// 加速度计量程（ACC_RANGE 寄存器取值）
+enum class bmi088_accel_range : uint8_t {
+  g3 = 0x00,
+  g6 = 0x01,
+  g12 = 0x02,
+  g24 = 0x03
+};
+
+/// 加速度计输出频率（ACC_CONF 低 4 位，滤波固定为 normal 模式）
+enum class bmi088_accel_odr : uint8_t {
+  hz12_5 = 0x05,
+  hz25 = 0x06,
+  hz50 = 0x07,
+  hz100 = 0x08,
+  hz200 = 0x09,
+  hz400 = 0x0A,
+  hz800 = 0x0B,
+  hz1600 = 0x0C
+};
+
+struct bmi088_config {
+  bmi088_gyro_range gyro_range{bmi088_gyro_range::dps2000};
+  bmi088_gyro_odr gyro_odr{bmi088_gyro_odr::hz2000_bw532};
+  bmi088_accel_range accel_range{bmi088_accel_range::g6};
+  bmi088_accel_odr accel_odr{bmi088_accel_odr::hz1600};
+};
+
+/// BMI088 封装内的两颗芯片，各自有独立的片选
+enum class bmi088_chip : uint8_t { accel, gyro };
+
+/**
+ * @brief bmi088 访问总线与时钟的接口
+ *
+ * 寄存器编排、帧解包与采集状态机只经由该接口访问硬件，bsp_bmi088.hpp/.cpp
+ * 不依赖 HAL，可以在主机上对脚本化的假传感器测试。目标板上使用
+ * bsp_bmi088_spi.hpp 中基于 spi_bus 的 bmi088_spi_transport。
+ */
+class bmi088_transport {
+public:
+  using callback_t = function<void(std::error_code)>;
+
+  virtual ~bmi088_transport() noexcept = default;
+
+  /**
+   * @brief 阻塞传输（仅任务上下文）：同一次片选内先发送 tx，再接收 rx
+   */
+  virtual std::error_code transfer(bmi088_chip chip,
+                                   std::span<const uint8_t> tx,
+                                   std::span<uint8_t> rx) = 0;
+
+  /**
+   * @brief 提交一次全双工传输（任务或中断上下文），tx 与 rx 等长
+   * @return 提交成功返回 true，完成后在中断上下文调用 callback；
+   *         提交失败返回 false，不调用 callback
+   */
+  virtual bool exchange(bmi088_chip chip, std::span<const uint8_t> tx,
+                        std::span<uint8_t> rx, callback_t &&callback) = 0;
+
+  /// 阻塞至少 ms 毫秒（仅任务上下文）
+  virtual void delay_ms(uint32_t ms) = 0;
+
+  /// 当前时间戳（CPU 周期），用于样本时刻与延迟统计
+  [[nodiscard]] virtual uint32_t now() noexcept = 0;
+};
+
+/**
+ * @brief 中断中入队的原始样本（未换算）
+ *
+ * timestamp 为陀螺仪数据就绪中断时刻的 bmi088_transport::now()
+ * （目标板上为 DWT CYCCNT）。
+ */
+struct bmi088_raw_sample {
+  uint32_t timestamp;
+  int16_t gyro[3];     ///< x, y, z
+  int16_t accel[3];    ///< x, y, z
+  int16_t temperature; ///< 11 位有符号数，0.125 °C/LSB，零点 23 °C
+};
+
+/// 换算到国际单位的样本
+struct bmi088_sample {
+  uint32_t timestamp; ///< 数据就绪时刻（CPU 周期）
+  float gyro[3];      ///< rad/s
+  float accel[3];     ///< m/s²
+  float temperature;  ///< °C
+};
+
+/**
+ * @brief 采集统计（周期与延迟单位均为 CPU 周期）
+ */
+struct bmi088_stats {
+  uint32_t samples;      ///< 成功入队的样本数
+  uint32_t dropped_busy; ///< 上一次读取未完成时到来的数据就绪（丢弃）
+  uint32_t dropped_full; ///< 环形缓冲区已满而丢弃的样本
+  uint32_t bus_errors;   ///< SPI 提交失败或传输错误
+  uint32_t period_min;   ///< 相邻两次数据就绪的最小间隔
+  uint32_t period_max;   ///< 相邻两次数据就绪的最大间隔
+  uint32_t latency_max;  ///< 数据就绪到样本入队的最大延迟
+
+  /// 采样周期抖动（峰峰值）；尚未测得两个周期时为 0
+  [[nodiscard]] uint32_t jitter() const noexcept {
+    return period_max >= period_min ? period_max - period_min : 0U;
+  }
+};
+
+/**
+ * @brief BMI088 数据就绪触发的 IMU 采集管线
+ *
+ * 陀螺仪 INT3 数据就绪 → EXTI 中断记录时间戳并提交陀螺仪突发读 →
+ * 完成回调中提交加速度计 + 温度突发读 → 完成回调中解包并写入无锁环形
+ * 缓冲区。消费者在任务中批量取出并换算到国际单位。
+ *
+ * 特性：
+ * - 两次读取均为全双工 exchange（bmi088_spi_transport 中为 spi_bus
+ *   高优先级事务），每个样本只有一次 EXTI 中断和两次 DMA 完成中断，
+ *   中断中不做浮点运算
+ * - 单生产者单消费者环形缓冲区（ring_size 个样本），缓冲区满时丢弃新样本
+ *   并计数，已入队的样本保持时间顺序
+ * - 统计丢样（读取未完成 / 缓冲区满）、总线错误、采样周期的最小/最大值
+ *   （抖动）与数据就绪到入队的最大延迟
+ * - 总线、延时与时钟都经由 bmi088_transport，驱动本身不依赖 HAL，
+ *   初始化序列、解包、换算与错误路径可以在主机上对假传感器测试
+ *
+ * 线程安全：
+ * - 生产者为中断（EXTI 与 SPI DMA），消费者为单个任务；read()/read_raw()
+ *   不能在多个任务中同时调用
+ * - init()/start()/stop() 仅任务上下文
+ *
+ * 重要约束：
+ * - 数据就绪 EXTI 与 SPI 两个 DMA 数据流中断须配置为相同的抢占优先级
+ * - 对象内含 DMA 收发缓冲区，不能定义在 CCMRAM 中
+ * - transport 在对象的整个生命周期内必须保持有效
+ * - 加速度计最高 1600 Hz，2 kHz 采样时相邻样本的加速度可能相同
+ *
+ * 使用示例：
+ * @code
+ * gdut::spi_device accel(spi1, accel_cs, imu_config);
+ * gdut::spi_device gyro(spi1, gyro_cs, imu_config);
+ * gdut::bmi088_spi_transport imu_bus(accel, gyro);
+ * gdut::bmi088 imu(imu_bus);
+ *
+ * // 任务中
+ * gdut::cycle_counter::enable();
+ * if (!imu.init()) { imu.start(); }
+ *
+ * // HAL_GPIO_EXTI_Callback 中（陀螺仪 INT3）
+ * imu.data_ready_irq_handler();
+ *
+ * // 控制任务中批量取出
+ * gdut::bmi088_sample samples[8];
+ * std::size_t n = imu.read(samples);
+ * @endcode
+ */
+class bmi088 : uncopyable {
+public:
+  static constexpr std::size_t ring_size = 32;
+  /// 陀螺仪帧：读命令 + X/Y/Z（0x02~0x07）
+  static constexpr std::size_t gyro_frame_size = 1 + 6;
+  /// 加速度计帧：读命令 + 哑字节 + 0x12~0x23（加速度、传感器时间、温度）
+  static constexpr std::size_t accel_frame_size = 2 + 18;
+
+  static_assert((ring_size & (ring_size - 1U)) == 0U,
+                "ring_size must be a power of two");
+
+  explicit bmi088(bmi088_transport &transport);
+  ~bmi088() noexcept = default;
+
+  /**
+   * @brief 复位并配置两颗芯片，使能陀螺仪 INT3 数据就绪输出（推挽、高有效）
+   *
+   * 阻塞执行（仅任务上下文），约需 40 ms。会先停止采集。
+   */
+  std::error_code init(const bmi088_config &config = {});
+
+  /// 开始响应数据就绪中断
+  void start() noexcept;
+  /// 停止响应数据就绪中断；正在进行的读取仍会完成
+  void stop() noexcept { m_running = false; }
+  [[nodiscard]] bool running() const noexcept { return m_running; }
+
+  /// 在陀螺仪 INT3 的 EXTI 回调中调用
+  void data_ready_irq_handler() { on_data_ready(m_transport->now()); }
+
+  /**
+   * @brief 数据就绪处理：记录时间戳并启动一次突发读
+   * @param timestamp  数据就绪时刻（与 bmi088_transport::now() 同一时基）
+   */
+  void on_data_ready(uint32_t timestamp);
+
+  /// 取出最多 out.size() 个样本并换算到国际单位，返回取出的个数
+  std::size_t read(std::span<bmi088_sample> out);
+
+  /// 取出最多 out.size() 个原始样本，返回取出的个数
+  std::size_t read_raw(std::span<bmi088_raw_sample> out);
+
+  /// 缓冲区中待取出的样本数
+  [[nodiscard]] std::size_t available() const noexcept {
+    return m_head.load(std::memory_order_acquire) -
+           m_tail.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bmi088_stats stats() const noexcept;
+  void reset_stats() noexcept;
+
+  /// 按 init() 配置的量程换算一个原始样本
+  [[nodiscard]] bmi088_sample convert(const bmi088_raw_sample &raw) const;
+
+  /// 从陀螺仪帧与加速度计帧（含命令字节）解包原始样本
+  static bmi088_raw_sample
+  decode(uint32_t timestamp,
+         std::span<const uint8_t, gyro_frame_size> gyro_frame,
+         std::span<const uint8_t, accel_frame_size> accel_frame);
+
+private:
+  std::error_code write_register(bmi088_chip chip, uint8_t reg,
+                                 uint8_t value);
+  std::error_code read_register(bmi088_chip chip, uint8_t reg,
+                                uint8_t &value);
+  void on_gyro_done(std::error_code ec);
+  void on_accel_done(std::error_code ec);
+  void push(const bmi088_raw_sample &sample);
+  void fail();
+
+  bmi088_transport *m_transport;
+
+  // 全双工 DMA 收发缓冲区
+  uint8_t m_gyro_tx[gyro_frame_size]{};
+  uint8_t m_gyro_rx[gyro_frame_size]{};
+  uint8_t m_accel_tx[accel_frame_size]{};
+  uint8_t m_accel_rx[accel_frame_size]{};
+  // init() 中寄存器读写使用
+  uint8_t m_reg_tx[2]{};
+  uint8_t m_reg_rx[2]{};
+
+  float m_gyro_scale{0.0F};
+  float m_accel_scale{0.0F};
+
+  volatile bool m_running{false};
+  volatile bool m_reading{false};
+  uint32_t m_trigger{0};
+  uint32_t m_last_trigger{0};
+  bool m_has_last_trigger{false};
+  bmi088_stats m_stats{};
+
+  bmi088_raw_sample m_ring[ring_size]{};
+  std::atomic<uint32_t> m_head{0}; // 仅生产者（中断）写
+  std::atomic<uint32_t> m_tail{0}; // 仅消费者（任务）写
+};
+
+} // namespace gdut
+
+#endif // BSP_BMI088_HPP
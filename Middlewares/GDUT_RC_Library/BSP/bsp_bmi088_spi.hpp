@@ -0,0 +1,59 @@
+#ifndef BSP_BMI088_SPI_HPP
+#define BSP_BMI088_SPI_HPP
+
+#include "bsp_bmi088.hpp"
+#include "bsp_clock.hpp"
+#include "bsp_platform.hpp"
+#include "bsp_spi_bus.hpp"
+
+#include <cstdint>
+#include <span>
+#include <system_error>
+
+namespace gdut {
+
+/**
+ * @brief 基于 spi_bus 的 bmi088_transport
+ *
+ * - transfer() 为 spi_device::transfer()，先发送后接收
+ * - exchange() 为 spi_bus 高优先级的全双工事务
+ * - 时间戳为 cycle_counter::now()（DWT CYCCNT），使用前须调用
+ *   cycle_counter::enable()
+ *
+ * 两个 spi_device 须挂在同一条 spi_bus 上，且在对象的整个生命周期内
+ * 保持有效。
+ */
+class bmi088_spi_transport final : public bmi088_transport {
+public:
+  bmi088_spi_transport(spi_device &accel, spi_device &gyro)
+      : m_accel(&accel), m_gyro(&gyro) {}
+
+  std::error_code transfer(bmi088_chip chip, std::span<const uint8_t> tx,
+                           std::span<uint8_t> rx) override {
+    return device(chip).transfer(tx, rx);
+  }
+
+  bool exchange(bmi088_chip chip, std::span<const uint8_t> tx,
+                std::span<uint8_t> rx, callback_t &&callback) override {
+    return device(chip).exchange(tx, rx, std::move(callback),
+                                 spi_priority::high);
+  }
+
+  void delay_ms(uint32_t ms) override { gdut::delay_ms(ms); }
+
+  [[nodiscard]] uint32_t now() noexcept override {
+    return cycle_counter::now();
+  }
+
+private:
+  spi_device &device(bmi088_chip chip) const noexcept {
+    return chip == bmi088_chip::accel ? *m_accel : *m_gyro;
+  }
+
+  spi_device *m_accel;
+  spi_device *m_gyro;
+};
+
+} // namespace gdut
+
+#endif // BSP_BMI088_SPI_HPP
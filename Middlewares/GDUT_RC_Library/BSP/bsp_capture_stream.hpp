@@ -0,0 +1,395 @@
+#ifndef BSP_CAPTURE_STREAM_HPP
+#define BSP_CAPTURE_STREAM_HPP
+
+#include "bsp_dma.hpp"
+#include "bsp_timer.hpp"
+#include "bsp_type_traits.hpp"
+#include "bsp_uncopyable.hpp"
+#include "stm32f4xx_hal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gdut {
+
+/**
+ * @brief 一个窗口内的脉冲统计结果
+ */
+struct pulse_stats {
+  std::size_t edges{0};   ///< 窗口内新处理的边沿数
+  std::size_t periods{0}; ///< 参与计算的完整周期数
+  float period{0.0F};     ///< 平均周期（秒），periods 为 0 时为 0
+  float frequency{0.0F};  ///< 平均频率（Hz）
+  float duty{0.0F};       ///< 占空比 [0, 1]，仅双边沿捕获时有效
+};
+
+/**
+ * @brief 基于循环 DMA 的输入捕获流
+ *
+ * 捕获通道的 DMA 请求把每次捕获的 CCRx 写入对象内的环形缓冲区，CPU 不参与
+ * 单个边沿的处理；读者按需取出尚未读取的捕获值。适合 PWM 输出型传感器、
+ * 霍尔信号、超声波回波等高边沿率的脉冲测量。
+ *
+ * 特性：
+ * - 每写满一圈缓冲区才有一次 DMA 传输完成中断（用于累计圈数），
+ *   与边沿率无关
+ * - 写入位置 = 圈数 × Size + (Size − NDTR)；圈数已回绕但中断尚未执行时
+ *   按写入位置所在的半区补上一圈
+ * - 读者落后超过一圈时丢弃最旧的一半并计入 overruns()，不会读到
+ *   被覆盖的数据
+ * - 捕获值按计数器量程（ARR + 1）做差，累加为单调递增的 64 位时间戳
+ *   （定时器计数单位）
+ * - measure() 一次取出全部新边沿，计算窗口内的平均周期、频率与占空比
+ *
+ * 线程安全：
+ * - read()/measure()/available() 只能由同一个任务（或同一个中断）调用
+ * - DMA 完成中断只更新圈数，与读者之间无需加锁
+ *
+ * 重要约束：
+ * - 捕获通道的 DMA 须在 CubeMX 中配置为：外设到存储器、循环模式、
+ *   存储器地址递增、外设与存储器数据宽度均为字（Word），并链接到
+ *   htim->hdma[TIM_DMA_ID_CCx]；start() 检查这些配置
+ * - DMA 中断须使能并调用 HAL_DMA_IRQHandler
+ * - 相邻两次捕获的间隔须小于一个计数器周期（ARR + 1 个计数）；
+ *   长间隔信号使用 32 位的 TIM2/TIM5
+ * - 两次读取之间的边沿数须小于 Size
+ * - 双边沿捕获须在构造时给出该通道的输入引脚：start() 在关中断期间
+ *   读取引脚电平并使能捕获，低电平时第一个边沿为上升沿；双边沿捕获
+ *   不能与输入预分频（ICxPSC > 1）同时使用
+ * - 对象内含 DMA 缓冲区，不能定义在 CCMRAM 中
+ *
+ * 使用示例：
+ * @code
+ * gdut::timer echo_timer(&htim5); // 1 MHz 计数，通道 1 双边沿捕获
+ * // 通道 1 的输入引脚 PA0（TIM5_CH1），用于判断第一个边沿的极性
+ * gdut::capture_stream<64> echo(echo_timer, TIM_CHANNEL_1,
+ *                               gdut::gpio_port::A, GPIO_PIN_0);
+ *
+ * echo.start();
+ *
+ * // 控制回路
+ * gdut::pulse_stats s = echo.measure();
+ * if (s.periods > 0) {
+ *   float high_time = s.period * s.duty;
+ * }
+ * @endcode
+ */
+template <std::size_t Size> class capture_stream : uncopyable {
+  static_assert(Size >= 2 && (Size & (Size - 1)) == 0,
+                "Size must be a power of two");
+  static_assert(Size <= 32768, "Size exceeds DMA NDTR range");
+
+public:
+  /**
+   * @brief 绑定定时器的一个输入捕获通道
+   *
+   * @param tim         定时器（通道须已配置为输入捕获）
+   * @param channel     TIM_CHANNEL_1 ~ TIM_CHANNEL_4
+   * @param input_port  该通道的输入引脚所在端口；双边沿捕获时必须给出，
+   *                    单边沿捕获时可省略
+   * @param input_pin   输入引脚（GPIO_PIN_x）
+   */
+  capture_stream(timer &tim, uint32_t channel,
+                 gpio_port input_port = gpio_port{}, uint16_t input_pin = 0)
+      : m_timer(&tim), m_htim(tim.get_htim()),
+        m_input_port(get_gpio_port_ptr(input_port)), m_input_pin(input_pin),
+        m_channel(channel) {
+    if (m_htim == nullptr || channel > TIM_CHANNEL_4 ||
+        (channel & 0x3U) != 0U) {
+      m_htim = nullptr;
+      return;
+    }
+    m_hdma = m_htim->hdma[TIM_DMA_ID_CC1 + channel / 4U];
+  }
+
+  ~capture_stream() noexcept { stop(); }
+
+  [[nodiscard]] bool valid() const noexcept {
+    return m_htim != nullptr && m_hdma != nullptr;
+  }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /**
+   * @brief 启动捕获与循环 DMA
+   *
+   * 捕获边沿（单边沿/双边沿）与输入预分频从通道配置中读取。
+   * 双边沿捕获时，在关中断期间读取输入引脚电平后立即使能捕获：
+   * 引脚为低电平则第一个被捕获的边沿为上升沿，否则为下降沿，
+   * 占空比不依赖调用方对信号相位的猜测。
+   *
+   * @return DMA 配置不符合要求、缓冲区位于 CCMRAM、双边沿捕获未给出
+   *         输入引脚或同时使用了输入预分频时返回 HAL_ERROR
+   */
+  HAL_StatusTypeDef start() {
+    if (!valid()) {
+      return HAL_ERROR;
+    }
+    const DMA_InitTypeDef &init = m_hdma->Init;
+    if (init.Direction != DMA_PERIPH_TO_MEMORY ||
+        init.Mode != DMA_CIRCULAR || init.MemInc != DMA_MINC_ENABLE ||
+        init.PeriphDataAlignment != DMA_PDATAALIGN_WORD ||
+        init.MemDataAlignment != DMA_MDATAALIGN_WORD ||
+        !check_dma_buffer(m_buffer)) {
+      return HAL_ERROR;
+    }
+
+    TIM_TypeDef *tim = m_htim->Instance;
+    const uint32_t index = m_channel / 4U;
+    // CCxP 与 CCxNP 同时置位为双边沿捕获
+    const uint32_t both = (TIM_CCER_CC1P | TIM_CCER_CC1NP) << m_channel;
+    m_both_edges = (tim->CCER & both) == both;
+    // ICxPSC：每 1/2/4/8 个边沿捕获一次
+    const uint32_t ccmr = index < 2U ? tim->CCMR1 : tim->CCMR2;
+    const uint32_t psc_shift = (index & 1U) != 0U ? 10U : 2U;
+    m_edges_per_capture = 1U << ((ccmr >> psc_shift) & 0x3U);
+    // 预分频时每次捕获之间跨越多个边沿，相邻捕获的极性不再交替，
+    // 高/低电平时间没有意义
+    if (m_both_edges &&
+        (m_edges_per_capture > 1U || m_input_port == nullptr)) {
+      return HAL_ERROR;
+    }
+    m_range = static_cast<uint64_t>(tim->ARR) + 1U;
+    m_tick_hz = m_timer->get_counter_frequency();
+
+    m_laps = 0;
+    m_read = 0;
+    m_overruns = 0;
+    m_time = 0;
+    m_has_last = false;
+    m_first_rising = true;
+
+    m_hdma->Parent = this;
+    m_hdma->XferCpltCallback = &capture_stream::lap_cb;
+    // 不使用半传输中断
+    m_hdma->XferHalfCpltCallback = nullptr;
+    m_hdma->XferErrorCallback = nullptr;
+    volatile uint32_t *ccr = &tim->CCR1 + index;
+    HAL_StatusTypeDef status = HAL_DMA_Start_IT(
+        m_hdma, reinterpret_cast<uint32_t>(ccr),
+        reinterpret_cast<uint32_t>(m_buffer), Size);
+    if (status != HAL_OK) {
+      return status;
+    }
+    __HAL_TIM_ENABLE_DMA(m_htim, TIM_DMA_CC1 << index);
+    // 读电平与使能捕获之间不被中断打断，间隔只有几个周期；
+    // 此间隔或输入滤波（ICxF）延迟之内的边沿仍可能使极性判断相反
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (m_both_edges) {
+      m_first_rising =
+          HAL_GPIO_ReadPin(m_input_port, m_input_pin) == GPIO_PIN_RESET;
+    }
+    TIM_CCxChannelCmd(tim, m_channel, TIM_CCx_ENABLE);
+    __set_PRIMASK(primask);
+    __HAL_TIM_ENABLE(m_htim);
+    return HAL_OK;
+  }
+
+  HAL_StatusTypeDef stop() {
+    if (!valid()) {
+      return HAL_ERROR;
+    }
+    if (m_hdma->Parent != this) {
+      return HAL_OK; // 未启动
+    }
+    TIM_CCxChannelCmd(m_htim->Instance, m_channel, TIM_CCx_DISABLE);
+    __HAL_TIM_DISABLE_DMA(m_htim, TIM_DMA_CC1 << (m_channel / 4U));
+    m_hdma->XferCpltCallback = nullptr;
+    m_hdma->Parent = nullptr;
+    return HAL_DMA_Abort(m_hdma);
+  }
+
+  /// 尚未读取的捕获数（超过 Size 时为 Size）
+  [[nodiscard]] std::size_t available() const noexcept {
+    const uint32_t pending = written() - m_read;
+    return pending > Size ? Size : pending;
+  }
+
+  /**
+   * @brief 取出尚未读取的捕获时间戳
+   *
+   * 时间戳以定时器计数为单位，单调递增；发生溢出丢弃后，时间戳在丢弃处
+   * 不连续（间隔未知），从下一个边沿重新累计。
+   *
+   * @return 实际写入 out 的个数
+   */
+  std::size_t read(std::span<uint64_t> out) noexcept {
+    const uint32_t end = resync();
+    std::size_t count = 0;
+    drain(end, out.size(), [&](uint64_t time, bool) { out[count++] = time; });
+    return count;
+  }
+
+  /**
+   * @brief 取出全部新边沿并统计窗口内的周期、频率与占空比
+   *
+   * 窗口从上一次读取的最后一个边沿开始，相邻窗口首尾相接；
+   * 周期只统计到窗口内最后一个与起始边沿同极性的边沿，占空比不因窗口
+   * 截断在半个周期上而偏移。
+   */
+  pulse_stats measure() noexcept {
+    const uint32_t last = resync();
+    pulse_stats stats{};
+    bool has_start = m_has_last;
+    bool start_rising = m_last_rising;
+    uint64_t start = m_time;
+    uint64_t end = m_time;
+    uint64_t previous = m_time;
+    bool previous_rising = m_last_rising;
+    uint64_t high = 0;
+    uint64_t pending_high = 0;
+    stats.edges = drain(last, Size, [&](uint64_t time, bool rising) {
+      if (!has_start) {
+        has_start = true;
+        start_rising = rising;
+        start = time;
+        end = time;
+      } else {
+        if (previous_rising) {
+          pending_high += time - previous;
+        }
+        if (rising == start_rising) {
+          // 与起始边沿同极性：一个完整周期结束
+          end = time;
+          high += pending_high;
+          pending_high = 0;
+          ++stats.periods;
+        }
+      }
+      previous = time;
+      previous_rising = rising;
+    });
+
+    const float total = static_cast<float>(end - start);
+    if (stats.periods == 0U || m_tick_hz == 0U || total <= 0.0F) {
+      return stats;
+    }
+    // 输入预分频时每次捕获跨越多个信号周期
+    const auto signal_periods =
+        static_cast<float>(stats.periods * m_edges_per_capture);
+    stats.period = total / signal_periods / static_cast<float>(m_tick_hz);
+    stats.frequency = 1.0F / stats.period;
+    if (m_both_edges) {
+      stats.duty = static_cast<float>(high) / total;
+    }
+    return stats;
+  }
+
+  /// 读者落后超过一圈而丢弃的捕获数
+  [[nodiscard]] uint32_t overruns() const noexcept { return m_overruns; }
+
+  /// 时间戳的计数频率（Hz）
+  [[nodiscard]] uint32_t tick_frequency() const noexcept { return m_tick_hz; }
+
+private:
+  // 与 HAL 内部的 DMA_Base_Registers 布局一致（LISR/HISR 与 LIFCR/HIFCR）
+  struct stream_base_registers {
+    __IO uint32_t ISR;
+    __IO uint32_t Reserved0;
+    __IO uint32_t IFCR;
+  };
+
+  static void lap_cb(DMA_HandleTypeDef *hdma) {
+    auto *self = static_cast<capture_stream *>(hdma->Parent);
+    self->m_laps = self->m_laps + 1U;
+  }
+
+  /// DMA 已写入的捕获总数（按 2^32 回绕）
+  [[nodiscard]] uint32_t written() const noexcept {
+    const auto *base = reinterpret_cast<const stream_base_registers *>(
+        static_cast<uintptr_t>(m_hdma->StreamBaseAddress));
+    const uint32_t tc_flag = DMA_FLAG_TCIF0_4 << m_hdma->StreamIndex;
+    uint32_t laps = 0;
+    uint32_t remaining = 0;
+    bool tc_pending = false;
+    do {
+      laps = m_laps;
+      // 先读 TCIF 再读 NDTR：TCIF 已置位时读到的 NDTR 一定在重装之后
+      tc_pending = (base->ISR & tc_flag) != 0U;
+      remaining = m_hdma->Instance->NDTR;
+    } while (laps != m_laps);
+    const uint32_t position = Size - remaining;
+    if (tc_pending && position < Size / 2U) {
+      // 已绕回缓冲区开头但完成中断尚未执行
+      ++laps;
+    }
+    return laps * static_cast<uint32_t>(Size) + position;
+  }
+
+  /**
+   * @brief 读者落后超过一圈时跳过被覆盖的捕获
+   *
+   * @return 当前写入位置
+   */
+  uint32_t resync() noexcept {
+    const uint32_t end = written();
+    if (end - m_read > Size) {
+      // 只保留最新的半圈，留出余量避免读到正在被覆盖的位置；
+      // 丢弃处时间不连续，下一个边沿重新作为起点
+      const uint32_t keep = Size / 2U;
+      m_overruns = m_overruns + (end - m_read - keep);
+      m_read = end - keep;
+      m_has_last = false;
+    }
+    return end;
+  }
+
+  /**
+   * @brief 按顺序处理至多 limit 个截止到 end 的新捕获
+   *
+   * visitor(time, rising)：time 为 64 位时间戳，rising 为该边沿是否为
+   * 上升沿（单边沿捕获时恒为 true）。
+   */
+  template <typename Visitor>
+  std::size_t drain(uint32_t end, std::size_t limit,
+                    Visitor &&visitor) noexcept {
+    std::size_t count = 0;
+    while (m_read != end && count < limit) {
+      const uint32_t raw = m_buffer[m_read & (Size - 1U)];
+      if (m_has_last) {
+        const uint64_t delta = raw >= m_last_raw
+                                   ? raw - m_last_raw
+                                   : raw + m_range - m_last_raw;
+        m_time += delta;
+      } else {
+        m_has_last = true;
+      }
+      m_last_raw = raw;
+      // 第 0 个边沿的极性由 start() 时的引脚电平得出，之后交替
+      m_last_rising =
+          !m_both_edges || (((m_read & 1U) == 0U) == m_first_rising);
+      visitor(m_time, m_last_rising);
+      ++m_read;
+      ++count;
+    }
+    return count;
+  }
+
+  timer *m_timer{nullptr};
+  TIM_HandleTypeDef *m_htim{nullptr};
+  DMA_HandleTypeDef *m_hdma{nullptr};
+  GPIO_TypeDef *m_input_port{nullptr};
+  uint16_t m_input_pin{0};
+  uint32_t m_channel{0};
+  uint32_t m_buffer[Size]{};
+
+  volatile uint32_t m_laps{0};
+  uint32_t m_read{0};
+  uint32_t m_overruns{0};
+
+  uint64_t m_range{0x10000};
+  uint64_t m_time{0};
+  uint32_t m_last_raw{0};
+  uint32_t m_tick_hz{0};
+  uint32_t m_edges_per_capture{1};
+  bool m_has_last{false};
+  bool m_last_rising{true};
+  bool m_first_rising{true};
+  bool m_both_edges{false};
+};
+
+} // namespace gdut
+
+#endif // BSP_CAPTURE_STREAM_HPP
@@ -1,6 +1,8 @@
 #ifndef BSP_CLOCK_HPP
 #define BSP_CLOCK_HPP
 
+#include "stm32f4xx.h"
+
 #include <chrono>
 #include <cmsis_os2.h>
 #include <cstdint>
@@ -67,6 +69,26 @@ struct steady_clock {
 
 using high_resolution_clock = steady_clock;
 
+/**
+ * @brief 基于 DWT CYCCNT 的 CPU 周期计数器，用于微基准测试与执行时间统计
+ *
+ * 168 MHz 下约 25.6 s 回绕一次；两次读数之差使用无符号减法即可正确
+ * 处理单次回绕。使用前须调用一次 enable()（调试器连接时通常已开启）。
+ */
+struct cycle_counter {
+  cycle_counter() = delete;
+
+  static void enable() noexcept {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+
+  static std::uint32_t now() noexcept { return DWT->CYCCNT; }
+
+  static std::uint32_t get_freq() noexcept { return SystemCoreClock; }
+};
+
 static_assert(std::chrono::is_clock_v<system_clock>);
 static_assert(std::chrono::is_clock_v<steady_clock>);
 
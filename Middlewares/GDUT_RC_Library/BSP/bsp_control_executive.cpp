@@ -0,0 +1,154 @@
+#include "bsp_control_executive.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace gdut {
+
+control_executive::control_executive(timer &tim) : m_timer(&tim) {
+  if (tim.get_htim() == nullptr) {
+    m_timer = nullptr;
+    return;
+  }
+  tim.register_period_elapsed_callback([this] { on_tick(); });
+}
+
+control_executive::~control_executive() noexcept {
+  if (m_timer != nullptr) {
+    (void)stop();
+    m_timer->register_period_elapsed_callback({});
+  }
+}
+
+std::size_t control_executive::add_group(uint32_t divider) noexcept {
+  if (divider == 0U || m_group_count >= max_groups) {
+    return npos;
+  }
+  group &g = m_groups[m_group_count];
+  g.divider = divider;
+  // 第一个基准节拍即释放所有组
+  g.countdown = 1U;
+  return m_group_count++;
+}
+
+bool control_executive::add_callback(std::size_t group,
+                                     callback_t callback) noexcept {
+  if (group >= m_group_count || !callback) {
+    return false;
+  }
+  auto &g = m_groups[group];
+  if (g.callback_count >= max_callbacks) {
+    return false;
+  }
+  g.callbacks[g.callback_count++] = std::move(callback);
+  return true;
+}
+
+HAL_StatusTypeDef control_executive::start() {
+  if (!valid()) {
+    return HAL_ERROR;
+  }
+  return HAL_TIM_Base_Start_IT(m_timer->get_htim());
+}
+
+HAL_StatusTypeDef control_executive::stop() {
+  if (!valid()) {
+    return HAL_ERROR;
+  }
+  return HAL_TIM_Base_Stop_IT(m_timer->get_htim());
+}
+
+void control_executive::run(std::size_t group) {
+  if (group >= m_group_count) {
+    return;
+  }
+  auto &g = m_groups[group];
+  g.waiter = osThreadGetId();
+  while (true) {
+    (void)osThreadFlagsWait(release_flag, osFlagsWaitAny, osWaitForever);
+    const uint32_t start = cycle_counter::now();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const uint32_t release = g.release_time;
+    g.pending = false;
+    g.running = true;
+    __set_PRIMASK(primask);
+
+    for (std::size_t i = 0; i < g.callback_count; ++i) {
+      g.callbacks[i]();
+    }
+
+    const uint32_t latency = start - release;
+    const uint32_t exec = cycle_counter::now() - start;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    rate_group_stats &stats = g.stats;
+    stats.exec_max = std::max(stats.exec_max, exec);
+    stats.latency_max = std::max(stats.latency_max, latency);
+    stats.exec_histogram[bin_of(exec)] += 1U;
+    stats.latency_histogram[bin_of(latency)] += 1U;
+    g.running = false;
+    __set_PRIMASK(primask);
+  }
+}
+
+uint32_t control_executive::base_frequency() const noexcept {
+  return valid() ? m_timer->get_frequency() : 0U;
+}
+
+rate_group_stats control_executive::stats(std::size_t group) const noexcept {
+  if (group >= m_group_count) {
+    return {};
+  }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  rate_group_stats copy = m_groups[group].stats;
+  __set_PRIMASK(primask);
+  return copy;
+}
+
+void control_executive::reset_stats(std::size_t group) noexcept {
+  if (group >= m_group_count) {
+    return;
+  }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  m_groups[group].stats = {};
+  __set_PRIMASK(primask);
+}
+
+void control_executive::on_tick() noexcept {
+  const uint32_t now = cycle_counter::now();
+  for (std::size_t i = 0; i < m_group_count; ++i) {
+    auto &g = m_groups[i];
+    // 倒计数代替取模，中断内不做除法
+    if (--g.countdown != 0U) {
+      continue;
+    }
+    g.countdown = g.divider;
+    if (g.waiter == nullptr) {
+      continue; // 任务尚未进入 run()
+    }
+    if (g.pending || g.running) {
+      // 上一轮尚未开始或尚未完成：跳过本次释放，不积压
+      g.stats.overruns += 1U;
+      continue;
+    }
+    g.release_time = now;
+    g.pending = true;
+    g.stats.releases += 1U;
+    (void)osThreadFlagsSet(g.waiter, release_flag);
+  }
+}
+
+std::size_t control_executive::bin_of(uint32_t cycles) noexcept {
+  const uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+  const uint32_t us = cycles_per_us != 0U ? cycles / cycles_per_us : 0U;
+  // 0 µs → 0 格，[2^(k−1), 2^k) µs → 第 k 格
+  const auto bin = static_cast<std::size_t>(std::bit_width(us));
+  return std::min(bin, rate_group_stats::bins - 1U);
+}
+
+} // namespace gdut
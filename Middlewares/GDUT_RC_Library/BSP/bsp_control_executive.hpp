@@ -0,0 +1,162 @@
+#ifndef BSP_CONTROL_EXECUTIVE_HPP
+#define BSP_CONTROL_EXECUTIVE_HPP
+
+#include "bsp_clock.hpp"
+#include "bsp_function.hpp"
+#include "bsp_timer.hpp"
+#include "bsp_uncopyable.hpp"
+#include "cmsis_os2.h"
+#include "stm32f4xx_hal.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gdut {
+
+/**
+ * @brief 一个速率组的运行统计（时间单位为 CPU 周期）
+ *
+ * 直方图按 2 的幂划分微秒区间：第 0 格为不足 1 µs，第 k 格（k ≥ 1）为
+ * [2^(k−1), 2^k) µs，最后一格包含更长的时间。
+ */
+struct rate_group_stats {
+  static constexpr std::size_t bins = 16;
+
+  uint32_t releases;    ///< 释放次数（不含超时跳过的释放）
+  uint32_t overruns;    ///< 释放时上一轮尚未开始或尚未完成（该次跳过）
+  uint32_t exec_max;    ///< 一轮回调的最长执行时间
+  uint32_t latency_max; ///< 定时器中断释放到任务开始执行的最长延迟
+  std::array<uint32_t, bins> exec_histogram;    ///< 执行时间分布
+  std::array<uint32_t, bins> latency_histogram; ///< 释放抖动分布
+
+  /// 第 bin 格的上界（µs，不含）；最后一格返回 0 表示无上界
+  [[nodiscard]] static constexpr uint32_t bin_limit_us(std::size_t bin) {
+    return bin + 1U >= bins ? 0U : 1U << bin;
+  }
+};
+
+/**
+ * @brief 硬件定时器驱动的固定速率控制调度器
+ *
+ * osDelay() 以系统节拍为单位，且从任务被唤醒的时刻开始计时：任务每轮的
+ * 执行时间和被抢占的时间都会累积成周期漂移。control_executive 以定时器
+ * 更新中断为基准节拍，按分频把若干速率组（如 1 kHz / 500 Hz / 100 Hz）
+ * 的任务用线程标志释放，每组在自己的任务中按注册顺序执行回调。
+ *
+ * 特性：
+ * - 释放时刻由硬件定时器决定，不随任务执行时间漂移
+ * - 每个速率组运行在用户创建的任务中（run()），优先级由用户按速率单调
+ *   原则分配：速率越高优先级越高
+ * - 统计每组的执行时间与释放抖动（中断释放到任务开始执行）的直方图、
+ *   最大值，以及超时次数
+ * - 上一轮尚未完成时到来的释放计为超时并跳过，不会积压
+ *
+ * 线程安全：
+ * - add_group()/add_callback() 须在 start() 之前调用
+ * - stats()/reset_stats() 可在任意任务中调用
+ *
+ * 重要约束：
+ * - 使用前调用 cycle_counter::enable()
+ * - 定时器的更新中断频率即基准频率，由 CubeMX 配置（PSC/ARR）
+ * - 更新中断由 timer_irq_handler 自动分发，应用不得再定义
+ *   HAL_TIM_PeriodElapsedCallback
+ * - 每个速率组只能由一个任务调用 run()
+ *
+ * 使用示例：
+ * @code
+ * gdut::timer control_timer(&htim6); // 1 kHz 更新中断
+ * gdut::control_executive executive(control_timer);
+ *
+ * const std::size_t fast = executive.add_group(1);  // 1 kHz
+ * const std::size_t mid = executive.add_group(2);   // 500 Hz
+ * const std::size_t slow = executive.add_group(10); // 100 Hz
+ * executive.add_callback(fast, [] { attitude_loop(); });
+ * executive.add_callback(mid, [] { chassis_loop(); });
+ * executive.add_callback(slow, [] { referee_update(); });
+ *
+ * // 每组一个任务，优先级 fast > mid > slow
+ * void fast_task(void *) { executive.run(fast); }
+ *
+ * executive.start();
+ * @endcode
+ */
+class control_executive : uncopyable {
+public:
+  using callback_t = function<void()>;
+
+  static constexpr std::size_t max_groups = 4;
+  static constexpr std::size_t max_callbacks = 8;
+  /// add_group() 失败时的返回值
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  /**
+   * @brief 绑定基准定时器并接管它的更新回调
+   */
+  explicit control_executive(timer &tim);
+  ~control_executive() noexcept;
+
+  [[nodiscard]] bool valid() const noexcept { return m_timer != nullptr; }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /**
+   * @brief 添加一个速率组
+   *
+   * @param divider  每 divider 个基准节拍释放一次（1 为基准频率）
+   * @return 速率组编号；组数已满或 divider 为 0 时返回 npos
+   */
+  [[nodiscard]] std::size_t add_group(uint32_t divider) noexcept;
+
+  /**
+   * @brief 在速率组末尾追加一个回调，回调按追加顺序执行
+   *
+   * @return 编号无效或回调数已满时返回 false
+   */
+  bool add_callback(std::size_t group, callback_t callback) noexcept;
+
+  /// 启动定时器与更新中断
+  HAL_StatusTypeDef start();
+  HAL_StatusTypeDef stop();
+
+  /**
+   * @brief 速率组的任务主体：等待释放并执行回调，不返回
+   *
+   * 在为该组创建的任务中调用；编号无效时立即返回。
+   */
+  void run(std::size_t group);
+
+  /// 基准频率（Hz），由定时器时钟与 PSC/ARR 得出
+  [[nodiscard]] uint32_t base_frequency() const noexcept;
+
+  [[nodiscard]] rate_group_stats stats(std::size_t group) const noexcept;
+  void reset_stats(std::size_t group) noexcept;
+
+private:
+  // 与 dma_memcpy（0x00800000）、i2c_bus（0x00400000）、spi_bus
+  // （0x00200000）的等待标志错开
+  static constexpr uint32_t release_flag = 0x00100000U;
+
+  struct group {
+    uint32_t divider{0};
+    uint32_t countdown{0};
+    std::size_t callback_count{0};
+    std::array<callback_t, max_callbacks> callbacks{};
+    osThreadId_t waiter{nullptr};
+    uint32_t release_time{0};
+    volatile bool pending{false};
+    volatile bool running{false};
+    rate_group_stats stats{};
+  };
+
+  void on_tick() noexcept;
+  static std::size_t bin_of(uint32_t cycles) noexcept;
+
+  timer *m_timer{nullptr};
+  std::size_t m_group_count{0};
+  std::array<group, max_groups> m_groups{};
+};
+
+} // namespace gdut
+
+#endif // BSP_CONTROL_EXECUTIVE_HPP
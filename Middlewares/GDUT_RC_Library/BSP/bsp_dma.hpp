@@ -3,6 +3,7 @@
 
 #include "stm32f4xx_hal.h"
 #include "stm32f4xx_hal_dma.h"
+#include "stm32f4xx_hal_dma_ex.h"
 #include "stm32f4xx_hal_i2c.h"
 #include "stm32f4xx_hal_uart.h"
 
@@ -12,6 +13,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <span>
 #include <system_error>
 #include <utility>
 
@@ -106,6 +109,24 @@ template <> struct is_error_code_enum<gdut::dma_error_code> : true_type {};
 
 namespace gdut {
 
+/**
+ * @brief 检查 DMA 缓冲区地址（CCMRAM 不能被 DMA 访问）。
+ *
+ * 定义 GDUT_DMA_BUFFER_CHECK_FATAL=1 时（Debug 构建默认开启）非法地址
+ * 直接调用 std::terminate()，在第一次误用处暴露错误；否则返回 false，
+ * 由调用方以错误码或返回值上报。
+ */
+[[nodiscard]] inline bool check_dma_buffer(const void *buffer) noexcept {
+  if (is_dma_capable_address(buffer)) {
+    return true;
+  }
+#if defined(GDUT_DMA_BUFFER_CHECK_FATAL) && GDUT_DMA_BUFFER_CHECK_FATAL
+  std::terminate();
+#else
+  return false;
+#endif
+}
+
 /**
  * @brief HAL DMA 句柄的 RAII 代理封装
  *
@@ -118,6 +139,12 @@ namespace gdut {
  * - 统一错误回调（std::error_code）：传输完成/出错均通过同一回调通知
  * - 所有 set_* 配置方法均含 nullptr 有效性检查，空句柄时为空操作
  * - valid() / operator bool() 可快速检查句柄是否可用
+ * - 支持双缓冲（Multi-Buffer）模式：start_double_buffer() 启动连续流，
+ *   缓冲区回调告知刚写满的缓冲区索引，set_buffer() 可在不停流的情况下
+ *   替换空闲缓冲区
+ * - 预备传输（prepared transfer）快速路径：prepare() 只执行一次
+ *   HAL_DMA_Init，之后 launch() 仅写 NDTR/地址寄存器与 EN 位即可重新启动，
+ *   外设类（dma_uart / dma_spi / dma_i2c）的每次传输均走该路径
  *
  * 线程安全：
  * - 该类**不**提供内部同步。回调函数在中断上下文执行；
@@ -128,6 +155,8 @@ namespace gdut {
  *
  * 重要约束：
  * - DMA 传输所用的数据缓冲区**不能**放在 CCMRAM（CCM RAM 不能被 DMA 访问）。
+ *   start()/start_double_buffer()/set_buffer() 会用 check_dma_buffer()
+ *   检查地址，非法时以 std::errc::bad_address 上报（或在调试配置下终止）。
  *
  * 使用示例：
  * @code
@@ -148,18 +177,24 @@ namespace gdut {
 class dma_proxy : uncopyable {
 public:
   using callback_t = function<void(std::error_code)>;
+  /// 双缓冲回调：第二个参数为刚完成（写满/发完）的缓冲区索引（0 或 1）
+  using buffer_callback_t = function<void(std::error_code, std::size_t)>;
 
   explicit dma_proxy(DMA_HandleTypeDef *handle) : m_handle(handle) {}
 
   dma_proxy(dma_proxy &&other) noexcept
       : m_handle(std::exchange(other.m_handle, nullptr)),
-        m_callback_handler(std::move(other.m_callback_handler)) {}
+        m_callback_handler(std::move(other.m_callback_handler)),
+        m_buffer_callback_handler(std::move(other.m_buffer_callback_handler)),
+        m_prepared(std::exchange(other.m_prepared, false)) {}
 
   dma_proxy &operator=(dma_proxy &&other) noexcept {
     if (this != std::addressof(other)) {
       deinit();
       m_handle = std::exchange(other.m_handle, nullptr);
       m_callback_handler = std::move(other.m_callback_handler);
+      m_buffer_callback_handler = std::move(other.m_buffer_callback_handler);
+      m_prepared = std::exchange(other.m_prepared, false);
     }
     return *this;
   }
@@ -172,11 +207,90 @@ public:
    * 必须在开始任何传输之前调用。若 m_handle 为 nullptr，则为空操作。
    * 单独调用 start() 时，Parent 与回调由 start() 自动绑定；
    * 外设类（dma_uart / dma_spi / dma_i2c）在调用本函数后自行配置回调。
+   * 初始化成功后句柄进入“已准备”状态，后续 start() 走 launch() 快速路径。
    */
   void init() {
     if (m_handle) {
-      HAL_DMA_Init(m_handle);
+      m_prepared = HAL_DMA_Init(m_handle) == HAL_OK;
+    }
+  }
+
+  /**
+   * @brief 确保 DMA 句柄已按当前 Init 配置完成一次 HAL_DMA_Init。
+   *
+   * 已准备时为空操作，否则调用 init()。任何 set_* 配置方法、stop()
+   * 与 start_double_buffer() 都会使准备状态失效，下一次 prepare() 重新初始化。
+   *
+   * @return 句柄处于已准备状态返回 true
+   */
+  bool prepare() {
+    if (m_handle && !m_prepared) {
+      init();
+    }
+    return m_prepared;
+  }
+
+  [[nodiscard]] bool prepared() const noexcept { return m_prepared; }
+
+  /**
+   * @brief 预备传输快速路径：在已准备的数据流上重新启动一次传输。
+   *
+   * 与 HAL_DMA_Start_IT 语义一致（同样的状态检查、标志清除与中断使能，
+   * 完成/错误仍由 HAL_DMA_IRQHandler 分发），但省去了 HAL 的加锁与
+   * DMA_SetConfig 的逐位读改写：只清除本数据流的事件标志，写入 NDTR、
+   * PAR、M0AR，再以一次 CR 写入使能中断与数据流。
+   * 每次传输都调用 HAL_DMA_Init 时，初始化中的 HAL_GetTick、EN 位等待循环
+   * 与 CR/FCR 重建占据了启动开销的大部分，该路径将其移出传输热路径。
+   *
+   * @param src_address  源地址
+   * @param dst_address  目标地址
+   * @param data_length  数据长度（以 DMA 数据宽度为单位，1~65535）
+   * @param memory_increment  为 false 时本次传输关闭存储器地址递增
+   *                          （反复搬运同一个字，如 SPI 哑字节发送）；
+   *                          为 true 时按 Init.MemInc 配置。不修改 Init
+   * @return 未准备或参数非法返回 HAL_ERROR，数据流忙返回 HAL_BUSY
+   */
+  HAL_StatusTypeDef launch(uint32_t src_address, uint32_t dst_address,
+                           uint32_t data_length, bool memory_increment = true) {
+    if (!m_handle || !m_prepared) {
+      return HAL_ERROR;
+    }
+    if (data_length == 0U || data_length > 65535U) {
+      m_handle->ErrorCode = HAL_DMA_ERROR_PARAM;
+      return HAL_ERROR;
+    }
+    DMA_Stream_TypeDef *stream = m_handle->Instance;
+    if (m_handle->State != HAL_DMA_STATE_READY ||
+        (stream->CR & DMA_SxCR_EN) != 0U) {
+      return HAL_BUSY;
+    }
+    m_handle->State = HAL_DMA_STATE_BUSY;
+    m_handle->ErrorCode = HAL_DMA_ERROR_NONE;
+
+    // 清除本数据流的 TC/HT/TE/DME/FE 标志，StreamIndex 由 HAL_DMA_Init 计算
+    reinterpret_cast<stream_base_registers *>(
+        static_cast<uintptr_t>(m_handle->StreamBaseAddress))
+        ->IFCR = 0x3FU << m_handle->StreamIndex;
+
+    stream->NDTR = data_length;
+    if (m_handle->Init.Direction == DMA_MEMORY_TO_PERIPH) {
+      stream->PAR = dst_address;
+      stream->M0AR = src_address;
+    } else {
+      stream->PAR = src_address;
+      stream->M0AR = dst_address;
+    }
+
+    uint32_t cr = stream->CR & ~(DMA_SxCR_DBM | DMA_IT_HT | DMA_SxCR_MINC);
+    cr |= DMA_IT_TC | DMA_IT_TE | DMA_IT_DME | DMA_SxCR_EN;
+    if (memory_increment && m_handle->Init.MemInc == DMA_MINC_ENABLE) {
+      cr |= DMA_SxCR_MINC;
+    }
+    if (m_handle->XferHalfCpltCallback != nullptr) {
+      cr |= DMA_IT_HT;
     }
+    stream->CR = cr;
+    return HAL_OK;
   }
 
   /**
@@ -190,11 +304,14 @@ public:
       HAL_DMA_DeInit(m_handle); // 尽力反初始化，不检查返回值
       m_handle->XferCpltCallback = nullptr;
       m_handle->XferHalfCpltCallback = nullptr;
+      m_handle->XferM1CpltCallback = nullptr;
+      m_handle->XferM1HalfCpltCallback = nullptr;
       m_handle->XferErrorCallback = nullptr;
       m_handle->XferAbortCallback = nullptr;
       m_handle->Parent = nullptr;
       m_handle = nullptr;
     }
+    m_prepared = false;
   }
 
   [[nodiscard]] bool valid() const noexcept { return m_handle != nullptr; }
@@ -220,13 +337,19 @@ public:
       }
       return; // DMA 句柄无效
     }
+    if (!check_dma_buffer(src_address) || !check_dma_buffer(dst_address)) {
+      call_dma_callback(std::make_error_code(std::errc::bad_address));
+      return;
+    }
     // 绑定 Parent 与回调，确保 DMA 中断能够回调到本对象
     m_handle->Parent = this;
     m_handle->XferCpltCallback = xfer_cplt_cb;
     m_handle->XferErrorCallback = xfer_error_cb;
+    const auto src = reinterpret_cast<uint32_t>(src_address);
+    const auto dst = reinterpret_cast<uint32_t>(dst_address);
     const auto status =
-        HAL_DMA_Start_IT(m_handle, reinterpret_cast<uint32_t>(src_address),
-                         reinterpret_cast<uint32_t>(dst_address), data_length);
+        m_prepared ? launch(src, dst, static_cast<uint32_t>(data_length))
+                   : HAL_DMA_Start_IT(m_handle, src, dst, data_length);
     if (status != HAL_OK) {
       if (m_callback_handler) {
         // 启动失败，通过回调上报 HAL DMA 错误码（ErrorCode 含具体故障原因）
@@ -236,6 +359,111 @@ public:
     }
   }
 
+  /**
+   * @brief 以双缓冲（Multi-Buffer）模式启动连续 DMA 传输。
+   *
+   * 基于 HAL_DMAEx_MultiBufferStart_IT：DMA 在 buffer0 与 buffer1 之间
+   * 由硬件自动切换，无需在完成中断中重新启动，因此不存在重启间隙。
+   * 每写满（外设到存储器）或发完（存储器到外设）一个缓冲区，即通过
+   * set_buffer_callback_handler() 注册的回调上报该缓冲区索引，用户可在
+   * DMA 填充另一个缓冲区期间处理它。
+   *
+   * 缓冲区方向由 Init.Direction 决定：外设到存储器时 DMA 从
+   * peripheral_address 读入缓冲区；存储器到外设时 DMA 从缓冲区写出到
+   * peripheral_address。双缓冲模式隐含循环模式，不支持存储器到存储器。
+   * 启动失败时通过缓冲区回调（未注册时退回普通回调）上报错误。
+   *
+   * @param peripheral_address  外设数据寄存器地址
+   * @param buffer0             缓冲区 0（对应 M0AR）
+   * @param buffer1             缓冲区 1（对应 M1AR）
+   * @param data_length         每个缓冲区的数据长度（以 DMA 数据宽度为单位）
+   */
+  void start_double_buffer(void *peripheral_address, void *buffer0,
+                           void *buffer1, std::size_t data_length) {
+    if (!m_handle || !peripheral_address || !buffer0 || !buffer1 ||
+        data_length == 0U || data_length > 65535U) {
+      call_buffer_callback(std::make_error_code(std::errc::invalid_argument),
+                           0);
+      return;
+    }
+    if (!check_dma_buffer(buffer0) || !check_dma_buffer(buffer1)) {
+      call_buffer_callback(std::make_error_code(std::errc::bad_address), 0);
+      return;
+    }
+    // 双缓冲会改写 CR（DBM/CIRC），结束后须重新 HAL_DMA_Init
+    m_prepared = false;
+    m_handle->Parent = this;
+    m_handle->XferCpltCallback = m0_cplt_cb;
+    m_handle->XferM1CpltCallback = m1_cplt_cb;
+    m_handle->XferErrorCallback = double_buffer_error_cb;
+    // 不关心半传输事件，置空以免 HAL 使能 HT 中断
+    m_handle->XferHalfCpltCallback = nullptr;
+    m_handle->XferM1HalfCpltCallback = nullptr;
+
+    const auto periph = reinterpret_cast<uint32_t>(peripheral_address);
+    const auto mem0 = reinterpret_cast<uint32_t>(buffer0);
+    const auto mem1 = reinterpret_cast<uint32_t>(buffer1);
+    // HAL 的 SrcAddress/DstAddress 随方向交换含义，第二存储器地址始终为 M1AR
+    const bool to_peripheral =
+        m_handle->Init.Direction == DMA_MEMORY_TO_PERIPH;
+    const auto status = HAL_DMAEx_MultiBufferStart_IT(
+        m_handle, to_peripheral ? mem0 : periph, to_peripheral ? periph : mem0,
+        mem1, static_cast<uint32_t>(data_length));
+    if (status != HAL_OK) {
+      call_buffer_callback(
+          make_error_code(static_cast<dma_error_code>(m_handle->ErrorCode)),
+          0);
+    }
+  }
+
+  /**
+   * @brief 在不停止双缓冲流的情况下替换一个缓冲区的地址。
+   *
+   * 只能替换当前**未被** DMA 使用的缓冲区：硬件规定在流使能期间写入
+   * 正在使用的存储器地址寄存器会触发传输错误并停止流，因此若 @p index
+   * 正是当前目标缓冲区，本函数拒绝写入并返回 false。
+   *
+   * 推荐在缓冲区回调中替换刚完成的那个缓冲区（此时 DMA 正在使用另一个，
+   * 离下一次切换尚有一整个缓冲区的时间）。
+   *
+   * @param index   缓冲区索引（0 或 1）
+   * @param buffer  新缓冲区地址，长度须与 start_double_buffer() 一致
+   * @return 替换成功返回 true
+   */
+  bool set_buffer(std::size_t index, void *buffer) {
+    if (!m_handle || !buffer || index > 1U || index == current_buffer() ||
+        !check_dma_buffer(buffer)) {
+      return false;
+    }
+    return HAL_DMAEx_ChangeMemory(m_handle, reinterpret_cast<uint32_t>(buffer),
+                                  index == 0U ? MEMORY0 : MEMORY1) == HAL_OK;
+  }
+
+  /// 返回 DMA 当前正在使用的缓冲区索引（DMA_SxCR.CT），句柄无效时返回 0
+  [[nodiscard]] std::size_t current_buffer() const noexcept {
+    if (!m_handle) {
+      return 0;
+    }
+    return (m_handle->Instance->CR & DMA_SxCR_CT) != 0U ? 1U : 0U;
+  }
+
+  /**
+   * @brief 中止正在进行的传输（含双缓冲连续流）。
+   *
+   * 调用 HAL_DMA_Abort 关闭数据流；失败时通过回调上报 HAL DMA 错误码。
+   * 中止后准备状态失效，下一次 prepare()/init() 重新写入 CR。
+   */
+  void stop() {
+    if (!m_handle) {
+      return;
+    }
+    m_prepared = false;
+    if (HAL_DMA_Abort(m_handle) != HAL_OK) {
+      call_dma_callback(
+          make_error_code(static_cast<dma_error_code>(m_handle->ErrorCode)));
+    }
+  }
+
   [[nodiscard]] DMA_HandleTypeDef *get_handle() const { return m_handle; }
 
   void set_callback_handler(const function<void(std::error_code)> &handler) {
@@ -246,10 +474,19 @@ public:
     m_callback_handler = std::move(handler);
   }
 
+  void set_buffer_callback_handler(const buffer_callback_t &handler) {
+    m_buffer_callback_handler = handler;
+  }
+
+  void set_buffer_callback_handler(buffer_callback_t &&handler) {
+    m_buffer_callback_handler = std::move(handler);
+  }
+
   void set_instance(dma_stream_type instance) {
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Instance = get_dma_stream(instance);
   }
 
@@ -257,6 +494,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.Channel = std::to_underlying(channel);
   }
 
@@ -264,6 +502,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.Direction = std::to_underlying(direction);
   }
 
@@ -271,6 +510,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.PeriphInc = enable ? DMA_PINC_ENABLE : DMA_PINC_DISABLE;
   }
 
@@ -278,6 +518,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.MemInc = enable ? DMA_MINC_ENABLE : DMA_MINC_DISABLE;
   }
 
@@ -285,6 +526,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.PeriphDataAlignment = std::to_underlying(alignment);
   }
 
@@ -292,6 +534,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.MemDataAlignment = std::to_underlying(alignment);
   }
 
@@ -299,6 +542,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.Mode = std::to_underlying(mode);
   }
 
@@ -306,6 +550,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.Priority = std::to_underlying(priority);
   }
 
@@ -313,6 +558,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.FIFOMode = std::to_underlying(mode);
   }
 
@@ -320,6 +566,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.FIFOThreshold = std::to_underlying(threshold);
   }
 
@@ -327,6 +574,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.MemBurst = std::to_underlying(burst);
   }
 
@@ -334,6 +582,7 @@ public:
     if (!m_handle) {
       return;
     }
+    m_prepared = false;
     m_handle->Init.PeriphBurst = std::to_underlying(burst);
   }
 
@@ -343,7 +592,23 @@ public:
     }
   }
 
+  // 双缓冲事件优先交给缓冲区回调，未注册时退回普通回调
+  void call_buffer_callback(std::error_code ec, std::size_t index) {
+    if (m_buffer_callback_handler) {
+      m_buffer_callback_handler(ec, index);
+    } else {
+      call_dma_callback(ec);
+    }
+  }
+
 private:
+  // 与 HAL 内部的 DMA_Base_Registers 布局一致（LISR/HISR 与 LIFCR/HIFCR）
+  struct stream_base_registers {
+    __IO uint32_t ISR;
+    __IO uint32_t Reserved0;
+    __IO uint32_t IFCR;
+  };
+
   static void xfer_cplt_cb(DMA_HandleTypeDef *hdma) {
     if (!hdma || !hdma->Parent)
       return;
@@ -361,9 +626,33 @@ private:
           std::error_code(hdma->ErrorCode, dma_error_category::instance()));
   }
 
+  // 双缓冲模式下 HAL 在 M0 写满（CT 已切到 1）时调用 XferCpltCallback
+  static void m0_cplt_cb(DMA_HandleTypeDef *hdma) {
+    if (!hdma || !hdma->Parent)
+      return;
+    static_cast<dma_proxy *>(hdma->Parent)->call_buffer_callback({}, 0);
+  }
+
+  static void m1_cplt_cb(DMA_HandleTypeDef *hdma) {
+    if (!hdma || !hdma->Parent)
+      return;
+    static_cast<dma_proxy *>(hdma->Parent)->call_buffer_callback({}, 1);
+  }
+
+  static void double_buffer_error_cb(DMA_HandleTypeDef *hdma) {
+    if (!hdma || !hdma->Parent)
+      return;
+    auto *self = static_cast<dma_proxy *>(hdma->Parent);
+    self->call_buffer_callback(
+        std::error_code(hdma->ErrorCode, dma_error_category::instance()),
+        self->current_buffer());
+  }
+
   DMA_HandleTypeDef *m_handle{nullptr};
   callback_t
       m_callback_handler{}; // 显式初始化为空，防止未初始化的函数对象被调用
+  buffer_callback_t m_buffer_callback_handler{};
+  bool m_prepared{false}; // 已按当前 Init 配置完成 HAL_DMA_Init
 };
 
 /**
@@ -378,6 +667,9 @@ private:
  * - do_bind_rx(dma_proxy*)
  * - do_transmit(const uint8_t*, std::size_t, uint16_t)
  * - do_receive(uint8_t*, std::size_t, uint16_t)
+ * - do_transmit_receive(std::span<const uint8_t>, std::span<uint8_t>)
+ *   （可选，仅支持全双工的外设实现；未实现时调用 transmit_receive()
+ *   编译失败）
  *
  * @tparam Derived  派生类类型（如 dma_uart、dma_i2c、dma_spi）
  *
@@ -409,8 +701,12 @@ public:
    *                 内部使用 const_cast 适配，HAL 不会修改数据内容）
    * @param size     数据长度（字节数）
    * @param address  仅 I2C 有效：7 位从机地址（UART/SPI 忽略）
+   * @return 启动成功返回 true；缓冲区位于 CCMRAM 时返回 false
    */
   bool transmit(const uint8_t *data, std::size_t size, uint16_t address = 0) {
+    if (!check_dma_buffer(data)) {
+      return false;
+    }
     return static_cast<Derived *>(this)->do_transmit(data, size, address);
   }
 
@@ -419,11 +715,32 @@ public:
    * @param buffer   接收缓冲区
    * @param size     数据长度（字节数）
    * @param address  仅 I2C 有效：7 位从机地址（UART/SPI 忽略）
+   * @return 启动成功返回 true；缓冲区位于 CCMRAM 时返回 false
    */
   bool receive(uint8_t *buffer, std::size_t size, uint16_t address = 0) {
+    if (!check_dma_buffer(buffer)) {
+      return false;
+    }
     return static_cast<Derived *>(this)->do_receive(buffer, size, address);
   }
 
+  /**
+   * @brief 发起全双工 DMA 收发：发送 tx 的同时接收到 rx。
+   *
+   * 发送与接收使用各自独立的缓冲区，调用方无需预先把命令写进接收缓冲区。
+   *
+   * @param tx  发送数据；为空时按外设的哑字节模式发送（见 dma_spi）
+   * @param rx  接收缓冲区，tx 非空时长度必须与 tx 相同
+   * @return 启动成功返回 true；缓冲区位于 CCMRAM 时返回 false
+   */
+  bool transmit_receive(std::span<const uint8_t> tx, std::span<uint8_t> rx) {
+    if ((!tx.empty() && !check_dma_buffer(tx.data())) ||
+        !check_dma_buffer(rx.data())) {
+      return false;
+    }
+    return static_cast<Derived *>(this)->do_transmit_receive(tx, rx);
+  }
+
   /// 同时绑定 TX 和 RX 两个 DMA 代理
   void bind(dma_proxy *tx_dma, dma_proxy *rx_dma) {
     bind_tx(tx_dma);
@@ -444,6 +761,8 @@ public:
  * 并通过 HAL_I2C_Master_Transmit_DMA / HAL_I2C_Master_Receive_DMA 发起传输。
  *
  * @note address 为 7 位从机地址（有效范围 0x08~0x77），传 0 在 I2C 总线上无效。
+ * @note 总线忙（BUSY 置位）时 transmit/receive 立即返回 false，不等待；
+ *       多个设备共享总线、需要排队或超时恢复时请使用 i2c_bus。
  */
 class dma_i2c : public dma_transfer_base<dma_i2c> {
 public:
@@ -500,7 +819,10 @@ private:
       return false;
     }
 
-    m_tx_dma->init(); // 确保 DMA 代理已初始化并关联到 HAL 句柄
+    // 确保 DMA 代理已初始化（仅首次或配置变更后调用 HAL_DMA_Init）
+    if (!m_tx_dma->prepare()) {
+      return false;
+    }
 
     // 覆盖 DMA 句柄的 Parent 与完成/错误回调，以便在 DMA 中断里转发用户回调
     DMA_HandleTypeDef *hdma_tx = m_tx_dma->get_handle();
@@ -517,21 +839,13 @@ private:
       return false;
     }
 
-    __IO uint32_t count = 0U;
     HAL_StatusTypeDef dmaxferstatus;
-    /* Wait until BUSY flag is reset */
-    count = 25U * (SystemCoreClock / 25U / 1000U);
-    do {
-      count--;
-      if (count == 0U) {
-        m_i2c->PreviousState = HAL_I2C_MODE_NONE;
-        m_i2c->State = HAL_I2C_STATE_READY;
-        m_i2c->Mode = HAL_I2C_MODE_NONE;
-        m_i2c->ErrorCode |= HAL_I2C_ERROR_TIMEOUT;
-
-        return false;
-      }
-    } while (__HAL_I2C_GET_FLAG(m_i2c, I2C_FLAG_BUSY) != RESET);
+    /* 总线忙时立即失败，不在调用者上下文中忙等；需要排队与超时恢复时
+     * 使用 i2c_bus（bsp_i2c_bus.hpp） */
+    if (__HAL_I2C_GET_FLAG(m_i2c, I2C_FLAG_BUSY) != RESET) {
+      m_i2c->ErrorCode |= HAL_I2C_ERROR_TIMEOUT;
+      return false;
+    }
 
     /* Process Locked */
     __HAL_LOCK(m_i2c);
@@ -557,9 +871,9 @@ private:
     m_i2c->Devaddress = address;
     if (m_i2c->XferSize > 0U) {
       if (m_i2c->hdmatx != nullptr) {
-        /* Enable the DMA stream */
-        dmaxferstatus = HAL_DMA_Start_IT(
-            m_i2c->hdmatx, reinterpret_cast<uint32_t>(m_i2c->pBuffPtr),
+        /* Enable the DMA stream（预备传输快速路径） */
+        dmaxferstatus = m_tx_dma->launch(
+            reinterpret_cast<uint32_t>(m_i2c->pBuffPtr),
             reinterpret_cast<uint32_t>(&m_i2c->Instance->DR), m_i2c->XferSize);
       } else {
         /* Update I2C state */
@@ -635,7 +949,9 @@ private:
       return false;
     }
 
-    m_rx_dma->init();
+    if (!m_rx_dma->prepare()) {
+      return false;
+    }
 
     // 覆盖 DMA 句柄的 Parent 与完成/错误回调，以便在 DMA 中断里转发用户回调
     DMA_HandleTypeDef *hdma_rx = m_rx_dma->get_handle();
@@ -652,21 +968,13 @@ private:
       return false;
     }
 
-    __IO uint32_t count = 0U;
     HAL_StatusTypeDef dmaxferstatus;
-    /* Wait until BUSY flag is reset */
-    count = 25U * (SystemCoreClock / 25U / 1000U);
-    do {
-      count--;
-      if (count == 0U) {
-        m_i2c->PreviousState = HAL_I2C_MODE_NONE;
-        m_i2c->State = HAL_I2C_STATE_READY;
-        m_i2c->Mode = HAL_I2C_MODE_NONE;
-        m_i2c->ErrorCode |= HAL_I2C_ERROR_TIMEOUT;
-
-        return false;
-      }
-    } while (__HAL_I2C_GET_FLAG(m_i2c, I2C_FLAG_BUSY) != RESET);
+    /* 总线忙时立即失败，不在调用者上下文中忙等；需要排队与超时恢复时
+     * 使用 i2c_bus（bsp_i2c_bus.hpp） */
+    if (__HAL_I2C_GET_FLAG(m_i2c, I2C_FLAG_BUSY) != RESET) {
+      m_i2c->ErrorCode |= HAL_I2C_ERROR_TIMEOUT;
+      return false;
+    }
 
     /* Process Locked */
     __HAL_LOCK(m_i2c);
@@ -692,9 +1000,9 @@ private:
     m_i2c->Devaddress = address;
     if (m_i2c->XferSize > 0U) {
       if (m_i2c->hdmarx != nullptr) {
-        /* Enable the DMA stream */
-        dmaxferstatus = HAL_DMA_Start_IT(
-            m_i2c->hdmarx, reinterpret_cast<uint32_t>(&m_i2c->Instance->DR),
+        /* Enable the DMA stream（预备传输快速路径） */
+        dmaxferstatus = m_rx_dma->launch(
+            reinterpret_cast<uint32_t>(&m_i2c->Instance->DR),
             reinterpret_cast<uint32_t>(m_i2c->pBuffPtr), m_i2c->XferSize);
       } else {
         /* Update I2C state */
@@ -0,0 +1,447 @@
+#ifndef BSP_DMA_MEMCPY_HPP
+#define BSP_DMA_MEMCPY_HPP
+
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_hal_dma.h"
+
+#include "bsp_dma.hpp"
+#include "bsp_function.hpp"
+#include "bsp_uncopyable.hpp"
+
+#include <cmsis_os2.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+namespace gdut {
+
+/**
+ * @brief 基于 DMA2 存储器到存储器数据流的异步拷贝/填充引擎
+ *
+ * 占用一个预留的 DMA2 数据流（STM32F4 上只有 DMA2 支持存储器到存储器），
+ * 把大块 memcpy/memset 从 CPU 卸载到 DMA，让控制循环不被数 KB 的拷贝阻塞。
+ *
+ * 特性：
+ * - 异步接口 copy_async()/fill_async()：完成时在 DMA 中断中调用回调
+ * - 阻塞接口 copy()/fill()：调用任务通过线程标志等待完成，不占用 CPU
+ * - 固定深度请求队列（QueueDepth），多个请求按提交顺序依次执行
+ * - 超过 65535 个数据单元的请求自动拆分为多段
+ * - 根据源/目的地址对齐选择字/半字/字节宽度；16 字节对齐的字拷贝
+ *   使用 4 拍突发（INC4）；不足一个单元或一个突发的尾部在最后一段 DMA
+ *   完成后、回调之前由 CPU 补齐
+ * - 小于 cpu_threshold 字节的请求由 CPU 完成（DMA 启动开销更大）：
+ *   队列为空时在调用者上下文同步完成，否则排队，轮到时在 DMA 中断中完成
+ * - 长度为 0 的请求不访问 DMA，与 CPU 请求一样按提交顺序成功完成
+ * - 所有请求（含 CPU 完成的请求）按提交顺序读写内存并按提交顺序回调，
+ *   相互依赖的拷贝序列（A→B 由 DMA、B→C 由 CPU）不会读到旧数据
+ *
+ * 线程安全：
+ * - copy_async()/fill_async() 可在任务或中断中调用，内部使用关中断临界区
+ *   保护队列；copy()/fill() 只能在任务中调用。
+ * - 回调在 DMA 中断上下文执行（队列为空时提交的 CPU 请求除外：在调用者
+ *   上下文同步执行），禁止在回调中调用阻塞操作。
+ *
+ * 重要约束：
+ * - DMA 无法访问 CCMRAM：任一端位于 CCMRAM 的请求自动退化为 CPU 拷贝。
+ * - 请求完成前，调用方须保证源/目的缓冲区有效。
+ * - 对应 DMA 数据流中断须调用 HAL_DMA_IRQHandler(handle)（CubeMX 默认生成）。
+ *
+ * 使用示例：
+ * @code
+ * extern DMA_HandleTypeDef hdma_memtomem_dma2_stream0;
+ *
+ * gdut::dma_memcpy<> dma_copy(&hdma_memtomem_dma2_stream0);
+ *
+ * // 异步：回调在 DMA 中断中执行
+ * dma_copy.copy_async(led_frame, led_staging, sizeof(led_frame),
+ *                     [](std::error_code ec) { frame_ready = !ec; });
+ *
+ * // 阻塞：当前任务让出 CPU 直到拷贝完成
+ * std::error_code ec = dma_copy.copy(log_block, telemetry, 4096);
+ * @endcode
+ *
+ * @tparam QueueDepth  请求队列深度（含正在执行的请求）
+ */
+template <std::size_t QueueDepth = 8> class dma_memcpy : uncopyable {
+  static_assert(QueueDepth > 0, "Queue depth must be greater than zero.");
+
+public:
+  using callback_t = function<void(std::error_code)>;
+
+  /// 小于该字节数的请求默认由 CPU 完成。
+  /// 该值为未经实测的占位值，交叉点须在目标板上用
+  /// docs/BSP/bsp_dma_memcpy.md 中的基准测得后以 set_cpu_threshold() 设置
+  static constexpr std::size_t default_cpu_threshold = 128;
+  /// NDTR 为 16 位寄存器，单段最多 65535 个数据单元
+  static constexpr std::size_t max_units_per_chunk = 65535U;
+  /// 阻塞接口等待时使用的线程标志位
+  static constexpr uint32_t wait_flag = 0x00800000U;
+
+  explicit dma_memcpy(DMA_HandleTypeDef *handle,
+                      std::size_t cpu_threshold = default_cpu_threshold)
+      : m_handle(handle), m_cpu_threshold(cpu_threshold) {
+    // 只有 DMA2 的数据流支持存储器到存储器传输
+    if (m_handle == nullptr || m_handle->Instance == nullptr ||
+        reinterpret_cast<uintptr_t>(m_handle->Instance) < DMA2_Stream0_BASE) {
+      m_handle = nullptr;
+      return;
+    }
+    m_handle->Parent = this;
+    m_handle->XferCpltCallback = xfer_cplt_cb;
+    m_handle->XferErrorCallback = xfer_error_cb;
+    m_handle->XferHalfCpltCallback = nullptr;
+    m_handle->XferAbortCallback = nullptr;
+  }
+
+  ~dma_memcpy() noexcept {
+    if (m_handle) {
+      (void)HAL_DMA_Abort(m_handle);
+      m_handle->XferCpltCallback = nullptr;
+      m_handle->XferErrorCallback = nullptr;
+      m_handle->Parent = nullptr;
+      m_handle = nullptr;
+    }
+  }
+
+  [[nodiscard]] bool valid() const noexcept { return m_handle != nullptr; }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /**
+   * @brief 提交一次异步拷贝。
+   * @return 请求被接受（已完成或已入队）返回 true；参数非法或队列已满返回
+   *         false，此时回调不会被调用。bytes 为 0 时立即以成功调用回调
+   */
+  bool copy_async(void *dst, const void *src, std::size_t bytes,
+                  callback_t callback = nullptr) {
+    if (dst == nullptr || src == nullptr) {
+      return false;
+    }
+    return submit(static_cast<uint8_t *>(dst),
+                  static_cast<const uint8_t *>(src), bytes, false, 0,
+                  std::move(callback));
+  }
+
+  /**
+   * @brief 提交一次异步填充（memset 语义）。
+   * @return 同 copy_async()
+   */
+  bool fill_async(void *dst, uint8_t value, std::size_t bytes,
+                  callback_t callback = nullptr) {
+    if (dst == nullptr) {
+      return false;
+    }
+    return submit(static_cast<uint8_t *>(dst), nullptr, bytes, true, value,
+                  std::move(callback));
+  }
+
+  /**
+   * @brief 阻塞拷贝：提交请求后在线程标志上等待完成。
+   *
+   * 不提供超时：请求一旦进入队列就会引用调用者栈上的状态，提前返回会
+   * 留下悬空引用。存储器到存储器传输不依赖外设，总会以完成或传输错误结束。
+   *
+   * @return 成功返回空 error_code；队列已满返回 resource_unavailable_try_again
+   */
+  std::error_code copy(void *dst, const void *src, std::size_t bytes) {
+    if (dst == nullptr || src == nullptr) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    return submit_and_wait(static_cast<uint8_t *>(dst),
+                           static_cast<const uint8_t *>(src), bytes, false, 0);
+  }
+
+  /// 阻塞填充，语义同 copy()
+  std::error_code fill(void *dst, uint8_t value, std::size_t bytes) {
+    if (dst == nullptr) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    return submit_and_wait(static_cast<uint8_t *>(dst), nullptr, bytes, true,
+                           value);
+  }
+
+  /// 队列中尚未完成的请求数（含正在执行的请求）
+  [[nodiscard]] std::size_t pending() const noexcept { return m_count; }
+
+  [[nodiscard]] bool busy() const noexcept { return m_count != 0U; }
+
+  void set_cpu_threshold(std::size_t bytes) noexcept {
+    m_cpu_threshold = bytes;
+  }
+
+  [[nodiscard]] std::size_t get_cpu_threshold() const noexcept {
+    return m_cpu_threshold;
+  }
+
+  [[nodiscard]] DMA_HandleTypeDef *get_handle() const { return m_handle; }
+
+private:
+  struct request {
+    uint8_t *dst{nullptr};
+    const uint8_t *src{nullptr};
+    std::size_t units{0};  // 剩余待 DMA 传输的数据单元数
+    std::size_t tail{0};   // DMA 全部完成后由 CPU 处理的字节数
+    uint32_t fill_word{0}; // 填充模式下的源数据（DMA 源地址指向此处）
+    uint8_t width{1};      // 数据宽度（字节）：1/2/4
+    bool fill{false};
+    bool burst{false};
+    callback_t callback{};
+  };
+
+  // DMA 配置缓存：宽度、突发、填充模式不变时跳过 HAL_DMA_Init
+  struct dma_config {
+    uint8_t width{0};
+    bool burst{false};
+    bool fill{false};
+
+    bool operator==(const dma_config &) const = default;
+  };
+
+  bool submit(uint8_t *dst, const uint8_t *src, std::size_t bytes, bool fill,
+              uint8_t value, callback_t &&callback) {
+    // 长度为 0、小请求、DMA 不可用或任一端位于 CCMRAM 时由 CPU 完成
+    const bool cpu = bytes == 0U || bytes < m_cpu_threshold ||
+                     m_handle == nullptr || !is_dma_capable_address(dst) ||
+                     (!fill && !is_dma_capable_address(src));
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (cpu && !m_active) {
+      // 前面没有未完成的请求：立即同步完成。期间持有 m_active，
+      // 同时提交（包括在回调中提交）的请求排在其后
+      m_active = true;
+      __set_PRIMASK(primask);
+      cpu_copy(dst, src, bytes, fill, value);
+      if (callback) {
+        callback(std::error_code{});
+      }
+      start_front();
+      return true;
+    }
+    if (m_count >= QueueDepth) {
+      __set_PRIMASK(primask);
+      return false;
+    }
+    request &req = m_queue[(m_head + m_count) % QueueDepth];
+    prepare(req, dst, src, bytes, fill, value, cpu);
+    req.callback = std::move(callback);
+    m_count = m_count + 1U;
+    // 空闲时由提交者接管启动；HAL_DMA_Init 不需要在关中断期间执行
+    const bool owner = !m_active;
+    m_active = true;
+    __set_PRIMASK(primask);
+    if (owner) {
+      start_front();
+    }
+    return true;
+  }
+
+  std::error_code submit_and_wait(uint8_t *dst, const uint8_t *src,
+                                  std::size_t bytes, bool fill,
+                                  uint8_t value) {
+    // 只捕获一个指针，保证 lambda 能放进 callback_t 的内联存储
+    struct wait_state {
+      std::error_code result{};
+      osThreadId_t waiter{nullptr};
+    } state{{}, osThreadGetId()};
+    (void)osThreadFlagsClear(wait_flag);
+    const bool accepted =
+        submit(dst, src, bytes, fill, value, [&state](std::error_code ec) {
+          state.result = ec;
+          (void)osThreadFlagsSet(state.waiter, wait_flag);
+        });
+    if (!accepted) {
+      return std::make_error_code(std::errc::resource_unavailable_try_again);
+    }
+    (void)osThreadFlagsWait(wait_flag, osFlagsWaitAny, osWaitForever);
+    return state.result;
+  }
+
+  static void cpu_copy(uint8_t *dst, const uint8_t *src, std::size_t bytes,
+                       bool fill, uint8_t value) {
+    if (bytes == 0U) {
+      return;
+    }
+    if (fill) {
+      std::memset(dst, value, bytes);
+    } else {
+      std::memcpy(dst, src, bytes);
+    }
+  }
+
+  // 选择数据宽度与突发模式，并记录 DMA 无法覆盖、留给 CPU 的尾部字节。
+  // 尾部在轮到该请求且 DMA 部分完成后才处理，保持与前面请求的先后顺序
+  static void prepare(request &req, uint8_t *dst, const uint8_t *src,
+                      std::size_t bytes, bool fill, uint8_t value, bool cpu) {
+    req.dst = dst;
+    req.src = src;
+    req.fill = fill;
+    req.fill_word = static_cast<uint32_t>(value) * 0x01010101U;
+    if (cpu) {
+      req.units = 0;
+      req.tail = bytes;
+      req.width = 1;
+      req.burst = false;
+      return;
+    }
+    const uintptr_t dst_addr = reinterpret_cast<uintptr_t>(dst);
+    // 填充模式的源是请求内部的 fill_word（天然字对齐），只看目的地址
+    const uintptr_t align =
+        fill ? dst_addr : (dst_addr | reinterpret_cast<uintptr_t>(src));
+    uint8_t width = 1;
+    if ((align & 0x3U) == 0U && bytes >= 4U) {
+      width = 4;
+    } else if ((align & 0x1U) == 0U && bytes >= 2U) {
+      width = 2;
+    }
+    std::size_t units = bytes / width;
+    // 4 拍字突发要求 16 字节对齐，且单元数为 4 的倍数时突发不会跨越 1 KB 边界
+    const bool burst = (width == 4U) && (align & 0xFU) == 0U && units >= 4U;
+    if (burst) {
+      units &= ~static_cast<std::size_t>(0x3U);
+    }
+    req.units = units;
+    req.tail = bytes - units * width;
+    req.width = width;
+    req.burst = burst;
+  }
+
+  void apply_config(const request &req) {
+    const dma_config config{req.width, req.burst, req.fill};
+    if (config == m_config) {
+      return;
+    }
+    DMA_InitTypeDef &init = m_handle->Init;
+    init.Direction = DMA_MEMORY_TO_MEMORY;
+    init.PeriphInc = req.fill ? DMA_PINC_DISABLE : DMA_PINC_ENABLE;
+    init.MemInc = DMA_MINC_ENABLE;
+    switch (req.width) {
+    case 4:
+      init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+      init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+      break;
+    case 2:
+      init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+      init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+      break;
+    default:
+      init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+      init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+      break;
+    }
+    init.Mode = DMA_NORMAL;
+    // 存储器到存储器不允许直接模式，必须使能 FIFO
+    init.FIFOMode = DMA_FIFOMODE_ENABLE;
+    init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+    init.MemBurst = req.burst ? DMA_MBURST_INC4 : DMA_MBURST_SINGLE;
+    // 填充模式源地址不递增，源端保持单次传输
+    init.PeriphBurst =
+        (req.burst && !req.fill) ? DMA_PBURST_INC4 : DMA_PBURST_SINGLE;
+    if (HAL_DMA_Init(m_handle) == HAL_OK) {
+      m_config = config;
+    } else {
+      m_config = dma_config{};
+    }
+  }
+
+  // 启动队首请求的下一段。只由持有 m_active 的一方调用：空闲时接管的
+  // 提交者，或数据流运行中的 DMA 中断；队列为空时在临界区内交还 m_active
+  void start_front() {
+    while (true) {
+      uint32_t primask = __get_PRIMASK();
+      __disable_irq();
+      if (m_count == 0U) {
+        m_active = false;
+        __set_PRIMASK(primask);
+        return;
+      }
+      __set_PRIMASK(primask);
+      request &req = m_queue[m_head];
+      if (req.units == 0U) {
+        // DMA 部分已完成（或整个请求由 CPU 完成）：dst/src 已推进到尾部，
+        // 先补齐尾部再回调
+        cpu_copy(req.dst, req.src, req.tail, req.fill,
+                 static_cast<uint8_t>(req.fill_word));
+        complete_front({});
+        continue;
+      }
+      apply_config(req);
+      const std::size_t max_units =
+          req.burst ? (max_units_per_chunk & ~static_cast<std::size_t>(0x3U))
+                    : max_units_per_chunk;
+      const std::size_t chunk = req.units < max_units ? req.units : max_units;
+      const auto src = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(
+          req.fill ? static_cast<const void *>(&req.fill_word) : req.src));
+      const auto dst =
+          static_cast<uint32_t>(reinterpret_cast<uintptr_t>(req.dst));
+      m_chunk_units = chunk;
+      if (HAL_DMA_Start_IT(m_handle, src, dst, static_cast<uint32_t>(chunk)) ==
+          HAL_OK) {
+        return;
+      }
+      complete_front(
+          make_error_code(static_cast<dma_error_code>(m_handle->ErrorCode)));
+    }
+  }
+
+  // 弹出队首请求并通知调用方；回调可能再次提交请求，因此先出队再回调
+  void complete_front(std::error_code ec) {
+    callback_t callback = std::move(m_queue[m_head].callback);
+    m_queue[m_head].callback = nullptr;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    m_head = (m_head + 1U) % QueueDepth;
+    m_count = m_count - 1U;
+    __set_PRIMASK(primask);
+    if (callback) {
+      callback(ec);
+    }
+  }
+
+  void on_chunk_done() {
+    request &req = m_queue[m_head];
+    const std::size_t chunk_bytes = m_chunk_units * req.width;
+    req.units -= m_chunk_units;
+    req.dst += chunk_bytes;
+    if (!req.fill) {
+      req.src += chunk_bytes;
+    }
+    // 最后一段完成时由 start_front() 补齐尾部并回调
+    start_front();
+  }
+
+  static void xfer_cplt_cb(DMA_HandleTypeDef *hdma) {
+    if (!hdma || !hdma->Parent)
+      return;
+    static_cast<dma_memcpy *>(hdma->Parent)->on_chunk_done();
+  }
+
+  static void xfer_error_cb(DMA_HandleTypeDef *hdma) {
+    if (!hdma || !hdma->Parent)
+      return;
+    auto *self = static_cast<dma_memcpy *>(hdma->Parent);
+    if (self->m_count == 0U)
+      return;
+    // 出错后 HAL 已关闭数据流，强制下一次启动重新初始化
+    self->m_config = dma_config{};
+    self->complete_front(
+        std::error_code(hdma->ErrorCode, dma_error_category::instance()));
+    self->start_front();
+  }
+
+  DMA_HandleTypeDef *m_handle{nullptr};
+  std::size_t m_cpu_threshold{default_cpu_threshold};
+  request m_queue[QueueDepth]{};
+  volatile std::size_t m_head{0};
+  volatile std::size_t m_count{0};
+  // 是否已有一方负责推进队列（启动中或 DMA 传输中）
+  volatile bool m_active{false};
+  std::size_t m_chunk_units{0};
+  dma_config m_config{};
+};
+
+} // namespace gdut
+
+#endif // BSP_DMA_MEMCPY_HPP
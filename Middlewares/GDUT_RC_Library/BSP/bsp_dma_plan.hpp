@@ -0,0 +1,463 @@
+#ifndef BSP_DMA_PLAN_HPP
+#define BSP_DMA_PLAN_HPP
+
+#include "bsp_dma.hpp"
+#include "bsp_type_traits.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace gdut {
+
+/**
+ * @brief STM32F407 的 DMA 外设请求
+ *
+ * 每个枚举值对应参考手册（RM0090 DMA1/DMA2 请求映射表）中的一路请求。
+ * memory_to_memory 不是外设请求，表示占用任意 DMA2 数据流做存储器拷贝。
+ */
+enum class dma_request : uint8_t {
+  spi1_rx,
+  spi1_tx,
+  spi2_rx,
+  spi2_tx,
+  spi3_rx,
+  spi3_tx,
+  i2c1_rx,
+  i2c1_tx,
+  i2c2_rx,
+  i2c2_tx,
+  i2c3_rx,
+  i2c3_tx,
+  usart1_rx,
+  usart1_tx,
+  usart2_rx,
+  usart2_tx,
+  usart3_rx,
+  usart3_tx,
+  uart4_rx,
+  uart4_tx,
+  uart5_rx,
+  uart5_tx,
+  usart6_rx,
+  usart6_tx,
+  adc1,
+  adc2,
+  adc3,
+  dac1,
+  dac2,
+  dcmi,
+  sdio,
+  tim1_up,
+  tim1_trig,
+  tim1_com,
+  tim1_ch1,
+  tim1_ch2,
+  tim1_ch3,
+  tim1_ch4,
+  tim2_up,
+  tim2_ch1,
+  tim2_ch2,
+  tim2_ch3,
+  tim2_ch4,
+  tim3_up,
+  tim3_trig,
+  tim3_ch1,
+  tim3_ch2,
+  tim3_ch3,
+  tim3_ch4,
+  tim4_up,
+  tim4_ch1,
+  tim4_ch2,
+  tim4_ch3,
+  tim5_up,
+  tim5_trig,
+  tim5_ch1,
+  tim5_ch2,
+  tim5_ch3,
+  tim5_ch4,
+  tim6_up,
+  tim7_up,
+  tim8_up,
+  tim8_trig,
+  tim8_com,
+  tim8_ch1,
+  tim8_ch2,
+  tim8_ch3,
+  tim8_ch4,
+  memory_to_memory
+};
+
+/**
+ * @brief 一条 DMA 路由：某个请求可以使用的（数据流，通道）组合
+ */
+struct dma_route {
+  dma_request request;
+  dma_stream_type stream;
+  dma_channel channel;
+};
+
+namespace detail {
+
+using enum dma_request;
+using enum dma_stream_type;
+using enum dma_channel;
+
+// RM0090 表 42/43：DMA1/DMA2 请求映射（按数据流升序排列，规划时依此顺序尝试）
+inline constexpr dma_route dma_request_map[] = {
+    // DMA1
+    {spi3_rx, dma1_stream0, channel_0},
+    {i2c1_rx, dma1_stream0, channel_1},
+    {tim4_ch1, dma1_stream0, channel_2},
+    {uart5_rx, dma1_stream0, channel_4},
+    {tim5_ch3, dma1_stream0, channel_6},
+    {tim5_up, dma1_stream0, channel_6},
+    {tim2_up, dma1_stream1, channel_3},
+    {tim2_ch3, dma1_stream1, channel_3},
+    {usart3_rx, dma1_stream1, channel_4},
+    {tim5_ch4, dma1_stream1, channel_6},
+    {tim5_trig, dma1_stream1, channel_6},
+    {tim6_up, dma1_stream1, channel_7},
+    {spi3_rx, dma1_stream2, channel_0},
+    {tim7_up, dma1_stream2, channel_1},
+    {i2c3_rx, dma1_stream2, channel_3},
+    {uart4_rx, dma1_stream2, channel_4},
+    {tim3_ch4, dma1_stream2, channel_5},
+    {tim3_up, dma1_stream2, channel_5},
+    {tim5_ch1, dma1_stream2, channel_6},
+    {i2c2_rx, dma1_stream2, channel_7},
+    {spi2_rx, dma1_stream3, channel_0},
+    {tim4_ch2, dma1_stream3, channel_2},
+    {usart3_tx, dma1_stream3, channel_4},
+    {tim5_ch4, dma1_stream3, channel_6},
+    {tim5_trig, dma1_stream3, channel_6},
+    {i2c2_rx, dma1_stream3, channel_7},
+    {spi2_tx, dma1_stream4, channel_0},
+    {tim7_up, dma1_stream4, channel_1},
+    {i2c3_tx, dma1_stream4, channel_3},
+    {uart4_tx, dma1_stream4, channel_4},
+    {tim3_ch1, dma1_stream4, channel_5},
+    {tim3_trig, dma1_stream4, channel_5},
+    {tim5_ch2, dma1_stream4, channel_6},
+    {usart3_tx, dma1_stream4, channel_7},
+    {spi3_tx, dma1_stream5, channel_0},
+    {i2c1_rx, dma1_stream5, channel_1},
+    {tim2_ch1, dma1_stream5, channel_3},
+    {usart2_rx, dma1_stream5, channel_4},
+    {tim3_ch2, dma1_stream5, channel_5},
+    {dac1, dma1_stream5, channel_7},
+    {i2c1_tx, dma1_stream6, channel_1},
+    {tim4_up, dma1_stream6, channel_2},
+    {tim2_ch2, dma1_stream6, channel_3},
+    {tim2_ch4, dma1_stream6, channel_3},
+    {usart2_tx, dma1_stream6, channel_4},
+    {tim5_up, dma1_stream6, channel_6},
+    {dac2, dma1_stream6, channel_7},
+    {spi3_tx, dma1_stream7, channel_0},
+    {i2c1_tx, dma1_stream7, channel_1},
+    {tim4_ch3, dma1_stream7, channel_2},
+    {tim2_up, dma1_stream7, channel_3},
+    {tim2_ch4, dma1_stream7, channel_3},
+    {uart5_tx, dma1_stream7, channel_4},
+    {tim3_ch3, dma1_stream7, channel_5},
+    {i2c2_tx, dma1_stream7, channel_7},
+    // DMA2
+    {adc1, dma2_stream0, channel_0},
+    {adc3, dma2_stream0, channel_2},
+    {spi1_rx, dma2_stream0, channel_3},
+    {tim1_trig, dma2_stream0, channel_6},
+    {dcmi, dma2_stream1, channel_1},
+    {adc3, dma2_stream1, channel_2},
+    {usart6_rx, dma2_stream1, channel_5},
+    {tim1_ch1, dma2_stream1, channel_6},
+    {tim8_up, dma2_stream1, channel_7},
+    {tim8_ch1, dma2_stream2, channel_0},
+    {tim8_ch2, dma2_stream2, channel_0},
+    {tim8_ch3, dma2_stream2, channel_0},
+    {adc2, dma2_stream2, channel_1},
+    {spi1_rx, dma2_stream2, channel_3},
+    {usart1_rx, dma2_stream2, channel_4},
+    {usart6_rx, dma2_stream2, channel_5},
+    {tim1_ch2, dma2_stream2, channel_6},
+    {tim8_ch1, dma2_stream2, channel_7},
+    {adc2, dma2_stream3, channel_1},
+    {spi1_tx, dma2_stream3, channel_3},
+    {sdio, dma2_stream3, channel_4},
+    {tim1_ch1, dma2_stream3, channel_6},
+    {tim8_ch2, dma2_stream3, channel_7},
+    {adc1, dma2_stream4, channel_0},
+    {tim1_ch4, dma2_stream4, channel_6},
+    {tim1_trig, dma2_stream4, channel_6},
+    {tim1_com, dma2_stream4, channel_6},
+    {tim8_ch3, dma2_stream4, channel_7},
+    {spi1_tx, dma2_stream5, channel_3},
+    {usart1_rx, dma2_stream5, channel_4},
+    {tim1_up, dma2_stream5, channel_6},
+    {tim1_ch1, dma2_stream6, channel_0},
+    {tim1_ch2, dma2_stream6, channel_0},
+    {tim1_ch3, dma2_stream6, channel_0},
+    {sdio, dma2_stream6, channel_4},
+    {usart6_tx, dma2_stream6, channel_5},
+    {tim1_ch3, dma2_stream6, channel_6},
+    {dcmi, dma2_stream7, channel_1},
+    {usart1_tx, dma2_stream7, channel_4},
+    {usart6_tx, dma2_stream7, channel_5},
+    {tim8_ch4, dma2_stream7, channel_7},
+    {tim8_trig, dma2_stream7, channel_7},
+    {tim8_com, dma2_stream7, channel_7},
+    // 存储器到存储器：任意 DMA2 数据流（通道号无意义，固定为 0）
+    {memory_to_memory, dma2_stream0, channel_0},
+    {memory_to_memory, dma2_stream1, channel_0},
+    {memory_to_memory, dma2_stream2, channel_0},
+    {memory_to_memory, dma2_stream3, channel_0},
+    {memory_to_memory, dma2_stream4, channel_0},
+    {memory_to_memory, dma2_stream5, channel_0},
+    {memory_to_memory, dma2_stream6, channel_0},
+    {memory_to_memory, dma2_stream7, channel_0},
+};
+
+} // namespace detail
+
+/// 查询某个请求能否使用指定数据流，可以时返回对应通道
+[[nodiscard]] constexpr std::optional<dma_channel>
+find_dma_channel(dma_request request, dma_stream_type stream) {
+  for (const auto &route : detail::dma_request_map) {
+    if (route.request == request && route.stream == stream) {
+      return route.channel;
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * @brief 请求的固有传输方向
+ *
+ * 外设收发、ADC/DCMI 与 DAC 的方向是确定的；定时器请求既可用于 PWM 更新
+ * （存储器到外设）也可用于输入捕获（外设到存储器），返回 std::nullopt，
+ * 由调用方自行设置。
+ */
+[[nodiscard]] constexpr std::optional<dma_direction>
+get_dma_request_direction(dma_request request) {
+  using enum dma_request;
+  switch (request) {
+  case spi1_rx:
+  case spi2_rx:
+  case spi3_rx:
+  case i2c1_rx:
+  case i2c2_rx:
+  case i2c3_rx:
+  case usart1_rx:
+  case usart2_rx:
+  case usart3_rx:
+  case uart4_rx:
+  case uart5_rx:
+  case usart6_rx:
+  case adc1:
+  case adc2:
+  case adc3:
+  case dcmi:
+    return dma_direction::peripheral_to_memory;
+  case spi1_tx:
+  case spi2_tx:
+  case spi3_tx:
+  case i2c1_tx:
+  case i2c2_tx:
+  case i2c3_tx:
+  case usart1_tx:
+  case usart2_tx:
+  case usart3_tx:
+  case uart4_tx:
+  case uart5_tx:
+  case usart6_tx:
+  case dac1:
+  case dac2:
+    return dma_direction::memory_to_peripheral;
+  case memory_to_memory:
+    return dma_direction::memory_to_memory;
+  default:
+    return std::nullopt;
+  }
+}
+
+/**
+ * @brief dma_plan 的一个槽位：一个请求，可选地固定到某个数据流
+ *
+ * 从 dma_request 隐式构造时由规划器自动选择数据流；显式给出数据流时
+ * 用于与 CubeMX 已生成的配置保持一致。
+ */
+struct dma_slot {
+  dma_request request;
+  dma_stream_type stream{dma_stream_type::dma1_stream0};
+  bool pinned{false};
+
+  constexpr dma_slot(dma_request request) : request(request) {}
+
+  constexpr dma_slot(dma_request request, dma_stream_type stream)
+      : request(request), stream(stream), pinned(true) {}
+};
+
+/**
+ * @brief 编译期 DMA 数据流/通道分配
+ *
+ * 根据 F407 的请求映射表，为每个槽位选择一个（数据流，通道）组合，
+ * 保证任意两个请求不共用同一数据流。分配结果在编译期确定，无法满足时
+ * 以 static_assert 报错，而不是在运行时让两个驱动悄悄争用同一数据流。
+ *
+ * 特性：
+ * - 槽位按声明顺序依次分配，每个槽位优先尝试编号最小的可用数据流；
+ *   同一控制器内软件优先级相同时，编号小的数据流在仲裁中胜出，
+ *   因此应把对延迟最敏感的请求写在最前面
+ * - 分配失败时回溯，只要存在无冲突的方案就一定能找到
+ * - configure<Request>() 生成 dma_proxy 的数据流、通道与方向配置
+ * - matches<Request>() 检查现有 HAL 句柄是否与规划一致（核对 CubeMX 输出）
+ *
+ * 线程安全：纯编译期计算；configure() 与 dma_proxy 的 set_* 方法相同，
+ * 应在传输开始前的配置阶段调用。
+ *
+ * 使用示例：
+ * @code
+ * using board_dma = gdut::dma_plan<
+ *     gdut::dma_request::spi1_rx, gdut::dma_request::spi1_tx,
+ *     gdut::dma_request::usart1_rx,
+ *     gdut::dma_slot{gdut::dma_request::memory_to_memory,
+ *                    gdut::dma_stream_type::dma2_stream1}>;
+ *
+ * gdut::dma_proxy spi_rx(&hdma_spi1_rx);
+ * board_dma::configure<gdut::dma_request::spi1_rx>(spi_rx);
+ * spi_rx.init();
+ * @endcode
+ */
+template <dma_slot... Slots> class dma_plan {
+public:
+  static constexpr std::size_t size = sizeof...(Slots);
+
+private:
+  static constexpr std::array<dma_slot, size> slots{Slots...};
+
+  struct solution {
+    bool ok{false};
+    std::array<dma_route, size> routes{};
+  };
+
+  static constexpr bool has_duplicate_request() {
+    for (std::size_t i = 0; i < size; ++i) {
+      for (std::size_t j = i + 1; j < size; ++j) {
+        if (slots[i].request == slots[j].request) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  static constexpr bool pins_valid() {
+    for (const auto &slot : slots) {
+      if (slot.pinned && !find_dma_channel(slot.request, slot.stream)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static constexpr bool assign(std::size_t index, uint32_t used_streams,
+                               solution &result) {
+    if (index == size) {
+      return true;
+    }
+    const dma_slot &slot = slots[index];
+    for (const auto &route : detail::dma_request_map) {
+      if (route.request != slot.request ||
+          (slot.pinned && route.stream != slot.stream)) {
+        continue;
+      }
+      const uint32_t mask = 1U << std::to_underlying(route.stream);
+      if ((used_streams & mask) != 0U) {
+        continue;
+      }
+      result.routes[index] = route;
+      if (assign(index + 1, used_streams | mask, result)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static constexpr solution solve() {
+    solution result{};
+    result.ok = assign(0, 0U, result);
+    return result;
+  }
+
+  static constexpr solution plan_result = solve();
+
+  static_assert(!has_duplicate_request(),
+                "dma_plan: the same DMA request is listed more than once.");
+  static_assert(pins_valid(),
+                "dma_plan: a pinned stream cannot serve its DMA request.");
+  static_assert(plan_result.ok,
+                "dma_plan: DMA stream conflict, no conflict-free assignment "
+                "exists for the requested peripherals.");
+
+  static constexpr std::size_t index_of(dma_request request) {
+    for (std::size_t i = 0; i < size; ++i) {
+      if (slots[i].request == request) {
+        return i;
+      }
+    }
+    return size;
+  }
+
+public:
+  /// 全部分配结果，顺序与模板参数一致
+  static constexpr std::array<dma_route, size> routes = plan_result.routes;
+
+  template <dma_request Request> static constexpr bool contains() {
+    return index_of(Request) != size;
+  }
+
+  template <dma_request Request> static constexpr dma_route route() {
+    static_assert(contains<Request>(),
+                  "dma_plan: request is not part of this plan.");
+    return routes[index_of(Request)];
+  }
+
+  template <dma_request Request> static constexpr dma_stream_type stream() {
+    return route<Request>().stream;
+  }
+
+  template <dma_request Request> static constexpr dma_channel channel() {
+    return route<Request>().channel;
+  }
+
+  /**
+   * @brief 将规划结果写入 dma_proxy 的 Init 配置（数据流、通道、方向）。
+   *
+   * 方向固定的请求同时设置方向；定时器请求的方向、以及数据宽度、
+   * 地址递增、模式、优先级等仍由调用方设置。之后须调用 init()。
+   */
+  template <dma_request Request> static void configure(dma_proxy &proxy) {
+    constexpr dma_route planned = route<Request>();
+    proxy.set_instance(planned.stream);
+    proxy.set_channel(planned.channel);
+    if constexpr (constexpr auto direction =
+                      get_dma_request_direction(Request);
+                  direction.has_value()) {
+      proxy.set_direction(*direction);
+    }
+  }
+
+  /// 检查 HAL 句柄（例如 CubeMX 生成的）是否使用了规划的数据流与通道
+  template <dma_request Request>
+  [[nodiscard]] static bool matches(const DMA_HandleTypeDef *handle) {
+    constexpr dma_route planned = route<Request>();
+    return handle != nullptr &&
+           handle->Instance == get_dma_stream(planned.stream) &&
+           handle->Init.Channel == std::to_underlying(planned.channel);
+  }
+};
+
+} // namespace gdut
+
+#endif // BSP_DMA_PLAN_HPP
@@ -0,0 +1,220 @@
+#include "bsp_encoder.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gdut {
+
+encoder::encoder(timer &tim) : m_htim(tim.get_htim()) {
+  if (m_htim == nullptr) {
+    return;
+  }
+  tim.register_period_elapsed_callback([this] { on_update(); });
+  (void)tim.register_capture_callback(1, [this] { on_capture(); });
+}
+
+HAL_StatusTypeDef encoder::start() {
+  if (!valid()) {
+    return HAL_ERROR;
+  }
+  TIM_TypeDef *tim = m_htim->Instance;
+  m_range = static_cast<uint64_t>(tim->ARR) + 1U;
+  // SMS = 011 时 TI1、TI2 的双边沿都计数，TI1 一个周期 4 个计数；
+  // 只在一路上计数时为 2 个
+  m_counts_per_edge =
+      (tim->SMCR & TIM_SMCR_SMS) == (TIM_SMCR_SMS_0 | TIM_SMCR_SMS_1) ? 4U
+                                                                      : 2U;
+  set_standstill_timeout(m_standstill_us);
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  begin_write();
+  tim->CNT = 0;
+  m_wraps = 0;
+  m_offset = 0;
+  m_edge_position = 0;
+  m_velocity = 0.0F;
+  m_has_edge = false;
+  end_write();
+  __HAL_TIM_CLEAR_IT(m_htim, TIM_IT_UPDATE | TIM_IT_CC1);
+  __HAL_TIM_ENABLE_IT(m_htim, TIM_IT_UPDATE);
+  __set_PRIMASK(primask);
+
+  // 不使用 HAL_TIM_Encoder_Start_IT：它会打开每个边沿的捕获中断
+  return HAL_TIM_Encoder_Start(m_htim, TIM_CHANNEL_ALL);
+}
+
+HAL_StatusTypeDef encoder::stop() {
+  if (!valid()) {
+    return HAL_ERROR;
+  }
+  __HAL_TIM_DISABLE_IT(m_htim, TIM_IT_UPDATE | TIM_IT_CC1);
+  return HAL_TIM_Encoder_Stop(m_htim, TIM_CHANNEL_ALL);
+}
+
+void encoder::sample() noexcept {
+  if (!valid()) {
+    return;
+  }
+  TIM_TypeDef *tim = m_htim->Instance;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  // 停转超时后丢弃上一个边沿：CYCCNT 回绕后它的时间戳会重新显得
+  // “很近”，read() 会返回停转前的速度，重新起步的窗口也会跨过回绕
+  if (m_has_edge && standstill(cycle_counter::now())) {
+    begin_write();
+    m_velocity = 0.0F;
+    m_has_edge = false;
+    end_write();
+  }
+  // 先清除之前边沿留下的捕获标志，否则打开中断会立即处理旧的 CCR1
+  tim->SR = ~(TIM_SR_CC1IF | TIM_SR_CC1OF);
+  tim->DIER |= TIM_DIER_CC1IE;
+  __set_PRIMASK(primask);
+}
+
+void encoder::set_standstill_timeout(uint32_t timeout_us) noexcept {
+  // 超时不超过 CYCCNT 量程的一半，给 sample() 的调用间隔留出余量
+  constexpr uint64_t max_cycles = UINT32_MAX / 2U;
+  const uint64_t cycles_per_us = SystemCoreClock / 1000000U;
+  const uint64_t cycles =
+      std::clamp<uint64_t>(timeout_us * cycles_per_us, 1U, max_cycles);
+  m_standstill_us = timeout_us;
+  m_standstill_cycles = static_cast<uint32_t>(cycles);
+}
+
+bool encoder::standstill(uint32_t now) const noexcept {
+  return now - m_edge_time > m_standstill_cycles;
+}
+
+encoder_state encoder::read() const noexcept {
+  const TIM_TypeDef *tim = m_htim->Instance;
+  int64_t wraps = 0;
+  int64_t offset = 0;
+  int64_t edge_position = 0;
+  uint32_t edge_time = 0;
+  float velocity = 0.0F;
+  bool has_edge = false;
+  bool uif = false;
+  uint32_t counter = 0;
+  uint32_t sequence = 0;
+  do {
+    sequence = m_sequence.load(std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_acquire);
+    wraps = m_wraps;
+    offset = m_offset;
+    edge_position = m_edge_position;
+    edge_time = m_edge_time;
+    velocity = m_velocity;
+    has_edge = m_has_edge;
+    // 先读 UIF 再读 CNT：UIF 已置位时读到的 CNT 一定在回绕之后
+    uif = (tim->SR & TIM_SR_UIF) != 0U;
+    counter = tim->CNT;
+    std::atomic_signal_fence(std::memory_order_acquire);
+  } while ((sequence & 1U) != 0U ||
+           sequence != m_sequence.load(std::memory_order_relaxed));
+
+  const int64_t raw = extend(wraps, counter, uif);
+  const uint32_t age = cycle_counter::now() - edge_time;
+  if (!has_edge || age > m_standstill_cycles) {
+    velocity = 0.0F;
+  } else if (age != 0U) {
+    // 上一个捕获边沿之后还没走完一个 TI1 周期：平均速度不超过
+    // 一个周期的计数除以已过去的时间
+    const int64_t moved = raw - edge_position;
+    if (moved < m_counts_per_edge && -moved < m_counts_per_edge) {
+      const float bound = static_cast<float>(m_counts_per_edge) *
+                          static_cast<float>(SystemCoreClock) /
+                          static_cast<float>(age);
+      if (std::fabs(velocity) > bound) {
+        velocity = std::copysign(bound, velocity);
+      }
+    }
+  }
+  return {raw + offset, velocity};
+}
+
+void encoder::set_position(int64_t value) noexcept {
+  const TIM_TypeDef *tim = m_htim->Instance;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const bool uif = (tim->SR & TIM_SR_UIF) != 0U;
+  const int64_t raw = extend(m_wraps, tim->CNT, uif);
+  begin_write();
+  m_offset = value - raw;
+  end_write();
+  __set_PRIMASK(primask);
+}
+
+void encoder::on_update() noexcept {
+  // HAL 已清除 UIF。上溢后 CNT 从 0 附近继续增加，下溢后从 ARR 附近
+  // 继续减小；用 CNT 所在的半区判断方向比 DIR 位更可靠（在零点附近
+  // 来回抖动时 DIR 可能已经翻转）
+  const uint32_t counter = m_htim->Instance->CNT;
+  begin_write();
+  m_wraps += counter < m_range / 2U ? 1 : -1;
+  end_write();
+}
+
+void encoder::on_capture() noexcept {
+  const uint32_t now = cycle_counter::now();
+  TIM_TypeDef *tim = m_htim->Instance;
+  // 每次 sample() 只处理一个边沿
+  __HAL_TIM_DISABLE_IT(m_htim, TIM_IT_CC1);
+  const bool uif = (tim->SR & TIM_SR_UIF) != 0U;
+  const uint32_t counter = tim->CNT;
+  const uint32_t captured = tim->CCR1;
+
+  // 捕获值可能在挂起的回绕之前：以当前 CNT 判断挂起回绕的方向，
+  // 再看捕获值落在回绕的哪一侧
+  int64_t wraps = m_wraps;
+  if (uif) {
+    const bool overflow = counter < m_range / 2U;
+    const bool after_wrap = (captured < m_range / 2U) == overflow;
+    if (after_wrap) {
+      wraps += overflow ? 1 : -1;
+    }
+  }
+  const int64_t position = extend(wraps, captured, false);
+
+  begin_write();
+  const uint32_t window = now - m_edge_time;
+  if (m_has_edge && window != 0U && !standstill(now)) {
+    m_velocity = static_cast<float>(position - m_edge_position) *
+                 static_cast<float>(SystemCoreClock) /
+                 static_cast<float>(window);
+  } else {
+    // 第一个边沿或停转后重新起步：窗口过长，本次只作为新窗口的起点
+    m_velocity = 0.0F;
+  }
+  m_edge_position = position;
+  m_edge_time = now;
+  m_has_edge = true;
+  end_write();
+}
+
+int64_t encoder::extend(int64_t wraps, uint32_t counter,
+                        bool uif) const noexcept {
+  if (uif) {
+    // 回绕已发生但更新中断尚未执行
+    wraps += counter < m_range / 2U ? 1 : -1;
+  }
+  return wraps * static_cast<int64_t>(m_range) +
+         static_cast<int64_t>(counter);
+}
+
+// 读者与写者（中断）在同一个核上，只需阻止编译器重排；
+// 序号为奇数表示正在写入
+void encoder::begin_write() noexcept {
+  m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1U,
+                   std::memory_order_relaxed);
+  std::atomic_signal_fence(std::memory_order_release);
+}
+
+void encoder::end_write() noexcept {
+  std::atomic_signal_fence(std::memory_order_release);
+  m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1U,
+                   std::memory_order_relaxed);
+}
+
+} // namespace gdut
@@ -0,0 +1,142 @@
+#ifndef BSP_ENCODER_HPP
+#define BSP_ENCODER_HPP
+
+#include "bsp_clock.hpp"
+#include "bsp_timer.hpp"
+#include "bsp_uncopyable.hpp"
+#include "stm32f4xx_hal.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace gdut {
+
+/**
+ * @brief 编码器的一次一致读数
+ */
+struct encoder_state {
+  int64_t position; ///< 累计位置（计数）
+  float velocity;   ///< 速度（计数/秒）
+};
+
+/**
+ * @brief 64 位累计位置 + M/T 法测速的增量编码器
+ *
+ * 位置：定时器更新中断累计计数器的回绕次数，与当前 CNT 组合为 64 位位置。
+ * 读取时若更新中断已挂起但尚未执行，按 CNT 所在的半区补上这次回绕，
+ * 读数不会在回绕瞬间跳变一个量程。
+ *
+ * 测速（M/T 法）：sample() 打开通道 1 捕获中断，之后 TI1 的第一个有效
+ * 边沿触发中断，记录 CCR1 中硬件捕获的边沿计数与 CYCCNT 时间戳，并关闭
+ * 捕获中断。相邻两个这样的边沿之间的计数差 ΔN 与时间差 ΔT 给出速度
+ * ΔN/ΔT：
+ * - 高速时窗口约等于 sample() 的调用周期，等价于 M 法（计数差分）
+ * - 低速时窗口两端都落在编码器边沿上，没有 ±1 计数的量化误差，等价于
+ *   T 法（测周期）
+ * - 每次 sample() 最多产生一次捕获中断，与转速无关
+ *
+ * 停转处理：距上一个捕获边沿超过停转超时（默认 100 ms）时速度为 0；
+ * 此前若位置变化不足一个 TI1 周期，速度上限为一个 TI1 周期的计数除以
+ * 已过去的时间，减速到停止时速度平滑衰减。sample() 发现已超时时丢弃
+ * 上一个边沿，重新起步的第一个边沿只作为新窗口的起点。32 位 CYCCNT
+ * 在 168 MHz 下约 25.6 s 回绕一次，边沿时间戳须在回绕前被丢弃，
+ * 因此两次 sample() 的间隔不能超过 CYCCNT 量程减去停转超时
+ * （超时取上限时约 12.7 s）。
+ *
+ * 线程安全：
+ * - read() 无锁：中断以序号（seqlock）发布状态，读者发现读取期间被更新
+ *   则重读。可在任务或不高于定时器中断优先级的中断中调用
+ * - sample() 可在任意上下文调用
+ *
+ * 重要约束：
+ * - 定时器须配置为编码器模式，通道 1 为输入（HAL 编码器初始化的默认配置）
+ * - 使用前调用 cycle_counter::enable()
+ * - 更新与捕获中断由 timer_irq_handler 分发到 timer 的回调，
+ *   应用不得再定义 HAL_TIM_PeriodElapsedCallback/HAL_TIM_IC_CaptureCallback；
+ *   TIM1/TIM8 的更新与捕获中断须配置为相同的抢占优先级
+ * - 两次 sample() 之间的位置变化不能超过计数器量程的一半
+ * - 停转超时在 start() 与 set_standstill_timeout() 时按 SystemCoreClock
+ *   换算，修改系统时钟后须重新 start() 或设置超时
+ *
+ * 使用示例：
+ * @code
+ * gdut::timer encoder_timer(&htim3);
+ * gdut::encoder wheel(encoder_timer);
+ *
+ * gdut::cycle_counter::enable();
+ * wheel.start();
+ *
+ * // 1 kHz 控制回路
+ * wheel.sample();
+ * gdut::encoder_state s = wheel.read();
+ * @endcode
+ */
+class encoder : uncopyable {
+public:
+  /**
+   * @brief 绑定编码器模式的定时器并接管它的更新与通道 1 捕获回调
+   */
+  explicit encoder(timer &tim);
+  ~encoder() noexcept = default;
+
+  [[nodiscard]] bool valid() const noexcept { return m_htim != nullptr; }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /// 清零计数并启动编码器与更新中断
+  HAL_StatusTypeDef start();
+  HAL_StatusTypeDef stop();
+
+  /**
+   * @brief 开始下一个测速窗口：之后的第一个 TI1 边沿结束当前窗口
+   *
+   * 在控制回路中按固定周期调用。
+   */
+  void sample() noexcept;
+
+  /// 一致地读取位置与速度（无锁）
+  [[nodiscard]] encoder_state read() const noexcept;
+
+  [[nodiscard]] int64_t position() const noexcept { return read().position; }
+
+  /// 把当前位置设为 value（回零）
+  void set_position(int64_t value) noexcept;
+
+  /**
+   * @brief 超过该时间没有捕获到边沿则速度为 0
+   *
+   * 按当前 SystemCoreClock 换算为 CYCCNT 周期，上限为 CYCCNT 量程的
+   * 一半（168 MHz 时约 12.7 s）。
+   */
+  void set_standstill_timeout(uint32_t timeout_us) noexcept;
+
+private:
+  void on_update() noexcept;
+  void on_capture() noexcept;
+  /// 计数器值加上回绕得到未加偏移的位置；uif 为回绕中断已挂起未处理
+  [[nodiscard]] int64_t extend(int64_t wraps, uint32_t counter,
+                               bool uif) const noexcept;
+  /// CYCCNT 时间戳 now 距上一个捕获边沿超过停转超时
+  [[nodiscard]] bool standstill(uint32_t now) const noexcept;
+  void begin_write() noexcept;
+  void end_write() noexcept;
+
+  TIM_HandleTypeDef *m_htim{nullptr};
+  uint64_t m_range{0x10000};     // ARR + 1
+  uint32_t m_counts_per_edge{4}; // TI1 一个周期对应的计数
+  uint32_t m_standstill_us{100000};
+  uint32_t m_standstill_cycles{0}; // 由 m_standstill_us 换算
+
+  // 以下状态由中断写入，读者通过 m_sequence 检查一致性
+  std::atomic<uint32_t> m_sequence{0};
+  int64_t m_wraps{0};
+  int64_t m_offset{0};
+  int64_t m_edge_position{0};
+  uint32_t m_edge_time{0};
+  float m_velocity{0.0F};
+  bool m_has_edge{false};
+};
+
+} // namespace gdut
+
+#endif // BSP_ENCODER_HPP
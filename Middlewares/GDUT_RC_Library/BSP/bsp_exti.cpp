@@ -0,0 +1,147 @@
+#include "bsp_exti.hpp"
+
+namespace gdut {
+
+std::array<exti::line_entry, exti::line_count> exti::lines{};
+timer *exti::debounce_timer = nullptr;
+volatile uint16_t exti::debouncing = 0;
+
+bool exti::attach_line(std::size_t line, GPIO_TypeDef *port, uint8_t edges,
+                       callback_t callback, uint16_t debounce_ticks) {
+  const bool level = (port->IDR & (1U << line)) != 0U;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  line_entry &e = lines[line];
+  if (e.port != nullptr && e.port != port) {
+    __set_PRIMASK(primask);
+    return false; // 同一线已属于另一个端口
+  }
+  e.callback = std::move(callback);
+  e.port = port;
+  e.edges = edges;
+  e.debounce_ticks = debounce_ticks;
+  e.sample = level;
+  e.stable = level;
+  __set_PRIMASK(primask);
+  return true;
+}
+
+void exti::detach_line(std::size_t line, const GPIO_TypeDef *port) {
+  const auto bit = static_cast<uint16_t>(1U << line);
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  line_entry &e = lines[line];
+  if (e.port == port) {
+    if ((debouncing & bit) != 0U) {
+      // 去抖中被注销：恢复 EXTI，避免该线一直被屏蔽
+      debouncing = debouncing & static_cast<uint16_t>(~bit);
+      EXTI->PR = bit;
+      EXTI->IMR |= bit;
+    }
+    e = line_entry{};
+  }
+  __set_PRIMASK(primask);
+}
+
+HAL_StatusTypeDef exti::set_debounce_timer(timer &tim) {
+  TIM_HandleTypeDef *htim = tim.get_htim();
+  if (htim == nullptr) {
+    return HAL_ERROR;
+  }
+  __HAL_TIM_DISABLE_IT(htim, TIM_IT_UPDATE);
+  tim.register_period_elapsed_callback([] { debounce_tick(); });
+  debounce_timer = &tim;
+  return HAL_TIM_Base_Start(htim);
+}
+
+void exti::dispatch(uint16_t gpio_pin) noexcept {
+  // HAL 每次只报告一个引脚，线号即位序号
+  const auto line = static_cast<std::size_t>(std::countr_zero(gpio_pin));
+  if (line >= line_count) {
+    return;
+  }
+  line_entry &e = lines[line];
+  if (e.debounce_ticks == 0U || debounce_timer == nullptr) {
+    if (e.callback) {
+      e.callback();
+    }
+    return;
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  // 屏蔽本线，抖动期间的边沿不再进中断
+  EXTI->IMR &= ~static_cast<uint32_t>(gpio_pin);
+  e.sample = (e.port->IDR & gpio_pin) != 0U;
+  e.countdown = e.debounce_ticks;
+  // 单边沿触发时另一方向的边沿不进中断，按触发方向推出边沿之前的电平
+  if (e.edges == falling) {
+    e.stable = true;
+  } else if (e.edges == rising) {
+    e.stable = false;
+  }
+  const bool idle = debouncing == 0U;
+  debouncing = debouncing | gpio_pin;
+  if (idle) {
+    TIM_HandleTypeDef *htim = debounce_timer->get_htim();
+    __HAL_TIM_CLEAR_IT(htim, TIM_IT_UPDATE);
+    __HAL_TIM_ENABLE_IT(htim, TIM_IT_UPDATE);
+  }
+  __set_PRIMASK(primask);
+}
+
+void exti::debounce_tick() noexcept {
+  uint16_t fire = 0;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint16_t pending = debouncing;
+  while (pending != 0U) {
+    const auto line = static_cast<std::size_t>(std::countr_zero(pending));
+    const auto bit = static_cast<uint16_t>(1U << line);
+    pending = pending & static_cast<uint16_t>(~bit);
+
+    line_entry &e = lines[line];
+    const bool level = (e.port->IDR & bit) != 0U;
+    if (level != e.sample) {
+      // 仍在抖动：重新计数
+      e.sample = level;
+      e.countdown = e.debounce_ticks;
+      continue;
+    }
+    if (--e.countdown != 0U) {
+      continue;
+    }
+
+    debouncing = debouncing & static_cast<uint16_t>(~bit);
+    // 丢弃屏蔽期间的挂起位后重新打开本线
+    EXTI->PR = bit;
+    EXTI->IMR |= bit;
+    if (level != e.stable) {
+      e.stable = level;
+      const uint8_t edge = level ? rising : falling;
+      if ((e.edges & edge) != 0U) {
+        fire = fire | bit;
+      }
+    }
+  }
+  if (debouncing == 0U) {
+    __HAL_TIM_DISABLE_IT(debounce_timer->get_htim(), TIM_IT_UPDATE);
+  }
+  __set_PRIMASK(primask);
+
+  // 回调在临界区之外执行
+  while (fire != 0U) {
+    const auto line = static_cast<std::size_t>(std::countr_zero(fire));
+    fire = fire & static_cast<uint16_t>(fire - 1U);
+    if (lines[line].callback) {
+      lines[line].callback();
+    }
+  }
+}
+
+} // namespace gdut
+
+// 强符号定义以可靠覆盖 HAL 的 __weak 默认实现
+extern "C" void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+  gdut::exti::dispatch(GPIO_Pin);
+}
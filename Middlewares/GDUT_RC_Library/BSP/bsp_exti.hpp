@@ -0,0 +1,139 @@
+#ifndef BSP_EXTI_HPP
+#define BSP_EXTI_HPP
+
+#include "bsp_function.hpp"
+#include "bsp_gpio_pin.hpp"
+#include "bsp_timer.hpp"
+#include "stm32f4xx_hal.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace gdut {
+
+/**
+ * @brief EXTI 中断分发表与共享定时器去抖
+ *
+ * bsp_exti.cpp 以强符号覆盖 HAL_GPIO_EXTI_Callback，按 EXTI 线号
+ * （GPIO_PIN_x 的位序号，countr_zero 一次得到）查表调用回调，
+ * 应用不再需要按引脚逐个比较的 if 链。
+ *
+ * 机械开关等抖动输入可以指定去抖节拍数：边沿到来后屏蔽该线的 EXTI，
+ * 由一个共享的基准定时器每节拍采样一次电平，连续 debounce_ticks 个节拍
+ * 不变才认为稳定，稳定电平改变且符合引脚配置的触发边沿时调用回调，
+ * 然后重新打开 EXTI。没有线在去抖时定时器的更新中断关闭。
+ *
+ * 特性：
+ * - 分发为 O(1)，与登记的引脚数量无关
+ * - 引脚类型在编译期检查：单个引脚、GPIO_MODE_IT_* 模式
+ * - 所有去抖引脚共用一个定时器，不需要轮询任务
+ *
+ * 线程安全：
+ * - attach()/detach() 可在任务中调用，与中断之间以保存/恢复 PRIMASK 的
+ *   临界区同步
+ * - 回调运行在 EXTI 中断（不去抖）或定时器更新中断（去抖）中
+ *
+ * 重要约束：
+ * - 同一 EXTI 线同一时刻只能属于一个端口（硬件限制：PA0 与 PB0 共用线 0）
+ * - CubeMX 中须使能对应的 EXTIx NVIC 中断；应用不得再定义
+ *   HAL_GPIO_EXTI_Callback
+ * - 去抖定时器的更新回调由本类接管，PSC/ARR 决定节拍（如 1 kHz）
+ *
+ * 使用示例：
+ * @code
+ * gdut::gpio_pin<gdut::gpio_port::E,
+ *                GPIO_InitTypeDef{.Pin = GPIO_PIN_7,
+ *                                 .Mode = GPIO_MODE_IT_FALLING,
+ *                                 .Pull = GPIO_PULLUP}> limit_switch;
+ * gdut::timer debounce_timer(&htim7); // 1 kHz 更新
+ *
+ * gdut::exti::set_debounce_timer(debounce_timer);
+ * gdut::exti::attach(limit_switch, [] { on_limit(); }, 10); // 10 ms 去抖
+ * gdut::exti::attach(imu_drdy, [] { imu_ready(); });        // 不去抖
+ * @endcode
+ */
+class exti {
+public:
+  using callback_t = function<void()>;
+
+  static constexpr std::size_t line_count = 16;
+
+  exti() = delete;
+
+  /**
+   * @brief 登记引脚的 EXTI 回调
+   *
+   * @param debounce_ticks  0 表示不去抖；否则为稳定所需的去抖定时器节拍数
+   * @return 该线已被另一个端口的引脚占用时返回 false
+   */
+  template <gpio_port Port, GPIO_InitTypeDef InitStruct>
+  static bool attach(const gpio_pin<Port, InitStruct> &pin,
+                     callback_t callback, uint16_t debounce_ticks = 0) {
+    (void)pin;
+    return attach_line(line_of<Port, InitStruct>(),
+                       gpio_pin<Port, InitStruct>::port(),
+                       edges_of<InitStruct>(), std::move(callback),
+                       debounce_ticks);
+  }
+
+  template <gpio_port Port, GPIO_InitTypeDef InitStruct>
+  static void detach(const gpio_pin<Port, InitStruct> &pin) {
+    (void)pin;
+    detach_line(line_of<Port, InitStruct>(),
+                gpio_pin<Port, InitStruct>::port());
+  }
+
+  /**
+   * @brief 指定去抖使用的基准定时器并启动计数（更新中断按需开关）
+   */
+  static HAL_StatusTypeDef set_debounce_timer(timer &tim);
+
+  /// HAL_GPIO_EXTI_Callback 的分发入口，gpio_pin 为 GPIO_PIN_x
+  static void dispatch(uint16_t gpio_pin) noexcept;
+
+private:
+  enum edge : uint8_t { rising = 0x1, falling = 0x2 };
+
+  struct line_entry {
+    callback_t callback{};
+    GPIO_TypeDef *port{nullptr};
+    uint16_t debounce_ticks{0};
+    uint16_t countdown{0};
+    uint8_t edges{0};
+    bool sample{false}; // 最近一次采样
+    bool stable{false}; // 最近一次确认的稳定电平
+  };
+
+  template <gpio_port Port, GPIO_InitTypeDef InitStruct>
+  static constexpr std::size_t line_of() {
+    constexpr uint16_t mask = gpio_pin<Port, InitStruct>::pin_mask;
+    static_assert(std::has_single_bit(mask),
+                  "an EXTI pin must select exactly one GPIO_PIN_x");
+    static_assert((InitStruct.Mode & EXTI_IT) != 0U,
+                  "gpio_pin must be configured with GPIO_MODE_IT_*");
+    return static_cast<std::size_t>(std::countr_zero(mask));
+  }
+
+  template <GPIO_InitTypeDef InitStruct> static constexpr uint8_t edges_of() {
+    return static_cast<uint8_t>(
+        ((InitStruct.Mode & TRIGGER_RISING) != 0U ? rising : 0U) |
+        ((InitStruct.Mode & TRIGGER_FALLING) != 0U ? falling : 0U));
+  }
+
+  static bool attach_line(std::size_t line, GPIO_TypeDef *port, uint8_t edges,
+                          callback_t callback, uint16_t debounce_ticks);
+  static void detach_line(std::size_t line, const GPIO_TypeDef *port);
+  static void debounce_tick() noexcept;
+
+  static std::array<line_entry, line_count> lines;
+  static timer *debounce_timer;
+  // 正在去抖（EXTI 已屏蔽）的线
+  static volatile uint16_t debouncing;
+};
+
+} // namespace gdut
+
+#endif // BSP_EXTI_HPP
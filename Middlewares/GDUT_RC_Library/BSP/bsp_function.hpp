@@ -1,7 +1,7 @@
 #ifndef BSP_FUNCTION_HPP
 #define BSP_FUNCTION_HPP
 
-#include "bsp_type_traits.hpp"
+#include "bsp_meta.hpp"
 #include <cstddef>
 #include <exception>
 #include <new>
@@ -6,6 +6,11 @@
 
 #include "bsp_uncopyable.hpp"
 
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
 namespace gdut {
 
 /**
@@ -29,6 +34,8 @@ template <gpio_port Port, GPIO_InitTypeDef InitStruct> struct gpio_pin_tag {
  * - RAII 资源管理
  * - 类型安全的端口和引脚选择
  * - 不可拷贝（硬件资源）
+ * - 端口地址与引脚掩码在编译期确定：write()/set()/reset() 为一次 BSRR
+ *   写入，toggle() 读 ODR 后以一次 BSRR 写入翻转，不影响同端口其它引脚
  *
  * 使用示例：
  *   gdut::gpio_pin<gdut::gpio_port::A,
@@ -44,30 +51,170 @@ class gpio_pin : private uncopyable {
 public:
   using tag_type = gpio_pin_tag<Port, InitStruct>;
 
+  static constexpr uintptr_t port_base = get_gpio_port_base(Port);
+  static constexpr uint16_t pin_mask = static_cast<uint16_t>(InitStruct.Pin);
+
+  static_assert(port_base != 0, "invalid GPIO port");
+  static_assert(pin_mask != 0, "InitStruct.Pin must select at least one pin");
+
   gpio_pin() {
     GPIO_InitTypeDef init_struct = tag_type::init_struct;
-    HAL_GPIO_Init(get_gpio_port_ptr(tag_type::port), &init_struct);
+    HAL_GPIO_Init(port(), &init_struct);
+  }
+
+  ~gpio_pin() { HAL_GPIO_DeInit(port(), tag_type::init_struct.Pin); }
+
+  /// 端口寄存器（常量地址）
+  static GPIO_TypeDef *port() noexcept {
+    return reinterpret_cast<GPIO_TypeDef *>(port_base);
+  }
+
+  void write(bool state) noexcept {
+    // BSRR 低 16 位置位、高 16 位复位，一次写入
+    port()->BSRR = static_cast<uint32_t>(pin_mask) << (state ? 0U : 16U);
+  }
+
+  void set() noexcept { port()->BSRR = pin_mask; }
+
+  void reset() noexcept {
+    port()->BSRR = static_cast<uint32_t>(pin_mask) << 16U;
+  }
+
+  bool read() const noexcept { return (port()->IDR & pin_mask) != 0U; }
+
+  void toggle() noexcept {
+    // 只改写本引脚：当前为高的复位、为低的置位，不对 ODR 读改写
+    const uint32_t odr = port()->ODR;
+    port()->BSRR = ((odr & pin_mask) << 16U) | (~odr & pin_mask);
+  }
+};
+
+/**
+ * @brief 同一端口上多个引脚的原子批量读写
+ *
+ * 步进电机的 STEP/DIR/EN、并行总线、多路使能等需要多个引脚同时变化。
+ * 逐个调用 gpio_pin::write() 会在引脚之间留下几个周期的偏差，对 ODR
+ * 读改写又会与中断中修改同端口其它引脚的代码竞争。gpio_group 把
+ * 所有引脚的置位与复位合并为一次 BSRR 写入，各引脚在同一个 AHB 周期变化。
+ *
+ * 特性：
+ * - 引脚列表为模板参数，掩码与位置映射在编译期确定
+ * - write() 的第 i 位对应 Pins 中的第 i 个引脚；引脚连续递增时
+ *   只需一次移位，否则按位展开（编译期循环）
+ * - write_raw()/read_raw() 直接使用端口位（GPIO_PIN_x）
+ *
+ * 重要约束：
+ * - 本类不初始化引脚，须先用 gpio_pin 或 CubeMX 配置为输出（读取时为输入）
+ * - Pins 须为互不重叠的 GPIO_PIN_x
+ *
+ * 使用示例：
+ * @code
+ * using stepper_pins = gdut::gpio_group<gdut::gpio_port::E,
+ *                                       GPIO_PIN_9, GPIO_PIN_11, GPIO_PIN_13>;
+ * stepper_pins::write(0b011); // PE9、PE11 置高，PE13 置低，同时生效
+ * stepper_pins::reset();      // 全部置低
+ * @endcode
+ */
+template <gpio_port Port, uint16_t... Pins> class gpio_group {
+public:
+  static constexpr std::size_t size = sizeof...(Pins);
+  static constexpr std::array<uint16_t, size> pins{Pins...};
+  static constexpr uint16_t mask = (Pins | ...);
+  static constexpr uintptr_t port_base = get_gpio_port_base(Port);
+
+private:
+  static constexpr bool disjoint_single_pins() {
+    uint32_t seen = 0;
+    for (uint16_t pin : pins) {
+      if (!std::has_single_bit(pin) || (seen & pin) != 0U) {
+        return false;
+      }
+      seen |= pin;
+    }
+    return true;
+  }
+
+  static constexpr bool contiguous() {
+    for (std::size_t i = 1; i < size; ++i) {
+      if (pins[i] != static_cast<uint16_t>(pins[0] << i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static_assert(size >= 1 && size <= 16, "gpio_group takes 1 to 16 pins");
+  static_assert(port_base != 0, "invalid GPIO port");
+  static_assert(disjoint_single_pins(),
+                "Pins must be distinct single GPIO_PIN_x values");
+
+  static constexpr unsigned first_bit =
+      static_cast<unsigned>(std::countr_zero(pins[0]));
+
+public:
+  gpio_group() = delete;
+
+  static GPIO_TypeDef *port() noexcept {
+    return reinterpret_cast<GPIO_TypeDef *>(port_base);
+  }
+
+  /// value 的第 i 位对应 Pins 的第 i 个引脚，一次 BSRR 写入
+  static void write(uint32_t value) noexcept { write_raw(scatter(value)); }
+
+  /// bits 为端口位（GPIO_PIN_x 的组合），只影响组内引脚
+  static void write_raw(uint16_t bits) noexcept {
+    port()->BSRR = (static_cast<uint32_t>(~bits & mask) << 16U) |
+                   static_cast<uint32_t>(bits & mask);
+  }
+
+  static void set() noexcept { port()->BSRR = mask; }
+
+  static void reset() noexcept {
+    port()->BSRR = static_cast<uint32_t>(mask) << 16U;
+  }
+
+  static void toggle() noexcept {
+    const uint32_t odr = port()->ODR;
+    port()->BSRR = ((odr & mask) << 16U) | (~odr & mask);
   }
 
-  ~gpio_pin() {
-    HAL_GPIO_DeInit(get_gpio_port_ptr(tag_type::port),
-                    tag_type::init_struct.Pin);
+  /// 第 i 位为 Pins 第 i 个引脚的输入电平
+  [[nodiscard]] static uint32_t read() noexcept {
+    return gather(static_cast<uint16_t>(port()->IDR));
   }
 
-  void write(bool state) {
-    HAL_GPIO_WritePin(get_gpio_port_ptr(tag_type::port),
-                      tag_type::init_struct.Pin,
-                      static_cast<GPIO_PinState>(state));
+  [[nodiscard]] static uint16_t read_raw() noexcept {
+    return static_cast<uint16_t>(port()->IDR & mask);
   }
 
-  bool read() const noexcept {
-    return HAL_GPIO_ReadPin(get_gpio_port_ptr(tag_type::port),
-                            tag_type::init_struct.Pin);
+  /// 组内序号 → 端口位
+  [[nodiscard]] static constexpr uint16_t scatter(uint32_t value) noexcept {
+    if constexpr (contiguous()) {
+      return static_cast<uint16_t>((value << first_bit) & mask);
+    } else {
+      uint16_t bits = 0;
+      for (std::size_t i = 0; i < size; ++i) {
+        if ((value >> i) & 1U) {
+          bits |= pins[i];
+        }
+      }
+      return bits;
+    }
   }
 
-  void toggle() {
-    HAL_GPIO_TogglePin(get_gpio_port_ptr(tag_type::port),
-                       tag_type::init_struct.Pin);
+  /// 端口位 → 组内序号
+  [[nodiscard]] static constexpr uint32_t gather(uint16_t bits) noexcept {
+    if constexpr (contiguous()) {
+      return static_cast<uint32_t>(bits & mask) >> first_bit;
+    } else {
+      uint32_t value = 0;
+      for (std::size_t i = 0; i < size; ++i) {
+        if ((bits & pins[i]) != 0U) {
+          value |= 1U << i;
+        }
+      }
+      return value;
+    }
   }
 };
 
@@ -0,0 +1,257 @@
+#include "bsp_heap.hpp"
+
+#include "bsp_type_traits.hpp"
+#include "task.h"
+
+#include <algorithm>
+#include <limits>
+
+// 链接脚本：.ccmram 之后剩余的 CCM RAM
+extern "C" uint8_t _sccm_heap[];
+extern "C" uint8_t _eccm_heap[];
+
+namespace {
+
+// DMA 区域放在 .dma_buffer 段（主 SRAM，NOLOAD）
+GDUT_DMA_BUFFER uint8_t dma_heap[GDUT_HEAP_DMA_SIZE];
+
+constexpr std::size_t index_of(gdut::heap_region region) {
+  return static_cast<std::size_t>(region);
+}
+
+} // namespace
+
+namespace gdut {
+
+std::array<rtos_heap::region_state, rtos_heap::region_count>
+    rtos_heap::regions{};
+std::size_t rtos_heap::total_free = 0;
+std::size_t rtos_heap::min_total_free = 0;
+bool rtos_heap::initialized = false;
+
+void rtos_heap::init() noexcept {
+  init_region(regions[index_of(heap_region::fast)], _sccm_heap, _eccm_heap);
+  init_region(regions[index_of(heap_region::dma)], dma_heap,
+              dma_heap + sizeof(dma_heap));
+  min_total_free = total_free;
+  initialized = true;
+}
+
+void rtos_heap::init_region(region_state &r, uint8_t *begin,
+                            uint8_t *end) noexcept {
+  r.begin = begin;
+  r.end = end;
+  const auto bytes = static_cast<std::size_t>(end - begin);
+  // tlsf_create_with_pool 不检查内存池是否创建成功，这里先检查大小
+  if (bytes < tlsf_size() + tlsf_pool_overhead() + tlsf_block_size_min()) {
+    return;
+  }
+  r.tlsf = tlsf_create_with_pool(begin, bytes);
+  if (r.tlsf == nullptr) {
+    return;
+  }
+  // 空闲字节数按“块大小 + 块头”计，分配与释放时增减同样的量
+  tlsf_walk_pool(
+      tlsf_get_pool(r.tlsf),
+      [](void *, size_t size, int used, void *user) {
+        if (used == 0) {
+          *static_cast<std::size_t *>(user) += size + tlsf_alloc_overhead();
+        }
+      },
+      &r.free_bytes);
+  r.min_free_bytes = r.free_bytes;
+  total_free += r.free_bytes;
+}
+
+void *rtos_heap::allocate_from(region_state &r, std::size_t bytes) noexcept {
+  if (r.tlsf == nullptr) {
+    return nullptr;
+  }
+  void *p = tlsf_memalign(r.tlsf, alignment, bytes);
+  if (p == nullptr) {
+    ++r.failures;
+    return nullptr;
+  }
+  const std::size_t used = tlsf_block_size(p) + tlsf_alloc_overhead();
+  r.free_bytes -= used;
+  r.min_free_bytes = std::min(r.min_free_bytes, r.free_bytes);
+  total_free -= used;
+  min_total_free = std::min(min_total_free, total_free);
+  ++r.allocations;
+  return p;
+}
+
+void *rtos_heap::allocate(std::size_t bytes) noexcept {
+  if (bytes == 0) {
+    return nullptr;
+  }
+  vTaskSuspendAll();
+  if (!initialized) {
+    init();
+  }
+#if GDUT_HEAP_PREFER_FAST
+  void *p = allocate_from(regions[index_of(heap_region::fast)], bytes);
+  if (p == nullptr) {
+    p = allocate_from(regions[index_of(heap_region::dma)], bytes);
+  }
+#else
+  void *p = allocate_from(regions[index_of(heap_region::dma)], bytes);
+#endif
+  (void)xTaskResumeAll();
+  return p;
+}
+
+void *rtos_heap::allocate(std::size_t bytes, heap_region region) noexcept {
+  if (bytes == 0 || index_of(region) >= region_count) {
+    return nullptr;
+  }
+  vTaskSuspendAll();
+  if (!initialized) {
+    init();
+  }
+  void *p = allocate_from(regions[index_of(region)], bytes);
+  (void)xTaskResumeAll();
+  return p;
+}
+
+void rtos_heap::deallocate(void *p) noexcept {
+  if (p == nullptr) {
+    return;
+  }
+  vTaskSuspendAll();
+  region_state *r = find(p);
+  configASSERT(r != nullptr);
+  if (r != nullptr) {
+    const std::size_t used = tlsf_block_size(p) + tlsf_alloc_overhead();
+    tlsf_free(r->tlsf, p);
+    r->free_bytes += used;
+    total_free += used;
+    ++r->frees;
+  }
+  (void)xTaskResumeAll();
+}
+
+heap_region_stats rtos_heap::stats(heap_region region) noexcept {
+  if (index_of(region) >= region_count) {
+    return {};
+  }
+  heap_region_stats s{};
+  vTaskSuspendAll();
+  if (!initialized) {
+    init();
+  }
+  const region_state &r = regions[index_of(region)];
+  s.size = static_cast<uint32_t>(r.end - r.begin);
+  s.free_bytes = static_cast<uint32_t>(r.free_bytes);
+  s.min_free_bytes = static_cast<uint32_t>(r.min_free_bytes);
+  s.allocations = r.allocations;
+  s.frees = r.frees;
+  s.failures = r.failures;
+  if (r.tlsf != nullptr) {
+    tlsf_walk_pool(
+        tlsf_get_pool(r.tlsf),
+        [](void *, size_t size, int used, void *user) {
+          if (used == 0) {
+            auto *out = static_cast<heap_region_stats *>(user);
+            const auto bytes = static_cast<uint32_t>(size);
+            out->largest_free_block = std::max(out->largest_free_block, bytes);
+            out->smallest_free_block = out->free_blocks == 0U
+                                           ? bytes
+                                           : std::min(out->smallest_free_block,
+                                                      bytes);
+            ++out->free_blocks;
+          }
+        },
+        &s);
+  }
+  (void)xTaskResumeAll();
+  return s;
+}
+
+std::size_t rtos_heap::free_bytes() noexcept { return total_free; }
+
+std::size_t rtos_heap::min_free_bytes() noexcept { return min_total_free; }
+
+bool rtos_heap::region_of(const void *p, heap_region &region) noexcept {
+  const region_state *r = find(p);
+  if (r == nullptr) {
+    return false;
+  }
+  region = static_cast<heap_region>(r - regions.data());
+  return true;
+}
+
+rtos_heap::region_state *rtos_heap::find(const void *p) noexcept {
+  const auto *b = static_cast<const uint8_t *>(p);
+  for (region_state &r : regions) {
+    if (r.tlsf != nullptr && b >= r.begin && b < r.end) {
+      return &r;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace gdut
+
+// 强符号定义 FreeRTOS 堆接口，替换 heap_4.c
+extern "C" {
+
+void *pvPortMalloc(size_t xWantedSize) {
+  void *p = gdut::rtos_heap::allocate(xWantedSize);
+  traceMALLOC(p, xWantedSize);
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+  if (p == nullptr) {
+    extern void vApplicationMallocFailedHook(void);
+    vApplicationMallocFailedHook();
+  }
+#endif
+  return p;
+}
+
+void vPortFree(void *pv) {
+  if (pv != nullptr) {
+    traceFREE(pv, tlsf_block_size(pv));
+  }
+  gdut::rtos_heap::deallocate(pv);
+}
+
+void vPortInitialiseBlocks(void) {
+  // 首次分配时自动初始化
+}
+
+size_t xPortGetFreeHeapSize(void) { return gdut::rtos_heap::free_bytes(); }
+
+size_t xPortGetMinimumEverFreeHeapSize(void) {
+  return gdut::rtos_heap::min_free_bytes();
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats) {
+  size_t available = 0;
+  size_t largest = 0;
+  size_t smallest = std::numeric_limits<size_t>::max();
+  size_t blocks = 0;
+  size_t allocations = 0;
+  size_t frees = 0;
+  for (std::size_t i = 0; i < gdut::rtos_heap::region_count; ++i) {
+    const gdut::heap_region_stats s =
+        gdut::rtos_heap::stats(static_cast<gdut::heap_region>(i));
+    available += s.free_bytes;
+    largest = std::max<size_t>(largest, s.largest_free_block);
+    if (s.free_blocks != 0U) {
+      smallest = std::min<size_t>(smallest, s.smallest_free_block);
+    }
+    blocks += s.free_blocks;
+    allocations += s.allocations;
+    frees += s.frees;
+  }
+  pxHeapStats->xAvailableHeapSpaceInBytes = available;
+  pxHeapStats->xSizeOfLargestFreeBlockInBytes = largest;
+  pxHeapStats->xSizeOfSmallestFreeBlockInBytes = blocks == 0 ? 0 : smallest;
+  pxHeapStats->xNumberOfFreeBlocks = blocks;
+  pxHeapStats->xMinimumEverFreeBytesRemaining =
+      gdut::rtos_heap::min_free_bytes();
+  pxHeapStats->xNumberOfSuccessfulAllocations = allocations;
+  pxHeapStats->xNumberOfSuccessfulFrees = frees;
+}
+
+} // extern "C"
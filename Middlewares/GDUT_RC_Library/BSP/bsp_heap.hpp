@@ -0,0 +1,160 @@
+#ifndef BSP_HEAP_HPP
+#define BSP_HEAP_HPP
+
+#include "FreeRTOS.h"
+#include "tlsf.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// DMA 区域（主 SRAM）的字节数，默认沿用 CubeMX 的 configTOTAL_HEAP_SIZE
+#ifndef GDUT_HEAP_DMA_SIZE
+#define GDUT_HEAP_DMA_SIZE configTOTAL_HEAP_SIZE
+#endif
+
+/*
+ * ⚠️ pvPortMalloc 默认优先从 CCM RAM 分配，DMA 不能访问 CCM RAM：
+ * - osThreadNew 创建的任务栈在 CCM RAM 中，任务里的局部数组不能交给 DMA
+ * - portable_resource（以及以它为上游的资源）返回的内存不能作 DMA 缓冲区
+ * 这类地址会被 check_dma_buffer() 拒绝，Debug 构建
+ * （GDUT_DMA_BUFFER_CHECK_FATAL=1）直接 std::terminate()。
+ *
+ * DMA 缓冲区使用 rtos_heap::allocate(bytes, heap_region::dma)、
+ * pmr::heap_region_resource<heap_region::dma> 或 GDUT_DMA_BUFFER。
+ * 已有代码依赖栈上/堆上的 DMA 缓冲区时，定义 GDUT_HEAP_PREFER_FAST=0
+ * （CMake 选项 GDUT_HEAP_PREFER_FAST=OFF）：pvPortMalloc 只从主 SRAM
+ * 分配，行为与 heap_4 相同，CCM RAM 只经 heap_region::fast 显式使用。
+ */
+#ifndef GDUT_HEAP_PREFER_FAST
+#define GDUT_HEAP_PREFER_FAST 1
+#endif
+
+namespace gdut {
+
+/// FreeRTOS 堆的内存区域
+enum class heap_region : uint8_t {
+  fast = 0, ///< CCM RAM：CPU 零等待访问，DMA 不可访问
+  dma = 1,  ///< 主 SRAM：DMA 可访问
+};
+
+/// 一个堆区域的统计
+struct heap_region_stats {
+  uint32_t size{0};                // 区域总字节数（含 TLSF 控制结构）
+  uint32_t free_bytes{0};          // 当前空闲字节数（含空闲块的块头）
+  uint32_t min_free_bytes{0};      // free_bytes 的历史最小值
+  uint32_t largest_free_block{0};  // 最大空闲块（遍历区域得到）
+  uint32_t smallest_free_block{0}; // 最小空闲块（遍历区域得到）
+  uint32_t free_blocks{0};         // 空闲块个数（遍历区域得到）
+  uint32_t allocations{0};         // 成功分配次数
+  uint32_t frees{0};               // 释放次数
+  uint32_t failures{0};            // 本区域无法满足的分配次数
+};
+
+/**
+ * @brief 替换 heap_4.c 的多区域 TLSF FreeRTOS 堆
+ *
+ * heap_4 只管理主 SRAM 中 configTOTAL_HEAP_SIZE 字节的一块数组，分配时
+ * 线性首次适配遍历空闲链表；而 64 KB 的 CCM RAM 基本闲置。rtos_heap 以
+ * TLSF 管理两个区域，bsp_heap.cpp 以它实现 pvPortMalloc/vPortFree 等
+ * FreeRTOS 堆接口：
+ * - heap_region::fast：链接脚本中 .ccmram 之后剩余的全部 CCM RAM
+ * - heap_region::dma：.dma_buffer 段中 GDUT_HEAP_DMA_SIZE 字节的数组
+ *
+ * pvPortMalloc 先从 fast 区域分配，不足时回退到 dma 区域。任务栈与 TCB、
+ * 队列、信号量等内核对象因此默认位于 CCM RAM，主 SRAM 留给 DMA 缓冲区；
+ * 需要 DMA 可访问的内存时以 heap_region::dma 显式分配
+ * （或使用 pmr::heap_region_resource）。GDUT_HEAP_PREFER_FAST=0 时
+ * pvPortMalloc 只从 dma 区域分配（见文件开头的说明）。
+ *
+ * 特性：
+ * - 分配与释放为 O(1)，碎片远少于 heap_4 的首次适配
+ * - 每个区域独立的 TLSF 实例，按区域分配时不会落到另一个区域
+ * - 释放时按地址判断区域，调用者不需要记住区域
+ * - 首次分配时初始化，静态构造函数中也可以调用
+ *
+ * 线程安全：与 heap_4 相同，以 vTaskSuspendAll()/xTaskResumeAll() 保护，
+ * 可在任务中调用，不能在中断中调用。
+ *
+ * 重要约束：
+ * - 工程中不能再链接 heap_x.c（GDUT_RC_Library 的 CMake 会从 FreeRTOS
+ *   目标中移除 CubeMX 生成的 heap_4.c）
+ * - 每个区域约有 3 KB 的 TLSF 控制结构开销
+ * - pvPortMalloc/portable_resource 返回的内存与任务栈可能位于 CCM RAM，
+ *   不能作为 DMA 缓冲区（Debug 构建中 check_dma_buffer() 终止程序）
+ *
+ * 使用示例：
+ * @code
+ * // 内核对象与任务栈：照常创建，自动位于 CCM RAM
+ * osThreadNew(control_task, nullptr, &control_attr);
+ *
+ * // DMA 缓冲区：显式从主 SRAM 分配
+ * auto *rx = static_cast<uint8_t *>(
+ *     gdut::rtos_heap::allocate(256, gdut::heap_region::dma));
+ * uart_dma.receive(rx, 256);
+ *
+ * const gdut::heap_region_stats ccm =
+ *     gdut::rtos_heap::stats(gdut::heap_region::fast);
+ * @endcode
+ */
+class rtos_heap {
+public:
+  static constexpr std::size_t region_count = 2;
+  /// 所有分配的对齐（与 heap_4 相同）
+  static constexpr std::size_t alignment = portBYTE_ALIGNMENT;
+
+  rtos_heap() = delete;
+
+  /// pvPortMalloc 的分配策略：先 fast，不足时回退 dma；
+  /// GDUT_HEAP_PREFER_FAST=0 时只从 dma 分配
+  [[nodiscard]] static void *allocate(std::size_t bytes) noexcept;
+
+  /// 只从 region 分配，不足时返回 nullptr
+  [[nodiscard]] static void *allocate(std::size_t bytes,
+                                      heap_region region) noexcept;
+
+  /// 释放 allocate() 返回的内存；nullptr 被忽略，
+  /// 不属于堆的地址触发 configASSERT
+  static void deallocate(void *p) noexcept;
+
+  /// region 的统计；会遍历整个区域（O(块数)），只在查询时调用
+  [[nodiscard]] static heap_region_stats stats(heap_region region) noexcept;
+
+  /// 所有区域当前空闲字节数之和（O(1)）
+  [[nodiscard]] static std::size_t free_bytes() noexcept;
+
+  /// 所有区域空闲字节数之和的历史最小值（O(1)）
+  [[nodiscard]] static std::size_t min_free_bytes() noexcept;
+
+  /// 地址所属的区域；不属于堆时返回 false
+  [[nodiscard]] static bool region_of(const void *p,
+                                      heap_region &region) noexcept;
+
+private:
+  struct region_state {
+    tlsf_t tlsf{nullptr};
+    uint8_t *begin{nullptr};
+    uint8_t *end{nullptr};
+    std::size_t free_bytes{0};
+    std::size_t min_free_bytes{0};
+    uint32_t allocations{0};
+    uint32_t frees{0};
+    uint32_t failures{0};
+  };
+
+  static void init() noexcept;
+  static void init_region(region_state &r, uint8_t *begin,
+                          uint8_t *end) noexcept;
+  static void *allocate_from(region_state &r, std::size_t bytes) noexcept;
+  static region_state *find(const void *p) noexcept;
+
+  // 全部为常量初始化，首次分配可以早于 C++ 静态构造
+  static std::array<region_state, region_count> regions;
+  static std::size_t total_free;
+  static std::size_t min_total_free;
+  static bool initialized;
+};
+
+} // namespace gdut
+
+#endif // BSP_HEAP_HPP
@@ -0,0 +1,657 @@
+#include "bsp_i2c_bus.hpp"
+
+namespace gdut {
+
+i2c_bus *i2c_bus::instances[i2c_bus::bus_count] = {};
+
+i2c_bus::i2c_bus(I2C_HandleTypeDef *hi2c, dma_proxy *tx_dma,
+                 dma_proxy *rx_dma, const i2c_bus_pins &pins,
+                 timing_wheel *wheel)
+    : m_i2c(hi2c), m_tx_dma(tx_dma), m_rx_dma(rx_dma), m_pins(pins),
+      m_wheel(wheel) {
+  const uint8_t index =
+      hi2c != nullptr ? get_i2c_index(hi2c->Instance) : uint8_t{0xFF};
+  if (index >= bus_count || tx_dma == nullptr || rx_dma == nullptr ||
+      tx_dma->get_handle() == nullptr || rx_dma->get_handle() == nullptr) {
+    m_i2c = nullptr;
+    m_tx_dma = nullptr;
+    m_rx_dma = nullptr;
+    m_wheel = nullptr;
+    return;
+  }
+
+  // 一个 SCL 位周期（向上取整）：停止条件通常在一到两个位周期内发出
+  const uint32_t clock_speed = hi2c->Init.ClockSpeed;
+  if (clock_speed != 0U) {
+    m_stop_poll = std::chrono::microseconds(
+        (1000000U + clock_speed - 1U) / clock_speed);
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  instances[index] = this;
+  __set_PRIMASK(primask);
+}
+
+i2c_bus::~i2c_bus() noexcept {
+  if (!valid()) {
+    return;
+  }
+
+  // 先断开中断到本对象的所有路径：之后即使 DMA 数据流中断已挂起，
+  // HAL_DMA_IRQHandler 也只清除标志，不再回调本对象
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  m_state = bus_state::idle;
+  CLEAR_BIT(m_i2c->Instance->CR2, I2C_CR2_ITEVTEN | I2C_CR2_ITERREN |
+                                      I2C_CR2_ITBUFEN | I2C_CR2_DMAEN |
+                                      I2C_CR2_LAST);
+  for (dma_proxy *proxy : {m_tx_dma, m_rx_dma}) {
+    DMA_HandleTypeDef *hdma = proxy->get_handle();
+    if (hdma->Parent == this) {
+      hdma->XferCpltCallback = nullptr;
+      hdma->XferHalfCpltCallback = nullptr;
+      hdma->XferErrorCallback = nullptr;
+      hdma->Parent = nullptr;
+    }
+  }
+  const uint8_t index = get_i2c_index(m_i2c->Instance);
+  if (instances[index] == this) {
+    instances[index] = nullptr;
+  }
+  __set_PRIMASK(primask);
+
+  if (m_wheel != nullptr) {
+    (void)m_wheel->cancel(m_start_deadline);
+  }
+  // 中止仍在运行的数据流（HAL_DMA_Abort 等待 EN 清零并清除中断标志）
+  for (dma_proxy *proxy : {m_tx_dma, m_rx_dma}) {
+    DMA_HandleTypeDef *hdma = proxy->get_handle();
+    if (hdma->State == HAL_DMA_STATE_BUSY) {
+      (void)HAL_DMA_Abort(hdma);
+    }
+  }
+}
+
+i2c_bus *i2c_bus::find(I2C_TypeDef *instance) {
+  const uint8_t index = get_i2c_index(instance);
+  return index < bus_count ? instances[index] : nullptr;
+}
+
+bool i2c_bus::valid_block(const i2c_read_block &block) {
+  return block.address <= 0x7FU && block.mem_size <= i2c_mem_size::size_16bit &&
+         !block.buffer.empty() && block.buffer.size() <= 0xFFFFU &&
+         check_dma_buffer(block.buffer.data());
+}
+
+bool i2c_bus::submit(i2c_transaction &&transaction) {
+  if (!valid()) {
+    return false;
+  }
+  if (!transaction.batch.empty()) {
+    for (const i2c_read_block &block : transaction.batch) {
+      if (!valid_block(block)) {
+        return false;
+      }
+    }
+  } else {
+    // NDTR 为 16 位，7 位地址最大 0x7F
+    if (transaction.address > 0x7FU ||
+        transaction.mem_size > i2c_mem_size::size_16bit ||
+        transaction.write.size() > 0xFFFFU ||
+        transaction.read.size() > 0xFFFFU) {
+      return false;
+    }
+    if ((!transaction.write.empty() &&
+         !check_dma_buffer(transaction.write.data())) ||
+        (!transaction.read.empty() &&
+         !check_dma_buffer(transaction.read.data()))) {
+      return false;
+    }
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (m_count >= queue_depth) {
+    __set_PRIMASK(primask);
+    return false;
+  }
+  m_queue[(m_head + m_count) % queue_depth] = std::move(transaction);
+  m_count = m_count + 1U;
+  // 队列由空变为非空时由提交者启动；否则由上一个事务完成时接力启动
+  const bool start = m_count == 1U && !m_recovery_needed;
+  __set_PRIMASK(primask);
+
+  if (start) {
+    start_current();
+  } else {
+    poll_stop_pending();
+  }
+  return true;
+}
+
+std::error_code i2c_bus::transfer(i2c_transaction &&transaction) {
+  struct wait_state {
+    std::error_code result;
+    osThreadId_t waiter;
+  } state{{}, osThreadGetId()};
+
+  transaction.callback = [&state](std::error_code ec) {
+    state.result = ec;
+    (void)osThreadFlagsSet(state.waiter, wait_flag);
+  };
+  (void)osThreadFlagsClear(wait_flag);
+  if (!submit(std::move(transaction))) {
+    return std::make_error_code(std::errc::resource_unavailable_try_again);
+  }
+
+  // 每个节拍驱动一次 service()：推迟的起始条件得以发出，
+  // 卡死的事务最终以 timeout 完成
+  while ((osThreadFlagsWait(wait_flag, osFlagsWaitAny, 1U) & osFlagsError) !=
+         0U) {
+    service();
+  }
+  return state.result;
+}
+
+void i2c_bus::service() {
+  if (!valid()) {
+    return;
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const bool stop_pending = m_state == bus_state::stop_pending;
+  if (stop_pending && !try_begin()) {
+    arm_start_timer();
+  }
+  const bool timed_out =
+      m_state != bus_state::idle &&
+      osKernelGetTickCount() - m_started_tick > m_timeout_ticks;
+  if (timed_out) {
+    // 先切断所有中断源，之后 finish() 可在临界区外安全执行
+    CLEAR_BIT(m_i2c->Instance->CR2,
+              I2C_CR2_ITEVTEN | I2C_CR2_ITERREN | I2C_CR2_ITBUFEN);
+    abort_dma();
+    m_state = bus_state::idle;
+    m_recovery_needed = true;
+  }
+  __set_PRIMASK(primask);
+
+  if (timed_out) {
+    // 停止条件一直没有发出或总线一直被占用
+    finish(stop_pending ? i2c_error_code::bus_busy : i2c_error_code::timeout);
+  }
+
+  if (!m_recovery_needed) {
+    return;
+  }
+
+  (void)recover();
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  m_recovery_needed = false;
+  const bool next = m_count != 0U && m_state == bus_state::idle;
+  __set_PRIMASK(primask);
+
+  if (next) {
+    start_current();
+  }
+}
+
+bool i2c_bus::recover() {
+  if (!valid()) {
+    return false;
+  }
+
+  GPIO_TypeDef *scl_port = get_gpio_port_ptr(m_pins.scl_port);
+  GPIO_TypeDef *sda_port = get_gpio_port_ptr(m_pins.sda_port);
+
+  __HAL_I2C_DISABLE(m_i2c);
+  configure_pins_gpio();
+  half_bit_delay();
+
+  // 从机最多还剩 8 个数据位 + 1 个应答位，9 个时钟内必然释放 SDA
+  for (uint32_t i = 0; i < 9U && HAL_GPIO_ReadPin(sda_port, m_pins.sda_pin) ==
+                                     GPIO_PIN_RESET;
+       ++i) {
+    HAL_GPIO_WritePin(scl_port, m_pins.scl_pin, GPIO_PIN_RESET);
+    half_bit_delay();
+    HAL_GPIO_WritePin(scl_port, m_pins.scl_pin, GPIO_PIN_SET);
+    half_bit_delay();
+  }
+
+  // 手动产生停止条件：SCL 高电平期间 SDA 由低变高
+  HAL_GPIO_WritePin(scl_port, m_pins.scl_pin, GPIO_PIN_RESET);
+  half_bit_delay();
+  HAL_GPIO_WritePin(sda_port, m_pins.sda_pin, GPIO_PIN_RESET);
+  half_bit_delay();
+  HAL_GPIO_WritePin(scl_port, m_pins.scl_pin, GPIO_PIN_SET);
+  half_bit_delay();
+  HAL_GPIO_WritePin(sda_port, m_pins.sda_pin, GPIO_PIN_SET);
+  half_bit_delay();
+
+  const bool released =
+      HAL_GPIO_ReadPin(sda_port, m_pins.sda_pin) == GPIO_PIN_SET;
+
+  configure_pins_af();
+  // 句柄状态非 RESET 时 HAL_I2C_Init 不会再调用 MspInit，只做软件复位
+  // 与寄存器重新配置
+  (void)HAL_I2C_Init(m_i2c);
+  return released;
+}
+
+void i2c_bus::event_irq_handler() {
+  I2C_TypeDef *i2c = m_i2c->Instance;
+  const uint32_t sr1 = i2c->SR1;
+
+  switch (m_state) {
+  case bus_state::start: {
+    if ((sr1 & I2C_SR1_SB) == 0U) {
+      return;
+    }
+    const segment &seg = m_segment;
+    const auto data_register = reinterpret_cast<uint32_t>(&i2c->DR);
+    HAL_StatusTypeDef status = HAL_OK;
+    if (m_reading) {
+      // 多字节读由 LAST 让硬件在 DMA 最后一次传输时自动回 NACK
+      if (seg.read.size() > 1U) {
+        SET_BIT(i2c->CR2, I2C_CR2_LAST);
+      } else {
+        CLEAR_BIT(i2c->CR2, I2C_CR2_LAST);
+      }
+      status = m_rx_dma->launch(data_register,
+                                reinterpret_cast<uint32_t>(seg.read.data()),
+                                seg.read.size());
+    } else if (!seg.write.empty()) {
+      status = m_tx_dma->launch(reinterpret_cast<uint32_t>(seg.write.data()),
+                                data_register, seg.write.size());
+    }
+    if (status != HAL_OK) {
+      // 起始条件已发出，不发送地址直接产生停止条件
+      SET_BIT(i2c->CR1, I2C_CR1_STOP);
+      finish(i2c_error_code::dma_error);
+      return;
+    }
+    // 有寄存器地址时，DMA 请求推迟到寄存器地址写完后再使能
+    if (m_reading || (!seg.write.empty() && seg.mem_size == 0U)) {
+      SET_BIT(i2c->CR2, I2C_CR2_DMAEN);
+    }
+    // 读 SR1 后写 DR 清除 SB
+    i2c->DR = static_cast<uint8_t>(seg.address << 1U) | (m_reading ? 1U : 0U);
+    m_state = bus_state::address;
+    return;
+  }
+
+  case bus_state::address: {
+    if ((sr1 & I2C_SR1_ADDR) == 0U) {
+      return;
+    }
+    if (m_reading) {
+      if (m_segment.read.size() == 1U) {
+        // 单字节读：必须在清除 ADDR 前关闭 ACK，清除后立即请求停止
+        CLEAR_BIT(i2c->CR1, I2C_CR1_ACK);
+        __HAL_I2C_CLEAR_ADDRFLAG(m_i2c);
+        SET_BIT(i2c->CR1, I2C_CR1_STOP);
+      } else {
+        SET_BIT(i2c->CR1, I2C_CR1_ACK);
+        __HAL_I2C_CLEAR_ADDRFLAG(m_i2c);
+      }
+      m_state = bus_state::read_data;
+      return;
+    }
+    __HAL_I2C_CLEAR_ADDRFLAG(m_i2c);
+    if (m_segment.mem_size != 0U) {
+      // 清除 ADDR 后 TXE 立即置位，由 TXE 中断逐字节写入寄存器地址
+      m_state = bus_state::write_register;
+      SET_BIT(i2c->CR2, I2C_CR2_ITBUFEN);
+      return;
+    }
+    if (m_segment.write.empty()) {
+      // 地址探测：收到应答即完成
+      SET_BIT(i2c->CR1, I2C_CR1_STOP);
+      finish({});
+      return;
+    }
+    m_state = bus_state::write_data;
+    return;
+  }
+
+  case bus_state::write_register: {
+    if ((sr1 & I2C_SR1_TXE) == 0U) {
+      return;
+    }
+    // 高字节在前
+    const uint32_t shift = 8U * (m_segment.mem_size - m_register_sent - 1U);
+    i2c->DR = static_cast<uint8_t>(m_segment.mem_address >> shift);
+    m_register_sent = m_register_sent + 1U;
+    if (m_register_sent < m_segment.mem_size) {
+      return;
+    }
+    CLEAR_BIT(i2c->CR2, I2C_CR2_ITBUFEN);
+    if (!m_segment.write.empty()) {
+      SET_BIT(i2c->CR2, I2C_CR2_DMAEN);
+      m_state = bus_state::write_data;
+    } else {
+      m_state = bus_state::write_last;
+    }
+    return;
+  }
+
+  case bus_state::write_data:
+    // DMA 已写完全部数据（NDTR 为 0）但完成中断尚未执行：直接推进，
+    // 避免 BTF 在事件中断中反复触发而 DMA 中断得不到执行
+    if ((sr1 & I2C_SR1_BTF) != 0U &&
+        m_tx_dma->get_handle()->Instance->NDTR == 0U) {
+      on_write_done();
+    }
+    return;
+
+  case bus_state::write_last:
+    if ((sr1 & I2C_SR1_BTF) != 0U) {
+      on_write_done();
+    }
+    return;
+
+  default:
+    return;
+  }
+}
+
+void i2c_bus::error_irq_handler() {
+  I2C_TypeDef *i2c = m_i2c->Instance;
+  const uint32_t sr1 = i2c->SR1;
+  const uint32_t error_flags =
+      sr1 & (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR);
+  if (error_flags == 0U) {
+    return;
+  }
+  // 错误标志为写 0 清除
+  i2c->SR1 = ~error_flags & 0xFFFFU;
+
+  i2c_error_code error;
+  if ((error_flags & I2C_SR1_BERR) != 0U) {
+    error = i2c_error_code::bus_error;
+    m_recovery_needed = true;
+  } else if ((error_flags & I2C_SR1_ARLO) != 0U) {
+    // 仲裁失败后硬件已自动退回从机模式，不能再发停止条件
+    error = i2c_error_code::arbitration_lost;
+  } else if ((error_flags & I2C_SR1_AF) != 0U) {
+    error = i2c_error_code::nack;
+    SET_BIT(i2c->CR1, I2C_CR1_STOP);
+  } else {
+    error = i2c_error_code::overrun;
+    SET_BIT(i2c->CR1, I2C_CR1_STOP);
+  }
+
+  if (m_state == bus_state::idle) {
+    return;
+  }
+  abort_dma();
+  finish(error);
+}
+
+void i2c_bus::start_current() {
+  if (!m_tx_dma->prepare() || !m_rx_dma->prepare()) {
+    if (m_restart) {
+      // 上一个事务留下的总线占用须以停止条件释放
+      m_restart = false;
+      SET_BIT(m_i2c->Instance->CR1, I2C_CR1_STOP);
+    }
+    finish(i2c_error_code::dma_error);
+    return;
+  }
+
+  DMA_HandleTypeDef *tx = m_tx_dma->get_handle();
+  DMA_HandleTypeDef *rx = m_rx_dma->get_handle();
+  tx->Parent = this;
+  tx->XferCpltCallback = tx_dma_cplt_cb;
+  tx->XferHalfCpltCallback = nullptr;
+  tx->XferErrorCallback = dma_error_cb;
+  rx->Parent = this;
+  rx->XferCpltCallback = rx_dma_cplt_cb;
+  rx->XferHalfCpltCallback = nullptr;
+  rx->XferErrorCallback = dma_error_cb;
+
+  m_batch_index = 0;
+  load_segment();
+  start_segment();
+}
+
+void i2c_bus::start_segment() {
+  // 与任务中的 poll_stop_pending() 互斥，起始条件只发一次
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (m_restart) {
+    // 总线仍由本机占用，不需要等待停止条件
+    m_restart = false;
+    begin_phase(m_segment.read_only());
+  } else {
+    // 停止条件通常尚未发出：不在中断中等待，由定时点稍后再检查
+    m_state = bus_state::stop_pending;
+    m_started_tick = osKernelGetTickCount();
+    if (!try_begin()) {
+      arm_start_timer();
+    }
+  }
+  __set_PRIMASK(primask);
+}
+
+bool i2c_bus::try_begin() {
+  if ((m_i2c->Instance->CR1 & I2C_CR1_STOP) != 0U ||
+      __HAL_I2C_GET_FLAG(m_i2c, I2C_FLAG_BUSY) != RESET) {
+    return false;
+  }
+  begin_phase(m_segment.read_only());
+  return true;
+}
+
+void i2c_bus::poll_stop_pending() {
+  // 在任务、中断或 m_start_deadline 的定时器中断中调用
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (m_state == bus_state::stop_pending && !try_begin()) {
+    arm_start_timer();
+  }
+  __set_PRIMASK(primask);
+}
+
+void i2c_bus::arm_start_timer() {
+  // 超时后不再轮询，由 service() 以 bus_busy 结束并恢复总线
+  if (m_wheel == nullptr ||
+      osKernelGetTickCount() - m_started_tick > m_timeout_ticks) {
+    return;
+  }
+  (void)m_wheel->arm(m_start_deadline, m_stop_poll);
+}
+
+void i2c_bus::load_segment() {
+  const i2c_transaction &transaction = current();
+  if (transaction.batch.empty()) {
+    m_segment = {transaction.address, transaction.mem_address,
+                 static_cast<uint8_t>(transaction.mem_size), transaction.write,
+                 transaction.read};
+    return;
+  }
+  const i2c_read_block &block = transaction.batch[m_batch_index];
+  m_segment = {block.address, block.mem_address,
+               static_cast<uint8_t>(block.mem_size), {}, block.buffer};
+}
+
+bool i2c_bus::next_segment() {
+  if (m_batch_index + 1U >= current().batch.size()) {
+    return false;
+  }
+  m_batch_index = m_batch_index + 1U;
+  load_segment();
+  return true;
+}
+
+void i2c_bus::begin_phase(bool reading) {
+  I2C_TypeDef *i2c = m_i2c->Instance;
+  m_reading = reading;
+  m_register_sent = 0;
+  m_state = bus_state::start;
+  // 超时按阶段计时，批量读的总时长不受单个超时限制
+  m_started_tick = osKernelGetTickCount();
+  if ((i2c->CR1 & I2C_CR1_PE) == 0U) {
+    __HAL_I2C_ENABLE(m_i2c);
+  }
+  CLEAR_BIT(i2c->CR1, I2C_CR1_POS);
+  SET_BIT(i2c->CR2, I2C_CR2_ITEVTEN | I2C_CR2_ITERREN);
+  SET_BIT(i2c->CR1, I2C_CR1_START);
+}
+
+void i2c_bus::on_write_done() {
+  CLEAR_BIT(m_i2c->Instance->CR2, I2C_CR2_DMAEN);
+  if (!m_segment.read.empty()) {
+    // 重复起始条件进入读阶段，BTF 在起始条件发出后由硬件清除
+    begin_phase(true);
+    return;
+  }
+  SET_BIT(m_i2c->Instance->CR1, I2C_CR1_STOP);
+  finish({});
+}
+
+void i2c_bus::finish(std::error_code ec) {
+  CLEAR_BIT(m_i2c->Instance->CR2, I2C_CR2_ITEVTEN | I2C_CR2_ITERREN |
+                                      I2C_CR2_ITBUFEN | I2C_CR2_DMAEN |
+                                      I2C_CR2_LAST);
+  m_state = bus_state::idle;
+
+  callback_t callback = std::move(current().callback);
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  m_head = (m_head + 1U) % queue_depth;
+  m_count = m_count - 1U;
+  const bool next = m_count != 0U && !m_recovery_needed;
+  __set_PRIMASK(primask);
+
+  // 回调中可以再次提交；队列为空时由该次提交自行启动
+  if (callback) {
+    callback(ec);
+  }
+  if (next) {
+    start_current();
+  }
+}
+
+void i2c_bus::abort_dma() {
+  CLEAR_BIT(m_i2c->Instance->CR2, I2C_CR2_DMAEN | I2C_CR2_LAST);
+  for (dma_proxy *proxy : {m_tx_dma, m_rx_dma}) {
+    DMA_HandleTypeDef *hdma = proxy->get_handle();
+    if (hdma->State == HAL_DMA_STATE_BUSY) {
+      (void)HAL_DMA_Abort_IT(hdma);
+    }
+  }
+}
+
+void i2c_bus::configure_pins_gpio() {
+  GPIO_TypeDef *scl_port = get_gpio_port_ptr(m_pins.scl_port);
+  GPIO_TypeDef *sda_port = get_gpio_port_ptr(m_pins.sda_port);
+
+  // 先把输出锁存器置高，切换模式时不会在总线上产生低脉冲
+  HAL_GPIO_WritePin(scl_port, m_pins.scl_pin, GPIO_PIN_SET);
+  HAL_GPIO_WritePin(sda_port, m_pins.sda_pin, GPIO_PIN_SET);
+
+  GPIO_InitTypeDef init{};
+  init.Mode = GPIO_MODE_OUTPUT_OD;
+  init.Pull = GPIO_PULLUP;
+  init.Speed = GPIO_SPEED_FREQ_HIGH;
+  init.Pin = m_pins.scl_pin;
+  HAL_GPIO_Init(scl_port, &init);
+  init.Pin = m_pins.sda_pin;
+  HAL_GPIO_Init(sda_port, &init);
+}
+
+void i2c_bus::configure_pins_af() {
+  GPIO_InitTypeDef init{};
+  init.Mode = GPIO_MODE_AF_OD;
+  init.Pull = GPIO_PULLUP;
+  init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  init.Alternate = m_pins.alternate;
+  init.Pin = m_pins.scl_pin;
+  HAL_GPIO_Init(get_gpio_port_ptr(m_pins.scl_port), &init);
+  init.Pin = m_pins.sda_pin;
+  HAL_GPIO_Init(get_gpio_port_ptr(m_pins.sda_port), &init);
+}
+
+void i2c_bus::half_bit_delay() const {
+  // 100 kHz 半个位周期 5 µs，每次迭代按 4 个周期估算
+  for (uint32_t n = SystemCoreClock / 200000U / 4U; n != 0U; --n) {
+    __NOP();
+  }
+}
+
+void i2c_bus::tx_dma_cplt_cb(DMA_HandleTypeDef *hdma) {
+  auto *self = static_cast<i2c_bus *>(hdma->Parent);
+  if (self == nullptr || self->m_state != bus_state::write_data) {
+    return;
+  }
+  // DMA 写完只代表最后一字节进入 DR，需等待 BTF 确认其已移出
+  CLEAR_BIT(self->m_i2c->Instance->CR2, I2C_CR2_DMAEN);
+  self->m_state = bus_state::write_last;
+}
+
+void i2c_bus::rx_dma_cplt_cb(DMA_HandleTypeDef *hdma) {
+  auto *self = static_cast<i2c_bus *>(hdma->Parent);
+  if (self == nullptr || self->m_state != bus_state::read_data) {
+    return;
+  }
+  I2C_TypeDef *i2c = self->m_i2c->Instance;
+  CLEAR_BIT(i2c->CR2, I2C_CR2_DMAEN | I2C_CR2_LAST);
+  // 单字节读的停止条件已在地址阶段请求
+  const bool stop_requested = self->m_segment.read.size() == 1U;
+  if (self->next_segment()) {
+    // 批量读：多字节块以重复起始条件直接衔接下一块
+    if (stop_requested) {
+      self->start_segment();
+    } else {
+      self->begin_phase(self->m_segment.read_only());
+    }
+    return;
+  }
+  if (!stop_requested) {
+    if (self->m_count > 1U && !self->m_recovery_needed) {
+      // 队列中还有事务：不发停止条件，由 start_segment() 以重复起始条件
+      // 衔接，中断中无需等待停止条件发出。写事务之后仍发停止条件，
+      // 部分从机（如 EEPROM）以停止条件开始内部写入
+      self->m_restart = true;
+    } else {
+      SET_BIT(i2c->CR1, I2C_CR1_STOP);
+    }
+  }
+  self->finish({});
+}
+
+void i2c_bus::dma_error_cb(DMA_HandleTypeDef *hdma) {
+  auto *self = static_cast<i2c_bus *>(hdma->Parent);
+  if (self == nullptr || self->m_state == bus_state::idle) {
+    return;
+  }
+  self->abort_dma();
+  SET_BIT(self->m_i2c->Instance->CR1, I2C_CR1_STOP);
+  self->finish(i2c_error_code::dma_error);
+}
+
+} // namespace gdut
+
+extern "C" bool gdut_i2c_event_irq_handler(I2C_TypeDef *instance) {
+  gdut::i2c_bus *bus = gdut::i2c_bus::find(instance);
+  if (bus == nullptr) {
+    return false;
+  }
+  bus->event_irq_handler();
+  return true;
+}
+
+extern "C" bool gdut_i2c_error_irq_handler(I2C_TypeDef *instance) {
+  gdut::i2c_bus *bus = gdut::i2c_bus::find(instance);
+  if (bus == nullptr) {
+    return false;
+  }
+  bus->error_irq_handler();
+  return true;
+}
@@ -0,0 +1,418 @@
+#ifndef BSP_I2C_BUS_HPP
+#define BSP_I2C_BUS_HPP
+
+#include "bsp_dma.hpp"
+#include "bsp_function.hpp"
+#include "bsp_timing_wheel.hpp"
+#include "bsp_type_traits.hpp"
+#include "bsp_uncopyable.hpp"
+#include "cmsis_os2.h"
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_hal_i2c.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+
+namespace gdut {
+
+/**
+ * @brief I2C 总线管理器错误码
+ */
+enum class i2c_error_code : uint32_t {
+  none = 0,
+  nack,             ///< 从机未应答（地址或数据字节）
+  arbitration_lost, ///< 多主机仲裁失败
+  bus_error,        ///< 总线错误（非法起始/停止条件）
+  overrun,          ///< 上溢/下溢
+  timeout,          ///< 事务超时（从机长时间拉低 SCL 等）
+  bus_busy,         ///< 启动事务时总线被占用，需要总线恢复
+  dma_error         ///< DMA 启动失败或传输错误
+};
+
+/**
+ * @brief i2c_error_code 的 std::error_category 实现
+ */
+class i2c_error_category : public std::error_category {
+public:
+  constexpr i2c_error_category() noexcept = default;
+
+  const char *name() const noexcept override { return "i2c_error_code"; }
+
+  std::string message(int ev) const override {
+    switch (static_cast<i2c_error_code>(ev)) {
+    case i2c_error_code::none:
+      return "No error";
+    case i2c_error_code::nack:
+      return "Acknowledge failure";
+    case i2c_error_code::arbitration_lost:
+      return "Arbitration lost";
+    case i2c_error_code::bus_error:
+      return "Bus error";
+    case i2c_error_code::overrun:
+      return "Overrun/underrun";
+    case i2c_error_code::timeout:
+      return "Transaction timeout";
+    case i2c_error_code::bus_busy:
+      return "Bus busy";
+    case i2c_error_code::dma_error:
+      return "DMA error";
+    default:
+      return "Unknown error";
+    }
+  }
+
+  static const i2c_error_category &instance() {
+    static i2c_error_category instance;
+    return instance;
+  }
+};
+
+inline std::error_code make_error_code(i2c_error_code e) {
+  return {static_cast<int>(e), i2c_error_category::instance()};
+}
+
+} // namespace gdut
+
+namespace std {
+
+/// 启用 gdut::i2c_error_code 到 std::error_code 的隐式转换
+template <> struct is_error_code_enum<gdut::i2c_error_code> : true_type {};
+
+} // namespace std
+
+namespace gdut {
+
+/**
+ * @brief 总线恢复所需的 SCL/SDA 引脚信息
+ *
+ * 恢复时两根线临时切换为 GPIO 开漏输出，结束后恢复为复用开漏（@p alternate
+ * 为 GPIO_AFx_I2Cy）。
+ */
+struct i2c_bus_pins {
+  gpio_port scl_port;
+  uint16_t scl_pin;
+  gpio_port sda_port;
+  uint16_t sda_pin;
+  uint32_t alternate;
+};
+
+/**
+ * @brief 从机寄存器（存储器）地址宽度
+ *
+ * 枚举值即地址字节数；16 位地址高字节在前（与 HAL I2C_MEMADD_SIZE_16BIT
+ * 一致）。
+ */
+enum class i2c_mem_size : uint8_t {
+  none = 0,       ///< 无寄存器地址
+  size_8bit = 1,  ///< 8 位寄存器地址（多数传感器）
+  size_16bit = 2  ///< 16 位存储器地址（24Cxx EEPROM 等）
+};
+
+/**
+ * @brief 批量读中的一个寄存器块：从 address 设备的 mem_address 处读 buffer
+ */
+struct i2c_read_block {
+  uint16_t address{0}; ///< 7 位从机地址
+  uint16_t mem_address{0};
+  i2c_mem_size mem_size{i2c_mem_size::size_8bit};
+  std::span<uint8_t> buffer{};
+};
+
+/**
+ * @brief 一次 I2C 事务：先写寄存器地址与 write，再以重复起始条件读 read
+ *
+ * - write 非空、read 为空：纯写
+ * - write 为空、read 非空：纯读
+ * - 两者都非空：写后重复起始再读
+ * - 两者都为空：地址探测（只发送地址，检查应答）
+ *
+ * mem_size 不为 none 时，地址之后先发送 mem_address（由 CPU 写入 DR，
+ * 调用方无需为寄存器地址准备 DMA 缓冲区），再发送 write / 读取 read。
+ *
+ * batch 非空时为批量读：依次读取每个寄存器块，块之间以重复起始条件衔接，
+ * 全部完成或出错时只调用一次 callback；此时 address/write/read/mem_*
+ * 字段被忽略。
+ */
+struct i2c_transaction {
+  uint16_t address{0}; ///< 7 位从机地址
+  std::span<const uint8_t> write{};
+  std::span<uint8_t> read{};
+  function<void(std::error_code)> callback{};
+  uint16_t mem_address{0};
+  i2c_mem_size mem_size{i2c_mem_size::none};
+  std::span<const i2c_read_block> batch{};
+};
+
+/**
+ * @brief 非阻塞 I2C 总线管理器（主机模式，DMA + 中断驱动）
+ *
+ * 维护一个固定深度的事务队列，每个事务由 I2C 事件/错误中断和 DMA 完成中断
+ * 驱动的状态机执行：起始条件 → 地址 → 寄存器地址 → DMA 写 → 重复起始 →
+ * 地址 → DMA 读 → 停止条件。多字节读结束且队列中还有事务时，不发停止条件，
+ * 在中断中直接以重复起始条件启动下一个，同一总线上的多个传感器无需任务
+ * 参与即可背靠背轮询。
+ *
+ * 特性：
+ * - submit()/write()/read()/write_read()/mem_read()/mem_write()/read_batch()
+ *   可在任务或中断中调用，入队后立即返回
+ * - transfer() 为阻塞版本，调用任务在线程标志上等待
+ * - 中断中没有任何忙等：起始条件之前若上一个停止条件尚未发出
+ *   （CR1.STOP 未清除）或总线忙，事务进入 stop_pending 状态，
+ *   由 timing_wheel 上的一次性定时点每个 SCL 位周期检查一次，
+ *   就绪后在定时器中断中发起始条件，整个队列无需任务参与；
+ *   未提供 timing_wheel 时改由下一次 service() 或 submit() 检查。
+ *   超时仍未就绪按 bus_busy 失败并恢复总线
+ * - 事务超时与总线恢复在 service() 中处理：超时事务以 timeout 失败，
+ *   随后通过 SCL 手动时钟（最多 9 个脉冲 + 停止条件）释放被从机拉低的 SDA，
+ *   再软件复位并重新初始化 I2C
+ *
+ * 线程安全：
+ * - 队列由关中断临界区保护，可从多个任务和中断并发提交
+ * - service()/recover() 只能在任务上下文调用（恢复过程包含微秒级延时）
+ *
+ * 重要约束：
+ * - I2C 事件/错误中断须转发给本类（见 gdut_i2c_event_irq_handler()），
+ *   不能再调用 HAL_I2C_EV_IRQHandler / HAL_I2C_ER_IRQHandler
+ * - 读写缓冲区在事务完成前必须保持有效，且不能位于 CCMRAM
+ * - 回调在中断上下文执行，禁止阻塞
+ * - I2C 事件/错误中断与两个 DMA 数据流中断须配置为相同的抢占优先级，
+ *   状态机依赖它们互不抢占
+ *
+ * 使用示例：
+ * @code
+ * gdut::dma_proxy i2c_tx(&hdma_i2c1_tx);
+ * gdut::dma_proxy i2c_rx(&hdma_i2c1_rx);
+ * gdut::i2c_bus bus(&hi2c1, &i2c_tx, &i2c_rx,
+ *                   {gdut::gpio_port::B, GPIO_PIN_6, gdut::gpio_port::B,
+ *                    GPIO_PIN_7, GPIO_AF4_I2C1},
+ *                   &wheel); // 停止条件之后的起始由 wheel 的中断发出
+ *
+ * static uint8_t mag[6];
+ * bus.mem_read(0x1E, 0x03, gdut::i2c_mem_size::size_8bit, mag,
+ *              [](std::error_code ec) {
+ *                  if (!ec) { publish_mag(mag); }
+ *              });
+ * @endcode
+ */
+class i2c_bus : uncopyable {
+public:
+  using callback_t = function<void(std::error_code)>;
+
+  static constexpr std::size_t queue_depth = 8;
+  static constexpr std::size_t bus_count = 3;
+  /// transfer() 等待完成时使用的线程标志位
+  static constexpr uint32_t wait_flag = 0x00400000U;
+  static constexpr std::chrono::milliseconds default_timeout{10};
+
+  /**
+   * @param wheel 用于推迟的起始条件的时间轮（已 start()）；为 nullptr 时
+   *              推迟的起始条件只能由 service()/submit() 发出
+   */
+  i2c_bus(I2C_HandleTypeDef *hi2c, dma_proxy *tx_dma, dma_proxy *rx_dma,
+          const i2c_bus_pins &pins, timing_wheel *wheel = nullptr);
+  ~i2c_bus() noexcept;
+
+  [[nodiscard]] bool valid() const noexcept {
+    return m_i2c != nullptr && m_tx_dma != nullptr && m_rx_dma != nullptr;
+  }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /**
+   * @brief 提交一个事务。
+   * @return 入队成功返回 true；队列已满或参数非法返回 false（不调用回调）
+   */
+  bool submit(i2c_transaction &&transaction);
+
+  bool write(uint16_t address, std::span<const uint8_t> data,
+             callback_t &&callback = {}) {
+    return submit({address, data, {}, std::move(callback)});
+  }
+
+  bool read(uint16_t address, std::span<uint8_t> buffer,
+            callback_t &&callback = {}) {
+    return submit({address, {}, buffer, std::move(callback)});
+  }
+
+  bool write_read(uint16_t address, std::span<const uint8_t> data,
+                  std::span<uint8_t> buffer, callback_t &&callback = {}) {
+    return submit({address, data, buffer, std::move(callback)});
+  }
+
+  /**
+   * @brief 寄存器写：地址 → mem_address → data → 停止条件
+   */
+  bool mem_write(uint16_t address, uint16_t mem_address,
+                 i2c_mem_size mem_size, std::span<const uint8_t> data,
+                 callback_t &&callback = {}) {
+    return submit({address, data, {}, std::move(callback), mem_address,
+                   mem_size});
+  }
+
+  /**
+   * @brief 寄存器读：地址 → mem_address → 重复起始 → 地址 → buffer
+   */
+  bool mem_read(uint16_t address, uint16_t mem_address, i2c_mem_size mem_size,
+                std::span<uint8_t> buffer, callback_t &&callback = {}) {
+    return submit({address, {}, buffer, std::move(callback), mem_address,
+                   mem_size});
+  }
+
+  /**
+   * @brief 批量寄存器读，作为一个事务执行，完成后只回调一次。
+   *
+   * 一次传感器轮询（多个设备、多个寄存器块）只产生一次完成通知，
+   * 而不是每个块唤醒一次任务。blocks 数组本身与各块缓冲区在回调前
+   * 必须保持有效；出错时立即停止并以该错误回调，之后的块不再读取。
+   */
+  bool read_batch(std::span<const i2c_read_block> blocks,
+                  callback_t &&callback = {}) {
+    return submit({0, {}, {}, std::move(callback), 0, i2c_mem_size::none,
+                   blocks});
+  }
+
+  /**
+   * @brief 阻塞执行一个事务（仅任务上下文），transaction.callback 被忽略。
+   *
+   * 等待期间每个系统节拍调用一次 service()，因此即使没有其他任务调用
+   * service()，推迟的起始条件也会被发出，卡死的总线也会被超时处理并恢复，
+   * 调用方不会永久阻塞。
+   */
+  std::error_code transfer(i2c_transaction &&transaction);
+
+  /// 同 transfer(i2c_transaction &&)
+  std::error_code transfer(uint16_t address, std::span<const uint8_t> data,
+                           std::span<uint8_t> buffer) {
+    return transfer({address, data, buffer});
+  }
+
+  /**
+   * @brief 推迟的起始条件、超时检查与总线恢复（仅任务上下文）。
+   *
+   * 应以不长于超时时间的周期调用（例如在 1 kHz 控制任务中）；
+   * 未提供 timing_wheel 时，停止条件之后的下一个事务最迟在下一次调用时
+   * 开始。
+   * 当前事务超时则中止并以 timeout 失败（等待停止条件时以 bus_busy 失败）；
+   * 若有待恢复的总线故障，执行 recover() 后继续处理队列。
+   */
+  void service();
+
+  /**
+   * @brief SCL 手动时钟总线恢复（仅任务上下文，执行期间总线不可用）。
+   *
+   * 发出最多 9 个 SCL 脉冲直到从机释放 SDA，再手动产生停止条件，
+   * 最后恢复引脚复用功能并重新初始化 I2C 外设。
+   *
+   * @return 恢复后 SDA 为高电平返回 true
+   */
+  bool recover();
+
+  void set_timeout(std::chrono::milliseconds timeout) {
+    m_timeout_ticks = time_to_ticks(timeout);
+  }
+
+  /// 队列中未完成的事务数（含正在执行的事务）
+  [[nodiscard]] std::size_t pending() const noexcept { return m_count; }
+
+  [[nodiscard]] I2C_HandleTypeDef *get_handle() const noexcept {
+    return m_i2c;
+  }
+
+  /// I2C 事件中断入口
+  void event_irq_handler();
+  /// I2C 错误中断入口
+  void error_irq_handler();
+
+  /// 按 I2C 实例查找已注册的总线管理器，未注册返回 nullptr
+  static i2c_bus *find(I2C_TypeDef *instance);
+
+private:
+  enum class bus_state : uint8_t {
+    idle,           // 无事务在执行
+    start,          // 已请求起始条件，等待 SB
+    address,        // 已发送地址，等待 ADDR
+    write_register, // CPU 逐字节写寄存器地址，等待 TXE
+    write_data,     // DMA 写数据中
+    write_last,     // 写完成，等待 BTF（最后一字节移出）
+    read_data,      // DMA 读数据中
+    stop_pending    // 等待上一个停止条件发出后再发起始条件
+  };
+
+  /// 正在执行的一段传输（普通事务只有一段，批量读每个块一段）
+  struct segment {
+    uint16_t address{0};
+    uint16_t mem_address{0};
+    uint8_t mem_size{0};
+    std::span<const uint8_t> write{};
+    std::span<uint8_t> read{};
+
+    [[nodiscard]] bool read_only() const noexcept {
+      return mem_size == 0U && write.empty() && !read.empty();
+    }
+  };
+
+  static bool valid_block(const i2c_read_block &block);
+
+  void start_current();
+  void start_segment();
+  void load_segment();
+  bool next_segment();
+  void finish(std::error_code ec);
+  void begin_phase(bool reading);
+  void on_write_done();
+  void abort_dma();
+  bool try_begin();
+  void poll_stop_pending();
+  void arm_start_timer();
+  void configure_pins_gpio();
+  void configure_pins_af();
+  void half_bit_delay() const;
+
+  i2c_transaction &current() { return m_queue[m_head]; }
+
+  static void tx_dma_cplt_cb(DMA_HandleTypeDef *hdma);
+  static void rx_dma_cplt_cb(DMA_HandleTypeDef *hdma);
+  static void dma_error_cb(DMA_HandleTypeDef *hdma);
+
+  static i2c_bus *instances[bus_count];
+
+  I2C_HandleTypeDef *m_i2c{nullptr};
+  dma_proxy *m_tx_dma{nullptr};
+  dma_proxy *m_rx_dma{nullptr};
+  i2c_bus_pins m_pins;
+  timing_wheel *m_wheel{nullptr};
+  // stop_pending 时每个 SCL 位周期检查一次 CR1.STOP 与 BUSY
+  deadline m_start_deadline{[this] { poll_stop_pending(); }};
+  std::chrono::microseconds m_stop_poll{10};
+
+  i2c_transaction m_queue[queue_depth]{};
+  volatile std::size_t m_head{0};
+  volatile std::size_t m_count{0};
+  volatile bus_state m_state{bus_state::idle};
+  segment m_segment{};
+  std::size_t m_batch_index{0};
+  uint8_t m_register_sent{0};
+  bool m_reading{false};
+  // 上一个事务以读结束且未发停止条件，下一事务以重复起始条件衔接
+  bool m_restart{false};
+  volatile bool m_recovery_needed{false};
+  uint32_t m_started_tick{0};
+  uint32_t m_timeout_ticks{time_to_ticks(default_timeout)};
+};
+
+} // namespace gdut
+
+/**
+ * @brief I2C 中断转发入口（C 链接，供 stm32f4xx_it.c 调用）
+ *
+ * 在 CubeMX 生成的 I2Cx_EV_IRQHandler / I2Cx_ER_IRQHandler 的
+ * USER CODE 段中调用；返回 true 表示该实例由 i2c_bus 接管，应直接返回，
+ * 不再调用 HAL_I2C_EV_IRQHandler / HAL_I2C_ER_IRQHandler。
+ */
+extern "C" bool gdut_i2c_event_irq_handler(I2C_TypeDef *instance);
+extern "C" bool gdut_i2c_error_irq_handler(I2C_TypeDef *instance);
+
+#endif // BSP_I2C_BUS_HPP
@@ -0,0 +1,726 @@
+#ifndef BSP_LOG_RECORDER_HPP
+#define BSP_LOG_RECORDER_HPP
+
+#include "bsp_platform.hpp"
+#include "bsp_uncopyable.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+namespace gdut {
+
+/**
+ * @brief 日志记录器错误码（Flash 错误沿用 Flash 驱动的错误码）
+ */
+enum class log_error_code : uint32_t {
+  none = 0,
+  not_mounted, ///< 未调用 mount() 或挂载失败
+  full,        ///< Flash 已写满
+  busy         ///< 正在记录或仍有未写入的数据，不能执行该操作
+};
+
+/**
+ * @brief log_error_code 的 std::error_category 实现
+ */
+class log_error_category : public std::error_category {
+public:
+  constexpr log_error_category() noexcept = default;
+
+  const char *name() const noexcept override { return "log_error_code"; }
+
+  std::string message(int ev) const override {
+    switch (static_cast<log_error_code>(ev)) {
+    case log_error_code::none:
+      return "No error";
+    case log_error_code::not_mounted:
+      return "Log not mounted";
+    case log_error_code::full:
+      return "Log storage full";
+    case log_error_code::busy:
+      return "Log busy";
+    default:
+      return "Unknown error";
+    }
+  }
+
+  static const log_error_category &instance() {
+    static log_error_category instance;
+    return instance;
+  }
+};
+
+inline std::error_code make_error_code(log_error_code e) {
+  return {static_cast<int>(e), log_error_category::instance()};
+}
+
+} // namespace gdut
+
+namespace std {
+
+/// 启用 gdut::log_error_code 到 std::error_code 的隐式转换
+template <> struct is_error_code_enum<gdut::log_error_code> : true_type {};
+
+} // namespace std
+
+namespace gdut {
+
+/**
+ * @brief log_recorder 对存储介质的要求（NOR Flash 语义）
+ *
+ * - program() 只能把 1 写成 0，不能跨页；可以不等待编程完成就返回
+ * - erase() 把 erase_size 对齐的一个擦除单位恢复为 0xFF，可以立即返回
+ * - busy() 查询上一次编程/擦除是否仍在进行
+ *
+ * w25q_flash 与 ram_flash 满足该约束。
+ */
+template <typename Flash>
+concept log_flash = requires(Flash &flash, uint32_t address,
+                             std::span<uint8_t> buffer,
+                             std::span<const uint8_t> data) {
+  { Flash::page_size } -> std::convertible_to<std::size_t>;
+  { Flash::erase_size } -> std::convertible_to<std::size_t>;
+  { flash.capacity() } -> std::convertible_to<uint32_t>;
+  { flash.read(address, buffer) } -> std::same_as<std::error_code>;
+  { flash.program(address, data) } -> std::same_as<std::error_code>;
+  { flash.erase(address) } -> std::same_as<std::error_code>;
+  { flash.busy() } -> std::same_as<bool>;
+};
+
+/**
+ * @brief 以 RAM 模拟的 NOR Flash
+ *
+ * 编程按位与、擦除置 0xFF，与真实芯片的写入语义一致，busy() 恒为 false。
+ * 用于在没有 Flash 芯片时运行 log_recorder（主机端验证、仿真）。
+ */
+template <std::size_t Capacity, std::size_t PageSize = 256,
+          std::size_t EraseSize = 4096>
+class ram_flash : uncopyable {
+public:
+  static constexpr std::size_t page_size = PageSize;
+  static constexpr std::size_t erase_size = EraseSize;
+
+  static_assert(Capacity % EraseSize == 0 && EraseSize % PageSize == 0,
+                "Capacity must be a multiple of EraseSize, and EraseSize a "
+                "multiple of PageSize");
+
+  ram_flash() { std::fill(std::begin(m_data), std::end(m_data), 0xFF); }
+
+  [[nodiscard]] uint32_t capacity() const noexcept {
+    return static_cast<uint32_t>(Capacity);
+  }
+
+  std::error_code read(uint32_t address, std::span<uint8_t> buffer) {
+    if (address > Capacity || buffer.size() > Capacity - address) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    std::memcpy(buffer.data(), &m_data[address], buffer.size());
+    return {};
+  }
+
+  std::error_code program(uint32_t address, std::span<const uint8_t> data) {
+    if (address >= Capacity || data.size() > Capacity - address ||
+        (address % PageSize) + data.size() > PageSize) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      m_data[address + i] &= data[i];
+    }
+    return {};
+  }
+
+  std::error_code erase(uint32_t address) {
+    if (address >= Capacity) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    const std::size_t base = address - address % EraseSize;
+    std::fill_n(&m_data[base], EraseSize, 0xFF);
+    return {};
+  }
+
+  [[nodiscard]] bool busy() const noexcept { return false; }
+
+  /// 直接访问存储内容（模拟掉电、注入损坏）
+  [[nodiscard]] std::span<uint8_t, Capacity> data() noexcept { return m_data; }
+
+private:
+  uint8_t m_data[Capacity];
+};
+
+/// 读出时交给访问函数的一条记录
+struct log_record {
+  uint16_t session; ///< 写入该记录时的挂载序号（每次上电递增）
+  uint8_t type;     ///< append() 时的记录类型
+  std::span<const uint8_t> payload;
+};
+
+struct log_recorder_stats {
+  uint32_t records;         ///< 写入暂存区的记录数
+  uint32_t dropped;         ///< 暂存区满或 Flash 写满而丢弃的记录数
+  uint32_t pages_written;   ///< 已编程的 Flash 页数
+  uint32_t flash_errors;    ///< 编程/擦除命令失败次数（会重试）
+  uint32_t corrupt_records; ///< 读出时 CRC 校验失败的记录数
+};
+
+/**
+ * @brief 日志结构（只追加）的 Flash 黑匣子记录器
+ *
+ * 控制回路以记录为单位追加数据，记录先写入 RAM 暂存区；暂存区写满一半
+ * 后交给记录任务，由 service() 逐页编程到 Flash，另一半继续接收新记录。
+ *
+ * 存储格式：
+ * - 每页以 6 字节页头开始：magic（0x474C）、挂载序号、本页已用字节数
+ * - 记录不跨页：长度（1）+ 类型（1）+ CRC-16/CCITT（2）+ 负载
+ * - 页按地址顺序写入，未写入的页头为 0xFFFF
+ *
+ * 特性：
+ * - 双缓冲暂存：append() 只做一次 memcpy，可在控制中断/任务中调用；
+ *   CRC 在进入临界区前计算
+ * - 后台擦除：service() 在没有待写数据时预先擦除写入位置之后的一个
+ *   擦除单位，擦除期间记录继续写入暂存区
+ * - 快速挂载：按页头二分查找写入位置，16 MB Flash 只需约 16 次读页头
+ * - 读出：for_each() 逐条校验并回调，read_raw() 按原始字节批量读出
+ *
+ * 线程安全：
+ * - append() 可从多个任务和中断调用（关中断临界区保护）
+ * - mount()/service()/sync()/for_each() 等其余接口只能在同一个任务中调用
+ * - 临界区与延时经由 bsp_platform.hpp，本头文件不依赖 HAL，配合 ram_flash
+ *   可以在主机上测试
+ *
+ * 重要约束：
+ * - 对象内含 DMA 缓冲区，不能定义在 CCMRAM 中；任务栈与 pvPortMalloc 的
+ *   内存默认来自 CCM（见 bsp_heap.hpp），应定义为全局/静态对象
+ * - Flash 写满后停止记录，不覆盖旧数据；比赛间隙用 erase_log() 清空
+ *
+ * 使用示例：
+ * @code
+ * gdut::w25q_flash flash(flash_dev);
+ * gdut::log_recorder<gdut::w25q_flash> black_box(flash);
+ *
+ * // 记录任务
+ * flash.init();
+ * black_box.mount();
+ * black_box.start();
+ * for (;;) {
+ *   black_box.service();
+ *   osDelay(1);
+ * }
+ *
+ * // 1 kHz 控制中断
+ * black_box.append(state_record_type, state);
+ * @endcode
+ *
+ * @tparam Flash         满足 log_flash 的存储介质
+ * @tparam StagingPages  每个暂存缓冲区的页数（共两个）
+ */
+template <log_flash Flash, std::size_t StagingPages = 8>
+class log_recorder : uncopyable {
+public:
+  static constexpr std::size_t page_size = Flash::page_size;
+  static constexpr std::size_t erase_size = Flash::erase_size;
+  static constexpr std::size_t page_header_size = 6;
+  static constexpr std::size_t record_header_size = 4;
+  /// 单条记录负载上限
+  static constexpr std::size_t max_payload =
+      std::min<std::size_t>(255, page_size - page_header_size -
+                                     record_header_size);
+  static constexpr uint16_t page_magic = 0x474C;
+
+  static_assert(StagingPages > 0, "StagingPages must be positive");
+  static_assert(erase_size % page_size == 0,
+                "erase_size must be a multiple of page_size");
+
+  explicit log_recorder(Flash &flash) : m_flash(&flash) {
+    std::fill(&m_buffers[0][0], &m_buffers[0][0] + sizeof(m_buffers), 0xFF);
+  }
+  ~log_recorder() noexcept = default;
+
+  /**
+   * @brief 查找写入位置并开始新的挂载序号（仅任务上下文）
+   *
+   * 对页头二分查找第一个未写入的页；掉电时可能留下页头未写入、
+   * 其余字节已部分编程的页，这样的页被跳过。挂载序号取写入位置之前
+   * 最后一个完整页（页头有效且全部记录 CRC 正确）的序号加一，掉电时
+   * 编程了一半的页不会让新的挂载序号与已有序号重复。
+   */
+  std::error_code mount() {
+    m_recording = false;
+    m_mounted = false;
+    m_page_count = m_flash->capacity() / page_size;
+
+    uint32_t low = 0;
+    uint32_t high = m_page_count;
+    uint8_t header[page_header_size];
+    while (low < high) {
+      const uint32_t middle = low + (high - low) / 2U;
+      if (std::error_code ec = read_header(middle, header)) {
+        return ec;
+      }
+      if (load_u16(&header[0]) == page_magic) {
+        low = middle + 1U;
+      } else {
+        high = middle;
+      }
+    }
+    uint8_t *scratch = &m_buffers[0][0];
+    while (low < m_page_count) {
+      if (std::error_code ec = m_flash->read(
+              page_address(low), std::span<uint8_t>(scratch, page_size))) {
+        return ec;
+      }
+      if (std::all_of(scratch, scratch + page_size,
+                      [](uint8_t byte) { return byte == 0xFFU; })) {
+        break;
+      }
+      ++low;
+    }
+
+    // 从写入位置向前找最后一个完整页，挂载序号从它继续。通常第一次
+    // 就命中；页头有效但内容未编程完的页同样跳过
+    m_session = 0;
+    for (uint32_t page = low; page-- > 0U;) {
+      if (std::error_code ec = m_flash->read(
+              page_address(page), std::span<uint8_t>(scratch, page_size))) {
+        std::fill(scratch, scratch + page_size, 0xFF);
+        return ec;
+      }
+      if (intact_page(scratch)) {
+        m_session = static_cast<uint16_t>(load_u16(&scratch[2]) + 1U);
+        break;
+      }
+    }
+    std::fill(scratch, scratch + page_size, 0xFF);
+
+    m_head_page = low;
+    // 写入位置所在擦除单位的剩余部分已擦除；位于边界时下一个单位状态未知
+    m_erased_until = round_up(page_address(low));
+    m_active = 0;
+    m_page = 0;
+    m_offset = 0;
+    m_pending = false;
+    m_buffer_records[0] = 0;
+    m_buffer_records[1] = 0;
+    m_mounted = true;
+    return {};
+  }
+
+  /// 开始接受 append()
+  std::error_code start() {
+    if (!m_mounted) {
+      return log_error_code::not_mounted;
+    }
+    m_recording = true;
+    return {};
+  }
+
+  /// 停止接受 append()；暂存区中的数据需 sync() 写入
+  void stop() noexcept { m_recording = false; }
+
+  [[nodiscard]] bool recording() const noexcept { return m_recording; }
+
+  /**
+   * @brief 追加一条记录（任务或中断上下文）
+   * @return 写入暂存区返回 true；未在记录、负载过长或暂存区满返回 false
+   */
+  bool append(uint8_t type, std::span<const uint8_t> payload) {
+    if (!m_recording || payload.size() > max_payload) {
+      return false;
+    }
+    const std::size_t size = record_header_size + payload.size();
+    uint8_t header[record_header_size] = {
+        static_cast<uint8_t>(payload.size()), type, 0, 0};
+    const uint16_t crc = crc16(payload, crc16({header, 2}));
+    header[2] = static_cast<uint8_t>(crc);
+    header[3] = static_cast<uint8_t>(crc >> 8U);
+
+    interrupt_lock lock;
+    if (m_page < StagingPages && m_offset + size > page_size) {
+      seal_page();
+    }
+    if (m_page == StagingPages && !hand_off()) {
+      ++m_stats.dropped;
+      return false;
+    }
+    if (m_offset == 0U) {
+      m_offset = page_header_size;
+    }
+    uint8_t *record = current_page() + m_offset;
+    std::memcpy(record, header, record_header_size);
+    std::memcpy(record + record_header_size, payload.data(), payload.size());
+    m_offset = m_offset + size;
+    m_buffer_records[m_active] = m_buffer_records[m_active] + 1U;
+    ++m_stats.records;
+    return true;
+  }
+
+  /// 以对象表示追加一条记录
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  bool append(uint8_t type, const T &value) {
+    static_assert(sizeof(T) <= max_payload, "record payload too large");
+    return append(type, std::span<const uint8_t>(
+                            reinterpret_cast<const uint8_t *>(&value),
+                            sizeof(T)));
+  }
+
+  /**
+   * @brief 推进一步 Flash 写入（仅记录任务，建议每 1 ms 调用）
+   *
+   * 每次调用最多发出一条编程或擦除命令，Flash 忙时立即返回。
+   * 出错的编程/擦除在下一次调用时重试。
+   */
+  std::error_code service() {
+    if (!m_mounted) {
+      return log_error_code::not_mounted;
+    }
+    if (m_flash->busy()) {
+      return {};
+    }
+
+    if (m_pending) {
+      if (m_flushed_pages == m_pending_pages) {
+        release();
+        return {};
+      }
+      if (m_head_page >= m_page_count) {
+        // 写满：丢弃剩余数据并停止记录
+        m_recording = false;
+        {
+          // append() 在中断中也会累加 dropped
+          interrupt_lock lock;
+          m_stats.dropped += m_buffer_records[m_pending_index];
+        }
+        release();
+        return log_error_code::full;
+      }
+      const uint32_t address = page_address(m_head_page);
+      if (address >= m_erased_until) {
+        return erase_next();
+      }
+      const uint8_t *page = &m_buffers[m_pending_index][m_flushed_pages *
+                                                        page_size];
+      if (std::error_code ec = m_flash->program(
+              address, std::span<const uint8_t>(page, page_size))) {
+        ++m_stats.flash_errors;
+        return ec;
+      }
+      ++m_head_page;
+      ++m_flushed_pages;
+      ++m_stats.pages_written;
+      return {};
+    }
+
+    // 空闲时预擦除下一个擦除单位
+    if (m_recording && m_erased_until < m_page_count * page_size &&
+        m_erased_until - page_address(m_head_page) < erase_size) {
+      return erase_next();
+    }
+    return {};
+  }
+
+  /**
+   * @brief 把暂存区中的全部记录写入 Flash 并等待完成（仅记录任务）
+   *
+   * 比赛结束或掉电检测时调用。阻塞期间 append() 仍可写入暂存区，
+   * 调用时尚未交出的记录需下一次 sync() 写入。
+   */
+  std::error_code sync() {
+    if (!m_mounted) {
+      return log_error_code::not_mounted;
+    }
+    // 交出当前暂存的数据；另一半仍在写入时先等它写完
+    for (;;) {
+      bool ready = false;
+      {
+        interrupt_lock lock;
+        const bool staged = m_page != 0U || m_offset != 0U;
+        ready = !staged || !m_pending;
+        if (staged && !m_pending) {
+          if (m_offset != 0U) {
+            seal_page();
+          }
+          (void)hand_off();
+        }
+      }
+      if (ready) {
+        break;
+      }
+      if (std::error_code ec = service()) {
+        return ec;
+      }
+      delay_tick();
+    }
+    while (m_pending) {
+      if (std::error_code ec = service()) {
+        return ec;
+      }
+      delay_tick();
+    }
+    while (m_flash->busy()) {
+      delay_tick();
+    }
+    return {};
+  }
+
+  /**
+   * @brief 逐条读出全部记录（仅任务上下文，须先 stop() 并 sync()）
+   *
+   * CRC 校验失败的记录计入 corrupt_records，并跳过该页的剩余部分。
+   * @param visitor  以 const log_record & 调用
+   */
+  template <typename Visitor> std::error_code for_each(Visitor &&visitor) {
+    if (std::error_code ec = check_idle()) {
+      return ec;
+    }
+    // 暂存区此时为空，借用另一半作读缓冲区（须位于非 CCMRAM）
+    uint8_t *page = &m_buffers[m_active ^ 1U][0];
+    std::error_code result{};
+    for (uint32_t index = 0; index < m_head_page; ++index) {
+      result = m_flash->read(page_address(index),
+                             std::span<uint8_t>(page, page_size));
+      if (result) {
+        break;
+      }
+      const uint16_t used = load_u16(&page[4]);
+      if (load_u16(&page[0]) != page_magic || used > page_size) {
+        continue;
+      }
+      const uint16_t session = load_u16(&page[2]);
+      for (std::size_t offset = page_header_size;
+           offset + record_header_size <= used;) {
+        const uint8_t length = page[offset];
+        if (!valid_record(page, offset, used)) {
+          ++m_stats.corrupt_records;
+          break;
+        }
+        visitor(log_record{session, page[offset + 1],
+                           {&page[offset + record_header_size], length}});
+        offset += record_header_size + length;
+      }
+    }
+    std::fill(page, page + page_size, 0xFF);
+    return result;
+  }
+
+  /**
+   * @brief 按原始字节读出日志（批量导出到上位机）
+   * @return 超出 used_bytes() 的部分不读取
+   */
+  std::error_code read_raw(uint32_t offset, std::span<uint8_t> buffer) {
+    if (std::error_code ec = check_idle()) {
+      return ec;
+    }
+    const uint32_t used = used_bytes();
+    if (offset >= used) {
+      return {};
+    }
+    return m_flash->read(
+        offset, buffer.first(std::min<std::size_t>(buffer.size(),
+                                                   used - offset)));
+  }
+
+  /**
+   * @brief 擦除已使用的区域，回到空日志（仅任务上下文，阻塞）
+   */
+  std::error_code erase_log() {
+    if (std::error_code ec = check_idle()) {
+      return ec;
+    }
+    const uint32_t end = round_up(page_address(m_head_page));
+    for (uint32_t address = 0; address < end; address += erase_size) {
+      if (std::error_code ec = m_flash->erase(address)) {
+        return ec;
+      }
+      while (m_flash->busy()) {
+        delay_tick();
+      }
+    }
+    m_head_page = 0;
+    m_erased_until = end;
+    return {};
+  }
+
+  /// 已写入 Flash 的字节数（整页计）
+  [[nodiscard]] uint32_t used_bytes() const noexcept {
+    return page_address(m_head_page);
+  }
+
+  [[nodiscard]] uint16_t session() const noexcept { return m_session; }
+
+  [[nodiscard]] log_recorder_stats stats() const noexcept {
+    interrupt_lock lock;
+    return m_stats;
+  }
+
+  /// CRC-16/CCITT-FALSE（多项式 0x1021），seed 用于分段计算
+  static uint16_t crc16(std::span<const uint8_t> data,
+                        uint16_t seed = 0xFFFF) noexcept {
+    uint16_t crc = seed;
+    for (uint8_t byte : data) {
+      crc = static_cast<uint16_t>((crc << 8U) ^
+                                  crc_table[((crc >> 8U) ^ byte) & 0xFFU]);
+    }
+    return crc;
+  }
+
+private:
+  static constexpr std::size_t buffer_size = StagingPages * page_size;
+
+  static constexpr std::array<uint16_t, 256> crc_table = [] {
+    std::array<uint16_t, 256> table{};
+    for (uint32_t i = 0; i < 256U; ++i) {
+      uint32_t crc = i << 8U;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 0x8000U) != 0U ? (crc << 1U) ^ 0x1021U : crc << 1U;
+      }
+      table[i] = static_cast<uint16_t>(crc);
+    }
+    return table;
+  }();
+
+  static uint16_t load_u16(const uint8_t *p) noexcept {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8U));
+  }
+
+  static void store_u16(uint8_t *p, uint16_t value) noexcept {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8U);
+  }
+
+  static uint32_t page_address(uint32_t page) noexcept {
+    return page * static_cast<uint32_t>(page_size);
+  }
+
+  static uint32_t round_up(uint32_t address) noexcept {
+    const auto unit = static_cast<uint32_t>(erase_size);
+    return (address + unit - 1U) / unit * unit;
+  }
+
+  uint8_t *current_page() noexcept {
+    return &m_buffers[m_active][m_page * page_size];
+  }
+
+  /// offset 处的记录完整位于 used 之内且 CRC 正确
+  static bool valid_record(const uint8_t *page, std::size_t offset,
+                           std::size_t used) noexcept {
+    const uint8_t length = page[offset];
+    if (offset + record_header_size + length > used) {
+      return false;
+    }
+    const uint16_t crc = load_u16(&page[offset + 2]);
+    return crc16({&page[offset + record_header_size], length},
+                 crc16({&page[offset], 2})) == crc;
+  }
+
+  /// 页头有效，记录恰好填满已用字节且全部通过 CRC 校验
+  static bool intact_page(const uint8_t *page) noexcept {
+    const uint16_t used = load_u16(&page[4]);
+    if (load_u16(&page[0]) != page_magic || used < page_header_size ||
+        used > page_size) {
+      return false;
+    }
+    std::size_t offset = page_header_size;
+    while (offset + record_header_size <= used) {
+      if (!valid_record(page, offset, used)) {
+        return false;
+      }
+      offset += record_header_size + page[offset];
+    }
+    return offset == used;
+  }
+
+  std::error_code read_header(uint32_t page, uint8_t *header) {
+    // 经由 DMA 可访问的暂存区读取，调用方的栈可能位于 CCMRAM
+    uint8_t *scratch = &m_buffers[0][0];
+    std::error_code ec = m_flash->read(
+        page_address(page), std::span<uint8_t>(scratch, page_header_size));
+    std::memcpy(header, scratch, page_header_size);
+    std::fill(scratch, scratch + page_header_size, 0xFF);
+    return ec;
+  }
+
+  std::error_code check_idle() const {
+    if (!m_mounted) {
+      return log_error_code::not_mounted;
+    }
+    if (m_recording || m_pending || m_page != 0U || m_offset != 0U) {
+      return log_error_code::busy;
+    }
+    return {};
+  }
+
+  std::error_code erase_next() {
+    if (std::error_code ec = m_flash->erase(m_erased_until)) {
+      ++m_stats.flash_errors;
+      return ec;
+    }
+    m_erased_until += static_cast<uint32_t>(erase_size);
+    return {};
+  }
+
+  // 以下两个函数在关中断临界区内调用
+  void seal_page() noexcept {
+    uint8_t *page = current_page();
+    store_u16(&page[0], page_magic);
+    store_u16(&page[2], m_session);
+    store_u16(&page[4], static_cast<uint16_t>(m_offset));
+    m_page = m_page + 1U;
+    m_offset = 0;
+  }
+
+  bool hand_off() noexcept {
+    if (m_pending) {
+      return false;
+    }
+    m_pending_index = m_active;
+    m_pending_pages = m_page;
+    m_flushed_pages = 0;
+    m_active = m_active ^ 1U;
+    m_page = 0;
+    m_offset = 0;
+    m_pending = true;
+    return true;
+  }
+
+  void release() {
+    // 恢复为擦除状态，写入记录后未使用的页尾即为 0xFF
+    std::fill_n(&m_buffers[m_pending_index][0], buffer_size, 0xFF);
+    m_buffer_records[m_pending_index] = 0;
+    interrupt_lock lock;
+    m_pending = false;
+  }
+
+  Flash *m_flash;
+  uint32_t m_page_count{0};
+  uint32_t m_head_page{0};    // 下一个待编程的 Flash 页
+  uint32_t m_erased_until{0}; // 此地址之前（写入位置之后）已擦除
+  uint16_t m_session{0};
+  bool m_mounted{false};
+  volatile bool m_recording{false};
+
+  uint8_t m_buffers[2][buffer_size];
+  // 生产者：正在填充的缓冲区、页号、页内偏移（0 表示该页尚未开始）
+  volatile uint32_t m_active{0};
+  volatile uint32_t m_page{0};
+  volatile uint32_t m_offset{0};
+  uint32_t m_buffer_records[2]{};
+  // 记录任务：等待写入的缓冲区
+  volatile bool m_pending{false};
+  uint32_t m_pending_index{0};
+  uint32_t m_pending_pages{0};
+  uint32_t m_flushed_pages{0};
+
+  // records/dropped 由 append()（可能在中断中）与 service() 共同修改，
+  // 只在临界区内更新；其余字段只由记录任务写入
+  log_recorder_stats m_stats{};
+};
+
+} // namespace gdut
+
+#endif // BSP_LOG_RECORDER_HPP
@@ -2,15 +2,95 @@
 #define BSP_MEMORY_RESOURCE_HPP
 
 #include "FreeRTOS.h"
+#include "bsp_heap.hpp"
 #include "bsp_mutex.hpp"
+#include "bsp_type_traits.hpp"
 #include "tlsf.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cmsis_os2.h>
 #include <cstddef>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <memory_resource>
 #include <mutex>
 
 namespace gdut::pmr {
 
+namespace detail {
+
+/// 遍历一个 TLSF 内存池，返回其中最大空闲块的字节数（O(块数)）
+inline std::size_t tlsf_largest_free_block(pool_t pool) {
+  std::size_t largest = 0;
+  tlsf_walk_pool(
+      pool,
+      [](void *, size_t size, int used, void *user) {
+        auto *max_size = static_cast<std::size_t *>(user);
+        if (used == 0 && size > *max_size) {
+          *max_size = size;
+        }
+      },
+      &largest);
+  return largest;
+}
+
+/**
+ * @brief 供无锁链表使用的 32 位“加载-独占/存储-条件”字
+ *
+ * Cortex-M4 上直接使用 LDREX/STREX：两者之间发生任何异常（中断、
+ * 任务切换）都会清除独占监视器，STREX 失败后重试。主机仿真中退化为
+ * std::atomic 的 compare_exchange_weak，expected 为 load_exclusive()
+ * 的返回值。
+ */
+#if defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__)
+class exclusive_word {
+public:
+  explicit exclusive_word(uint32_t value) : m_value(value) {}
+
+  uint32_t load_exclusive() noexcept { return __LDREXW(&m_value); }
+
+  bool store_exclusive(uint32_t expected, uint32_t desired) noexcept {
+    (void)expected;
+    // LDREX 与 STREX 之间写入的普通内存须先于新的链表头可见
+    std::atomic_signal_fence(std::memory_order_release);
+    return __STREXW(desired, &m_value) == 0U;
+  }
+
+  void clear_exclusive() noexcept { __CLREX(); }
+
+private:
+  volatile uint32_t m_value;
+};
+#else
+class exclusive_word {
+public:
+  explicit exclusive_word(uint32_t value) : m_value(value) {}
+
+  uint32_t load_exclusive() noexcept {
+    return m_value.load(std::memory_order_acquire);
+  }
+
+  bool store_exclusive(uint32_t expected, uint32_t desired) noexcept {
+    return m_value.compare_exchange_weak(expected, desired,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire);
+  }
+
+  void clear_exclusive() noexcept {}
+
+private:
+  std::atomic<uint32_t> m_value;
+};
+#endif
+
+} // namespace detail
+
+// FreeRTOS 堆（pvPortMalloc）资源；内存优先来自 CCM RAM，不能用作 DMA 缓冲区
+// （GDUT_HEAP_PREFER_FAST=0 时只来自主 SRAM，见 bsp_heap.hpp）
 class portable_resource : public std::pmr::memory_resource {
 public:
   static memory_resource *get_instance() {
@@ -31,6 +111,16 @@ private:
     }
     return pvPortMalloc(bytes);
   }
+
+public:
+  /// FreeRTOS 堆中最大空闲块的字节数（遍历空闲链表，O(空闲块数)）
+  static std::size_t largest_free_block() {
+    HeapStats_t heap_stats{};
+    vPortGetHeapStats(&heap_stats);
+    return heap_stats.xSizeOfLargestFreeBlockInBytes;
+  }
+
+private:
   void do_deallocate(void *p, size_t bytes, size_t alignment) override {
     (void)bytes;     // 该简化实现忽略 bytes
     (void)alignment; // 该简化实现忽略 alignment
@@ -41,6 +131,52 @@ private:
   }
 };
 
+/**
+ * @brief 只从 FreeRTOS 堆的指定区域分配的内存资源
+ *
+ * 与 portable_resource 共用 rtos_heap，但不在区域之间回退：
+ * heap_region_resource<heap_region::dma> 返回的内存总位于主 SRAM，
+ * 可以作为 DMA 缓冲区；heap_region::fast 则保证位于 CCM RAM。
+ *
+ * 使用示例：
+ * @code
+ * std::pmr::vector<uint8_t> tx(
+ *     64, gdut::pmr::heap_region_resource<gdut::heap_region::dma>::
+ *             get_instance());
+ * @endcode
+ */
+template <heap_region Region>
+class heap_region_resource : public std::pmr::memory_resource {
+public:
+  static memory_resource *get_instance() {
+    static heap_region_resource instance;
+    return &instance;
+  }
+
+  /// 本区域最大空闲块的字节数（遍历区域，O(块数)）
+  static std::size_t largest_free_block() {
+    return rtos_heap::stats(Region).largest_free_block;
+  }
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (alignment > rtos_heap::alignment) {
+      return nullptr;
+    }
+    return rtos_heap::allocate(bytes, Region);
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    (void)bytes;     // 该实现忽略 bytes
+    (void)alignment; // 该实现忽略 alignment
+    rtos_heap::deallocate(p);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == std::addressof(other);
+  }
+};
+
 // 非线程安全的内存池资源
 class unsynchronized_tlsf_resource : public std::pmr::memory_resource {
   struct alloc_node {
@@ -108,6 +244,23 @@ public:
 
   explicit operator bool() const { return m_pool_memory != nullptr; }
 
+  /// 所有 TLSF 内存池中最大空闲块的字节数（O(块数)，不含上游资源）
+  std::size_t largest_free_block() const {
+    if (m_pool_memory == nullptr) {
+      return 0;
+    }
+    std::size_t largest = 0;
+    for (alloc_node *node = m_free_list_head; node != nullptr;
+         node = node->next) {
+      // 最早的一块（链表尾）以 TLSF 控制结构开头，其余块直接是内存池
+      pool_t pool = node->next == nullptr
+                        ? tlsf_get_pool(m_pool_memory)
+                        : static_cast<pool_t>(node + 1);
+      largest = std::max(largest, detail::tlsf_largest_free_block(pool));
+    }
+    return largest;
+  }
+
 private:
   void *do_allocate(size_t bytes, size_t alignment) override {
     if (m_pool_memory == nullptr) {
@@ -174,6 +327,11 @@ public:
     return static_cast<bool>(m_pool);
   }
 
+  std::size_t largest_free_block() const {
+    std::lock_guard lock(m_mutex);
+    return m_pool.largest_free_block();
+  }
+
 private:
   void *do_allocate(size_t bytes, size_t alignment) override {
     std::lock_guard lock(m_mutex);
@@ -317,6 +475,14 @@ public:
 
   explicit operator bool() const { return m_pool_memory != nullptr; }
 
+  /// 最大空闲块的字节数（遍历内存池，O(块数)）
+  std::size_t largest_free_block() const {
+    if (m_pool_memory == nullptr) {
+      return 0;
+    }
+    return detail::tlsf_largest_free_block(tlsf_get_pool(m_pool_memory));
+  }
+
 private:
   void *do_allocate(size_t bytes, size_t alignment) override {
     if (m_pool_memory == nullptr || bytes == 0) {
@@ -346,6 +512,777 @@ private:
   alignas(std::max_align_t) char m_block[BlockSize]{};
 };
 
+/**
+ * @brief 可被 DMA 访问的 TLSF 内存资源。
+ *
+ * 与 fixed_block_resource 相同，使用内部 @p PoolSize 字节的静态缓冲区，
+ * 但专门用于 DMA 缓冲区：
+ * - 所有分配至少按 burst_alignment（16 字节）对齐，满足 4 拍字突发
+ *   （INC4）的地址要求，分配出的缓冲区可直接交给 dma_memcpy 等使用突发
+ *   的模块；
+ * - 构造时检查内部缓冲区不在 CCMRAM 中。对象应使用 GDUT_DMA_BUFFER
+ *   放入链接脚本的 .dma_buffer 段（主 SRAM）；若误放在 CCMRAM，
+ *   资源无效，operator bool() 返回 false（调试配置下直接终止）。
+ *
+ * get_dma_buffer_resource() 提供一个位于 .dma_buffer 段的全局实例，
+ * 大小为 default_dma_pool_size。
+ *
+ * 线程安全：与 fixed_block_resource 一样不提供内部同步。DMA 缓冲区通常在
+ * 初始化阶段一次性分配；若需在多个任务中并发分配，调用方须加互斥保护。
+ *
+ * 使用示例：
+ * @code
+ * GDUT_DMA_BUFFER gdut::pmr::dma_buffer_resource<2048> uart_dma_pool;
+ *
+ * std::pmr::vector<uint8_t> rx_buffer(256, &uart_dma_pool);
+ * uart_dma.receive(rx_buffer.data(), rx_buffer.size());
+ * @endcode
+ */
+template <std::size_t PoolSize>
+class dma_buffer_resource : public std::pmr::memory_resource {
+  static_assert(PoolSize > 0, "Pool size must be greater than zero.");
+
+public:
+  /// 4 拍字突发一次搬运 16 字节，起始地址按 16 字节对齐即可保证突发不跨越
+  /// 1 KB 地址边界
+  static constexpr std::size_t burst_alignment = 16;
+
+  dma_buffer_resource() {
+    if (!is_dma_capable_address(m_block)) {
+#if defined(GDUT_DMA_BUFFER_CHECK_FATAL) && GDUT_DMA_BUFFER_CHECK_FATAL
+      std::terminate();
+#else
+      return;
+#endif
+    }
+    m_pool_memory = tlsf_create_with_pool(m_block, PoolSize);
+  }
+
+  dma_buffer_resource(const dma_buffer_resource &) = delete;
+  dma_buffer_resource &operator=(const dma_buffer_resource &) = delete;
+  dma_buffer_resource(dma_buffer_resource &&) = delete;
+  dma_buffer_resource &operator=(dma_buffer_resource &&) = delete;
+
+  ~dma_buffer_resource() override {
+    if (m_pool_memory != nullptr) {
+      tlsf_destroy(m_pool_memory);
+    }
+  }
+
+  explicit operator bool() const { return m_pool_memory != nullptr; }
+
+  /// 最大空闲块的字节数（遍历内存池，O(块数)）
+  std::size_t largest_free_block() const {
+    if (m_pool_memory == nullptr) {
+      return 0;
+    }
+    return detail::tlsf_largest_free_block(tlsf_get_pool(m_pool_memory));
+  }
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (m_pool_memory == nullptr || bytes == 0) {
+      return nullptr;
+    }
+    if (bytes > PoolSize - tlsf_size()) {
+      return nullptr;
+    }
+    return tlsf_memalign(m_pool_memory, std::max(alignment, burst_alignment),
+                         bytes);
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    (void)bytes;     // 该实现忽略 bytes
+    (void)alignment; // 该实现忽略 alignment
+    if (m_pool_memory != nullptr && p != nullptr) {
+      tlsf_free(m_pool_memory, p);
+    }
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == std::addressof(other);
+  }
+
+private:
+  tlsf_t m_pool_memory{nullptr};
+  alignas(burst_alignment) char m_block[PoolSize];
+};
+
+/// 全局 DMA 缓冲区内存池的默认大小（字节）
+inline constexpr std::size_t default_dma_pool_size = 4096;
+
+/**
+ * @brief 返回位于 .dma_buffer 段的全局 DMA 缓冲区内存资源。
+ *
+ * 首次调用时构造（函数内静态对象），未调用时不占用 RAM。
+ */
+inline std::pmr::memory_resource *get_dma_buffer_resource() {
+  GDUT_DMA_BUFFER static dma_buffer_resource<default_dma_pool_size> instance;
+  return &instance;
+}
+
+/// slab_resource 中一个尺寸类的占用统计
+struct slab_class_stats {
+  std::size_t block_size{0}; // 块大小（字节，已按对齐粒度取整）
+  std::size_t in_use{0};     // 当前已分配的块数
+  std::size_t peak{0};       // in_use 的历史最大值
+  std::size_t capacity{0};   // 已申请的页能容纳的块数
+  std::size_t pages{0};      // 从上游申请的页数
+};
+
+/**
+ * @brief 按固定尺寸类分配的 slab 内存资源。
+ *
+ * 每个尺寸类维护一条侵入式空闲链表：释放的块直接压入链表，分配时弹出，
+ * 均为几条指令。链表为空时从当前页顺序切出一个块；当前页用完后再从
+ * 上游资源申请一页（大小为 page_size）。尺寸类由模板参数给出，请求的
+ * 字节数经编译期生成的查找表一次映射到尺寸类，分配与释放都是 O(1)。
+ *
+ * 适合大小集中在少数几种的分配（function 的回调模型、消息节点、
+ * 帧缓冲）：没有 TLSF 的分级查找、块头与合并开销，每块不额外占用内存。
+ *
+ * 特性：
+ * - 尺寸类按 alignof(std::max_align_t) 取整，块按该粒度对齐
+ * - 超过最大尺寸类或对齐要求更高的请求转发给上游资源
+ * - 页只在析构时归还上游；空闲块留在各自的尺寸类中复用
+ * - stats() 给出每个尺寸类的当前占用、峰值与容量
+ *
+ * 线程安全：与 unsynchronized_tlsf_resource 一样不提供内部同步。
+ *
+ * 重要约束：
+ * - 尺寸类须严格递增（取整之后），至多 255 个
+ * - 释放时的 bytes/alignment 须与分配时一致（std::pmr 容器保证这一点），
+ *   否则块会回到错误的尺寸类
+ *
+ * 使用示例：
+ * @code
+ * gdut::pmr::slab_resource<16, 32, 64, 128> node_pool;
+ *
+ * std::pmr::list<can_frame> pending(&node_pool);
+ * pending.push_back(frame); // 节点来自 32 字节尺寸类
+ *
+ * const gdut::pmr::slab_class_stats s = node_pool.stats(1);
+ * // s.in_use / s.capacity / s.peak 可经遥测上报
+ * @endcode
+ */
+template <std::size_t... SizeClasses>
+class slab_resource : public std::pmr::memory_resource {
+  static constexpr std::size_t granule = alignof(std::max_align_t);
+
+  static constexpr std::size_t round_up(std::size_t n) {
+    return (n + granule - 1) / granule * granule;
+  }
+
+public:
+  static constexpr std::size_t class_count = sizeof...(SizeClasses);
+  static constexpr std::array<std::size_t, class_count> block_sizes{
+      round_up(SizeClasses)...};
+  static constexpr std::size_t max_block_size = block_sizes.back();
+
+  static_assert(class_count > 0 && class_count <= 255,
+                "slab_resource needs between 1 and 255 size classes");
+  static_assert(((SizeClasses > 0) && ...),
+                "size classes must be greater than zero");
+  static_assert(std::ranges::adjacent_find(block_sizes,
+                                           std::greater_equal<>{}) ==
+                    block_sizes.end(),
+                "size classes must be strictly increasing after rounding "
+                "to alignof(std::max_align_t)");
+
+  static constexpr size_t default_page_size() {
+    return 1024; // 每次向上游申请的页大小
+  }
+
+  slab_resource(memory_resource *upstream = portable_resource::get_instance(),
+                std::size_t page_size = default_page_size())
+      : m_upstream_resource(upstream), m_page_size(page_size) {
+    if (m_upstream_resource == nullptr) {
+      m_upstream_resource = portable_resource::get_instance();
+    }
+    for (std::size_t i = 0; i < class_count; ++i) {
+      m_classes[i].block_size = block_sizes[i];
+    }
+  }
+
+  slab_resource(const slab_resource &) = delete;
+  slab_resource &operator=(const slab_resource &) = delete;
+
+  ~slab_resource() override {
+    while (m_pages != nullptr) {
+      page_header *current = m_pages;
+      m_pages = m_pages->next;
+      m_upstream_resource->deallocate(current, current->bytes,
+                                      alignof(std::max_align_t));
+    }
+  }
+
+  [[nodiscard]] slab_class_stats stats(std::size_t index) const {
+    if (index >= class_count) {
+      return {};
+    }
+    const slab_class &c = m_classes[index];
+    return {c.block_size, c.in_use, c.peak, c.capacity, c.pages};
+  }
+
+  /// 请求 bytes 字节时使用的尺寸类；超过最大尺寸类时返回 class_count
+  [[nodiscard]] static constexpr std::size_t
+  class_index(std::size_t bytes) noexcept {
+    if (bytes > max_block_size) {
+      return class_count;
+    }
+    return class_table[(bytes + granule - 1) / granule];
+  }
+
+private:
+  struct free_node {
+    free_node *next;
+  };
+
+  struct page_header {
+    page_header *next;
+    std::size_t bytes;
+  };
+
+  struct slab_class {
+    free_node *free_list{nullptr};
+    char *cursor{nullptr}; // 当前页中尚未切出的部分
+    char *end{nullptr};
+    std::size_t block_size{0};
+    std::size_t in_use{0};
+    std::size_t peak{0};
+    std::size_t capacity{0};
+    std::size_t pages{0};
+  };
+
+  static constexpr std::size_t header_size = round_up(sizeof(page_header));
+
+  // 以 granule 为单位的请求大小 → 尺寸类下标
+  static constexpr auto class_table = [] {
+    std::array<uint8_t, max_block_size / granule + 1> table{};
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < table.size(); ++i) {
+      while (i * granule > block_sizes[k]) {
+        ++k;
+      }
+      table[i] = static_cast<uint8_t>(k);
+    }
+    return table;
+  }();
+
+  static bool use_upstream(std::size_t bytes, std::size_t alignment) {
+    return bytes > max_block_size || alignment > granule;
+  }
+
+  bool refill(slab_class &c) {
+    const std::size_t bytes =
+        std::max(m_page_size, header_size + c.block_size);
+    void *mem = m_upstream_resource->allocate(bytes, alignof(std::max_align_t));
+    if (mem == nullptr) {
+      return false;
+    }
+    auto *page = static_cast<page_header *>(mem);
+    page->next = m_pages;
+    page->bytes = bytes;
+    m_pages = page;
+    // 页尾不足一块的部分不使用
+    c.cursor = static_cast<char *>(mem) + header_size;
+    c.end = c.cursor + (bytes - header_size) / c.block_size * c.block_size;
+    c.capacity += (bytes - header_size) / c.block_size;
+    ++c.pages;
+    return true;
+  }
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (use_upstream(bytes, alignment)) {
+      return m_upstream_resource->allocate(bytes, alignment);
+    }
+    slab_class &c = m_classes[class_index(bytes)];
+    void *p = c.free_list;
+    if (p != nullptr) {
+      c.free_list = c.free_list->next;
+    } else {
+      if (c.cursor == c.end && !refill(c)) {
+        return nullptr;
+      }
+      p = c.cursor;
+      c.cursor += c.block_size;
+    }
+    if (++c.in_use > c.peak) {
+      c.peak = c.in_use;
+    }
+    return p;
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    if (p == nullptr) {
+      return;
+    }
+    if (use_upstream(bytes, alignment)) {
+      m_upstream_resource->deallocate(p, bytes, alignment);
+      return;
+    }
+    slab_class &c = m_classes[class_index(bytes)];
+    auto *node = static_cast<free_node *>(p);
+    node->next = c.free_list;
+    c.free_list = node;
+    --c.in_use;
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == std::addressof(other);
+  }
+
+  memory_resource *m_upstream_resource{nullptr};
+  std::size_t m_page_size{0};
+  page_header *m_pages{nullptr};
+  std::array<slab_class, class_count> m_classes{};
+};
+
+/**
+ * @brief stats_resource 的统计快照。
+ *
+ * 所有字段均为 32 位无符号整数，结构可平凡复制，可以直接 memcpy 进
+ * 遥测帧或 log_recorder 的记录。
+ */
+struct memory_stats {
+  /// 直方图分箱：[0,8]、(8,16]、…、(512,1024]、大于 1024
+  static constexpr std::size_t histogram_bins = 9;
+
+  uint32_t current_bytes{0};      // 当前未释放的字节数（按请求大小）
+  uint32_t peak_bytes{0};         // current_bytes 的历史最大值
+  uint32_t allocations{0};        // 成功分配次数（累计）
+  uint32_t deallocations{0};      // 释放次数（累计）
+  uint32_t failures{0};           // 上游返回 nullptr 的次数
+  uint32_t last_failure_bytes{0}; // 最近一次失败的请求大小
+  uint32_t largest_free_block{0}; // 上游最大空闲块；上游不支持查询时为 0
+  std::array<uint32_t, histogram_bins> histogram{}; // 按请求大小的分配次数
+};
+
+/// 上游资源能报告最大空闲块（TLSF 资源与 portable_resource）
+template <typename Resource>
+concept largest_free_block_query = requires(const Resource &r) {
+  { r.largest_free_block() } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * @brief 为任意 memory_resource 统计用量的装饰器。
+ *
+ * 所有请求原样转发给上游，同时记录当前与峰值字节数、分配/释放/失败
+ * 次数和按请求大小（2 的幂分箱）的直方图。内存耗尽不再只是现场的一次
+ * nullptr：峰值、失败次数与最大空闲块可以在运行时查询或周期上报，
+ * 提前发现余量不足与碎片化。
+ *
+ * 特性：
+ * - 每次分配/释放只多一个 CLZ 与几次加法，计数在保存/恢复 PRIMASK 的
+ *   临界区中更新（约十个周期），上游调用在临界区之外
+ * - 上游为 TLSF 资源或 portable_resource 时，stats() 同时给出上游
+ *   最大空闲块（遍历内存池，O(块数)，只应在查询时调用）
+ * - 模板参数由构造函数推导，std::pmr::memory_resource 也可作为上游
+ *
+ * 线程安全：计数本身可在任务与中断中并发更新；上游的线程安全性不变。
+ *
+ * 使用示例：
+ * @code
+ * gdut::pmr::portable_resource heap; // 无状态，等同于 get_instance()
+ * gdut::pmr::stats_resource heap_stats(heap);
+ * gdut::pmr::synchronized_tlsf_resource pool(&heap_stats, 2048);
+ *
+ * // 遥测任务中
+ * const gdut::pmr::memory_stats s = heap_stats.stats();
+ * telemetry_send(&s, sizeof(s));
+ * @endcode
+ */
+template <typename Upstream = std::pmr::memory_resource>
+  requires std::derived_from<Upstream, std::pmr::memory_resource>
+class stats_resource : public std::pmr::memory_resource {
+public:
+  explicit stats_resource(Upstream &upstream)
+      : m_upstream(std::addressof(upstream)) {}
+
+  stats_resource(const stats_resource &) = delete;
+  stats_resource &operator=(const stats_resource &) = delete;
+
+  [[nodiscard]] Upstream *upstream_resource() const { return m_upstream; }
+
+  /// 统计快照；largest_free_block 在临界区之外向上游查询
+  [[nodiscard]] memory_stats stats() const {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memory_stats snapshot = m_stats;
+    __set_PRIMASK(primask);
+    if constexpr (largest_free_block_query<Upstream>) {
+      snapshot.largest_free_block =
+          static_cast<uint32_t>(m_upstream->largest_free_block());
+    }
+    return snapshot;
+  }
+
+  /// 从当前用量重新开始记录峰值
+  void reset_peak() {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    m_stats.peak_bytes = m_stats.current_bytes;
+    __set_PRIMASK(primask);
+  }
+
+  /// 请求 bytes 字节计入的直方图分箱
+  [[nodiscard]] static constexpr std::size_t
+  histogram_bin(std::size_t bytes) noexcept {
+    if (bytes <= 8) {
+      return 0;
+    }
+    return std::min<std::size_t>(std::bit_width(bytes - 1) - 3,
+                                 memory_stats::histogram_bins - 1);
+  }
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    void *p = m_upstream->allocate(bytes, alignment);
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (p == nullptr) {
+      ++m_stats.failures;
+      m_stats.last_failure_bytes = static_cast<uint32_t>(bytes);
+    } else {
+      ++m_stats.allocations;
+      ++m_stats.histogram[histogram_bin(bytes)];
+      m_stats.current_bytes += static_cast<uint32_t>(bytes);
+      m_stats.peak_bytes =
+          std::max(m_stats.peak_bytes, m_stats.current_bytes);
+    }
+    __set_PRIMASK(primask);
+    return p;
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    m_upstream->deallocate(p, bytes, alignment);
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    ++m_stats.deallocations;
+    m_stats.current_bytes -= static_cast<uint32_t>(bytes);
+    __set_PRIMASK(primask);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == std::addressof(other);
+  }
+
+  Upstream *m_upstream{nullptr};
+  memory_stats m_stats{};
+};
+
+/**
+ * @brief 可在中断中使用的无锁固定块内存池。
+ *
+ * os_memory_pool_resource 以 osWaitForever 调用 osMemoryPoolAlloc，
+ * synchronized_tlsf_resource 需要获取互斥锁，二者都不能在中断中使用。
+ * 本类把 BlockCount 个 BlockSize 字节的块放在对象内部的静态缓冲区中，
+ * 以 Treiber 栈（无锁单链表栈）管理空闲块：分配弹出栈顶，释放压回
+ * 栈顶，每次只对链表头做一次 LDREX/STREX，不关中断、不阻塞，可在
+ * CAN/UART 中断与任务中同时调用。
+ *
+ * 链表头为 32 位：低 16 位为栈顶块的序号加 1（0 表示空），高 16 位为
+ * 每次修改都递增的标签。下一块的序号保存在独立的数组中，不写入块本身。
+ * Cortex-M4 上任何异常都会使 STREX 失败，ABA 已由硬件排除；标签保证
+ * 主机仿真（std::atomic 比较交换）中同样不会出现 ABA。
+ *
+ * 特性：
+ * - 分配/释放 O(1)，无锁、无等待以外的重试（只有被中断打断时才重试）
+ * - 块按 alignof(std::max_align_t) 对齐
+ * - try_allocate() 在池空时返回 nullptr；经 memory_resource 接口的
+ *   请求无法满足（池空、大于 BlockSize 或对齐要求更高）时不回退上游，
+ *   直接调用 std::terminate()
+ * - available() 给出当前空闲块数，min_available() 给出历史最小值
+ *
+ * 重要约束：
+ * - BlockCount 不超过 65535
+ * - 对象内含缓冲区；用作 DMA 缓冲区时不能放在 CCMRAM 中
+ * - -fno-exceptions 下 libstdc++ 的 memory_resource::allocate() 标注为
+ *   returns_nonnull，返回 nullptr 是未定义行为，因此 do_allocate() 失败时
+ *   显式终止；池可能耗尽的场合（尤其是中断中）请调用 try_allocate()
+ *   并检查 nullptr，请求大小可先用 fits() 检查
+ *
+ * 使用示例：
+ * @code
+ * gdut::pmr::lock_free_pool_resource<sizeof(can_message), 32> can_pool;
+ *
+ * void can_rx_isr(const can_message &msg) {
+ *   void *mem = can_pool.try_allocate();
+ *   if (mem != nullptr) {
+ *     rx_queue.put(new (mem) can_message(msg)); // 由任务处理后归还
+ *   }
+ * }
+ *
+ * void can_task_handle(can_message *msg) {
+ *   std::destroy_at(msg);
+ *   can_pool.deallocate(msg, sizeof(can_message), alignof(can_message));
+ * }
+ * @endcode
+ */
+template <std::size_t BlockSize, std::size_t BlockCount>
+class lock_free_pool_resource : public std::pmr::memory_resource {
+  static_assert(BlockSize > 0, "Block size must be greater than zero.");
+  static_assert(BlockCount > 0 && BlockCount <= 0xFFFF,
+                "Block count must be between 1 and 65535.");
+
+  static constexpr std::size_t alignment = alignof(std::max_align_t);
+  static constexpr std::size_t stride =
+      (BlockSize + alignment - 1) / alignment * alignment;
+  static constexpr uint32_t index_mask = 0xFFFFU;
+  static constexpr uint32_t tag_step = 0x10000U;
+
+public:
+  lock_free_pool_resource() : m_head(1U) {
+    for (std::size_t i = 0; i < BlockCount; ++i) {
+      m_next[i].store(static_cast<uint16_t>(i + 2 <= BlockCount ? i + 2 : 0),
+                      std::memory_order_relaxed);
+    }
+  }
+
+  lock_free_pool_resource(const lock_free_pool_resource &) = delete;
+  lock_free_pool_resource &operator=(const lock_free_pool_resource &) = delete;
+  lock_free_pool_resource(lock_free_pool_resource &&) = delete;
+  lock_free_pool_resource &operator=(lock_free_pool_resource &&) = delete;
+
+  static constexpr std::size_t block_size() { return BlockSize; }
+  static constexpr std::size_t block_count() { return BlockCount; }
+
+  /// 大小为 bytes、对齐为 align 的请求能否由一个块满足
+  [[nodiscard]] static constexpr bool fits(std::size_t bytes,
+                                           std::size_t align) noexcept {
+    return bytes > 0 && bytes <= BlockSize && align <= alignment;
+  }
+
+  /**
+   * @brief 弹出一个空闲块，池空时返回 nullptr（可在中断中调用）
+   *
+   * 不经过 std::pmr::memory_resource::allocate()，失败时不会终止程序。
+   */
+  [[nodiscard]] void *try_allocate() noexcept {
+    uint32_t head = 0;
+    uint32_t index = 0;
+    do {
+      head = m_head.load_exclusive();
+      index = head & index_mask;
+      if (index == 0U) {
+        m_head.clear_exclusive();
+        return nullptr;
+      }
+    } while (!m_head.store_exclusive(
+        head, ((head & ~index_mask) + tag_step) |
+                  m_next[index - 1U].load(std::memory_order_relaxed)));
+    update_available(-1);
+    return m_storage + (index - 1U) * stride;
+  }
+
+  /// 把块压回空闲栈（可在中断中调用）；不属于本池的指针被忽略
+  void release(void *p) noexcept {
+    if (!owns(p)) {
+      return;
+    }
+    const auto offset =
+        static_cast<std::size_t>(static_cast<std::byte *>(p) - m_storage);
+    const auto index = static_cast<uint32_t>(offset / stride + 1U);
+    uint32_t head = 0;
+    do {
+      head = m_head.load_exclusive();
+      m_next[index - 1U].store(static_cast<uint16_t>(head & index_mask),
+                               std::memory_order_relaxed);
+    } while (!m_head.store_exclusive(
+        head, ((head & ~index_mask) + tag_step) | index));
+    update_available(1);
+  }
+
+  [[nodiscard]] bool owns(const void *p) const noexcept {
+    const auto *b = static_cast<const std::byte *>(p);
+    return b >= m_storage && b < m_storage + sizeof(m_storage) &&
+           static_cast<std::size_t>(b - m_storage) % stride == 0U;
+  }
+
+  /// 当前空闲块数
+  [[nodiscard]] std::size_t available() const noexcept {
+    return m_available.load(std::memory_order_relaxed);
+  }
+
+  /// 空闲块数的历史最小值，用于确定 BlockCount 的余量
+  [[nodiscard]] std::size_t min_available() const noexcept {
+    return m_min_available.load(std::memory_order_relaxed);
+  }
+
+private:
+  void update_available(int delta) noexcept {
+    const uint32_t now =
+        m_available.fetch_add(static_cast<uint32_t>(delta),
+                              std::memory_order_relaxed) +
+        static_cast<uint32_t>(delta);
+    uint32_t low = m_min_available.load(std::memory_order_relaxed);
+    while (now < low && !m_min_available.compare_exchange_weak(
+                            low, now, std::memory_order_relaxed)) {
+    }
+  }
+
+  // allocate() 不允许返回 nullptr，失败时显式终止而不是留下未定义行为
+  void *do_allocate(size_t bytes, size_t align) override {
+    void *p = fits(bytes, align) ? try_allocate() : nullptr;
+    if (p == nullptr) {
+      std::terminate();
+    }
+    return p;
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t align) override {
+    (void)bytes; // 该实现忽略 bytes
+    (void)align; // 该实现忽略 alignment
+    release(p);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == std::addressof(other);
+  }
+
+  detail::exclusive_word m_head;
+  std::atomic<uint32_t> m_available{BlockCount};
+  std::atomic<uint32_t> m_min_available{BlockCount};
+  // 空闲块的下一块序号加 1；读取可能与释放并发，因此为原子类型
+  std::array<std::atomic<uint16_t>, BlockCount> m_next{};
+  alignas(alignment) std::byte m_storage[BlockCount * stride];
+};
+
+/// cycle_arena 的统计（单位：字节或次数）
+struct cycle_arena_stats {
+  uint32_t used{0};           // 本周期已从缓冲区分配的字节数（含对齐填充）
+  uint32_t peak_used{0};      // 各周期 used 的最大值
+  uint32_t cycles{0};         // reset() 的次数
+  uint32_t overflows{0};      // 缓冲区不足、转发给上游的分配次数
+  uint32_t overflow_bytes{0}; // 转发给上游的字节数（累计）
+  uint32_t failures{0};       // 上游也返回 nullptr 的次数
+};
+
+/**
+ * @brief 每个控制周期复位一次的单调（bump）内存资源。
+ *
+ * 控制与估计代码每个 1 ms 周期都要构造临时的 vector、矩阵；即使使用
+ * TLSF，每个临时对象一次分配加一次释放的开销仍然可观。cycle_arena 在
+ * 对象内部的固定缓冲区上顺序分配：分配只是对齐并移动游标，释放为空操作，
+ * 周期开始时调用 reset() 以 O(1) 收回本周期的全部内存。
+ *
+ * 缓冲区不足时请求转发给上游资源并计数，释放时按地址判断归属，上游的
+ * 内存照常归还上游。stats().overflows 不为 0 说明 Size 偏小。
+ *
+ * 调试：定义 GDUT_CYCLE_ARENA_POISON=1（CMake 在 Debug 构建中定义）时，
+ * reset() 用 poison_byte 填充本周期用过的部分。跨周期保留的指针（逃逸）
+ * 读到的 float 为 NaN、指针为 0xFFFFFFFF（访问即 HardFault），问题在
+ * 第一次误用时就会暴露，而不是在下一周期被新数据悄悄覆盖。
+ *
+ * 线程安全：不提供内部同步，只能由一个任务（控制任务）使用。
+ *
+ * 重要约束：
+ * - 分配出的内存只在本周期有效：reset() 之前必须销毁所有使用它的对象
+ * - 对象内含缓冲区，通常以 GDUT_CCMRAM 放在 CCM RAM（不能用于 DMA）
+ *
+ * 使用示例：
+ * @code
+ * GDUT_CCMRAM gdut::pmr::cycle_arena<8192> control_scratch;
+ *
+ * void attitude_loop() {
+ *   control_scratch.reset(); // 周期开始
+ *   std::pmr::vector<float> residual(12, &control_scratch);
+ *   std::pmr::vector<float> gain(36, &control_scratch);
+ *   ...
+ * } // 周期结束时容器销毁，释放为空操作
+ * @endcode
+ */
+template <std::size_t Size>
+class cycle_arena : public std::pmr::memory_resource {
+  static_assert(Size > 0, "Arena size must be greater than zero.");
+
+public:
+  /// 调试填充值：float 读为 NaN，指针读为 0xFFFFFFFF
+  static constexpr unsigned char poison_byte = 0xFF;
+
+  explicit cycle_arena(
+      memory_resource *upstream = portable_resource::get_instance())
+      : m_upstream_resource(upstream) {
+    if (m_upstream_resource == nullptr) {
+      m_upstream_resource = portable_resource::get_instance();
+    }
+  }
+
+  cycle_arena(const cycle_arena &) = delete;
+  cycle_arena &operator=(const cycle_arena &) = delete;
+  cycle_arena(cycle_arena &&) = delete;
+  cycle_arena &operator=(cycle_arena &&) = delete;
+
+  static constexpr std::size_t capacity() { return Size; }
+
+  /// 本周期已使用的字节数（含对齐填充）
+  [[nodiscard]] std::size_t used() const noexcept { return m_used; }
+
+  /**
+   * @brief 收回本周期从缓冲区分配的全部内存，在每个控制周期开始时调用
+   *
+   * O(1)；定义 GDUT_CYCLE_ARENA_POISON 时为 O(used)。转发给上游的
+   * 分配不受影响，仍由各自的 deallocate 归还。
+   */
+  void reset() noexcept {
+    m_stats.peak_used = std::max(m_stats.peak_used,
+                                 static_cast<uint32_t>(m_used));
+#if defined(GDUT_CYCLE_ARENA_POISON) && GDUT_CYCLE_ARENA_POISON
+    std::memset(m_buffer, poison_byte, m_used);
+#endif
+    m_used = 0;
+    ++m_stats.cycles;
+  }
+
+  [[nodiscard]] cycle_arena_stats stats() const noexcept {
+    cycle_arena_stats snapshot = m_stats;
+    snapshot.used = static_cast<uint32_t>(m_used);
+    snapshot.peak_used = std::max(snapshot.peak_used, snapshot.used);
+    return snapshot;
+  }
+
+  [[nodiscard]] bool owns(const void *p) const noexcept {
+    const auto *b = static_cast<const std::byte *>(p);
+    return b >= m_buffer && b < m_buffer + Size;
+  }
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    const auto base = reinterpret_cast<uintptr_t>(m_buffer);
+    const uintptr_t start =
+        (base + m_used + alignment - 1) & ~(uintptr_t{alignment} - 1);
+    const std::size_t end = start - base + bytes;
+    if (end <= Size) {
+      m_used = end;
+      return reinterpret_cast<void *>(start);
+    }
+    void *p = m_upstream_resource->allocate(bytes, alignment);
+    if (p == nullptr) {
+      ++m_stats.failures;
+    } else {
+      ++m_stats.overflows;
+      m_stats.overflow_bytes += static_cast<uint32_t>(bytes);
+    }
+    return p;
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    // 缓冲区内的内存在 reset() 时统一收回
+    if (p != nullptr && !owns(p)) {
+      m_upstream_resource->deallocate(p, bytes, alignment);
+    }
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == std::addressof(other);
+  }
+
+  memory_resource *m_upstream_resource{nullptr};
+  std::size_t m_used{0};
+  cycle_arena_stats m_stats{};
+  alignas(std::max_align_t) std::byte m_buffer[Size];
+};
+
 } // namespace gdut::pmr
 
 #endif // BSP_MEMORY_RESOURCE_HPP
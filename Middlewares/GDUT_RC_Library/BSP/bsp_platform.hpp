@@ -0,0 +1,81 @@
+#ifndef BSP_PLATFORM_HPP
+#define BSP_PLATFORM_HPP
+
+#include "bsp_uncopyable.hpp"
+
+#include <cstdint>
+
+#if defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__)
+#include "cmsis_os2.h"
+#include "stm32f4xx.h"
+#else
+#include <chrono>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace gdut {
+
+/**
+ * @brief 平台层：关中断临界区与任务延时
+ *
+ * 与寄存器无关的驱动逻辑（寄存器编排、帧解包、存储格式）只通过这里
+ * 屏蔽中断和延时，不直接包含 HAL/CMSIS 头文件，可以在主机上编译测试。
+ *
+ * - Cortex-M：interrupt_lock 保存并恢复 PRIMASK，延时使用 osDelay()
+ * - 主机：interrupt_lock 为进程内的递归互斥量，测试可以在另一个线程中
+ *   执行“中断”路径；延时使用 std::this_thread::sleep_for()
+ *
+ * 使用示例：
+ * @code
+ * {
+ *   gdut::interrupt_lock lock;
+ *   ++shared_counter; // 与中断共享的数据
+ * }
+ * gdut::delay_ms(5);
+ * @endcode
+ */
+#if defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__)
+class interrupt_lock : uncopyable {
+public:
+  interrupt_lock() noexcept : m_primask(__get_PRIMASK()) { __disable_irq(); }
+  ~interrupt_lock() noexcept { __set_PRIMASK(m_primask); }
+
+private:
+  uint32_t m_primask;
+};
+
+/// 阻塞当前任务至少 ms 毫秒（仅任务上下文）
+inline void delay_ms(uint32_t ms) {
+  const uint32_t ticks = (ms * osKernelGetTickFreq() + 999U) / 1000U;
+  // 第一个节拍不完整，多等待一个节拍保证下限
+  (void)osDelay(ticks + 1U);
+}
+
+/// 让出 CPU 到下一个系统节拍（仅任务上下文），用于轮询等待
+inline void delay_tick() { (void)osDelay(1); }
+#else
+class interrupt_lock : uncopyable {
+public:
+  interrupt_lock() { mutex().lock(); }
+  ~interrupt_lock() { mutex().unlock(); }
+
+private:
+  static std::recursive_mutex &mutex() {
+    static std::recursive_mutex instance;
+    return instance;
+  }
+};
+
+inline void delay_ms(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+inline void delay_tick() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+#endif
+
+} // namespace gdut
+
+#endif // BSP_PLATFORM_HPP
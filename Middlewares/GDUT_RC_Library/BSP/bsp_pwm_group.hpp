@@ -0,0 +1,287 @@
+#ifndef BSP_PWM_GROUP_HPP
+#define BSP_PWM_GROUP_HPP
+
+#include "bsp_dma.hpp"
+#include "bsp_timer.hpp"
+#include "bsp_uncopyable.hpp"
+#include "stm32f4xx_hal.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gdut {
+
+/**
+ * @brief 以一次 TIM DMA 突发（DCR/DMAR）同时更新多个 PWM 通道的比较值
+ *
+ * timer_pwm::set_duty() 逐个写 CCRx，同一组舵机/电调的多个通道在不同
+ * 时刻生效，可能跨越一个 PWM 周期。pwm_group 先把各通道的比较值暂存在
+ * 对象内，commit() 后由更新事件触发一次 DMA 突发，把全部 CCR 一起写入
+ * 预装载寄存器，下一个更新事件所有通道同时切换。
+ *
+ * 特性：
+ * - 通道列表为模板参数，DCR（DBA/DBL）在编译期确定
+ * - 每次突发只有一次 DMA 完成中断，写 CCR 不占用 CPU
+ * - 一个 PWM 周期内多次 commit() 只发出一次突发，使用最后一次提交的值；
+ *   等待中的突发以新值重新启动，不会先写入旧值
+ *
+ * 线程安全：
+ * - set()/commit() 只能由同一个任务（或同一个中断）调用
+ * - commit() 与 DMA 完成中断之间以保存/恢复 PRIMASK 的临界区同步
+ *
+ * 重要约束：
+ * - Channels 须为连续递增的 TIM_CHANNEL_x（CCR1~CCR4 在寄存器中连续）
+ * - 更新事件的 DMA（htim->hdma[TIM_DMA_ID_UPDATE]，CubeMX 中为 TIMx_UP）
+ *   须配置为：存储器到外设、普通模式、存储器地址递增、外设与存储器数据
+ *   宽度均为字（Word），并使能 DMA 中断；start() 检查这些配置
+ * - 同一定时器的 DCR 只能由一个 pwm_group 使用
+ * - 对象内含 DMA 缓冲区，不能定义在 CCMRAM 中
+ *
+ * 使用示例：
+ * @code
+ * gdut::timer esc_timer(&htim1);
+ * gdut::pwm_group<TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4>
+ *     escs(esc_timer);
+ *
+ * escs.start();
+ *
+ * // 控制回路
+ * escs.set({1100, 1250, 1250, 1100});
+ * escs.commit(); // 下一个 PWM 周期四路同时生效
+ * @endcode
+ */
+template <uint32_t... Channels> class pwm_group : uncopyable {
+public:
+  static constexpr std::size_t size = sizeof...(Channels);
+  static constexpr std::array<uint32_t, size> channels{Channels...};
+
+private:
+  static constexpr bool consecutive() {
+    for (std::size_t i = 0; i < size; ++i) {
+      if (channels[i] != channels[0] + 4U * i) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static_assert(size >= 1 && size <= 4, "pwm_group takes 1 to 4 channels");
+  static_assert(channels[0] <= TIM_CHANNEL_4 && channels[0] % 4U == 0U &&
+                    consecutive() && channels[size - 1] <= TIM_CHANNEL_4,
+                "Channels must be consecutive ascending TIM_CHANNEL_x");
+
+  static constexpr uint32_t first_index = channels[0] / 4U;
+  // DBA 从 CCRx 开始，DBL 为 size 次传输
+  static constexpr uint32_t dcr = (TIM_DMABASE_CCR1 + first_index) |
+                                  ((static_cast<uint32_t>(size) - 1U) << 8U);
+
+  static constexpr std::size_t index_of(uint32_t channel) {
+    return (channel - channels[0]) / 4U;
+  }
+
+public:
+  explicit pwm_group(timer &tim) : m_htim(tim.get_htim()) {
+    if (m_htim != nullptr) {
+      m_hdma = m_htim->hdma[TIM_DMA_ID_UPDATE];
+    }
+  }
+
+  ~pwm_group() noexcept { stop(); }
+
+  [[nodiscard]] bool valid() const noexcept {
+    return m_htim != nullptr && m_hdma != nullptr;
+  }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /**
+   * @brief 启动所有通道的 PWM 输出并配置 DMA 突发
+   *
+   * 暂存值初始化为各通道当前的 CCR，并为各通道开启比较值预装载。
+   *
+   * @return DMA 配置不符合要求或缓冲区位于 CCMRAM 时返回 HAL_ERROR
+   */
+  HAL_StatusTypeDef start() {
+    if (!valid()) {
+      return HAL_ERROR;
+    }
+    const DMA_InitTypeDef &init = m_hdma->Init;
+    if (init.Direction != DMA_MEMORY_TO_PERIPH ||
+        init.Mode != DMA_NORMAL || init.MemInc != DMA_MINC_ENABLE ||
+        init.PeriphDataAlignment != DMA_PDATAALIGN_WORD ||
+        init.MemDataAlignment != DMA_MDATAALIGN_WORD ||
+        !check_dma_buffer(m_burst.data())) {
+      return HAL_ERROR;
+    }
+
+    TIM_TypeDef *tim = m_htim->Instance;
+    const volatile uint32_t *ccr = &tim->CCR1 + first_index;
+    for (std::size_t i = 0; i < size; ++i) {
+      m_staged[i] = ccr[i];
+      // OCxPE：突发写入预装载寄存器，更新事件时统一生效
+      const std::size_t index = first_index + i;
+      volatile uint32_t &ccmr = index < 2U ? tim->CCMR1 : tim->CCMR2;
+      ccmr |= index % 2U != 0U ? TIM_CCMR1_OC2PE : TIM_CCMR1_OC1PE;
+    }
+    m_committed = m_staged;
+    m_in_flight = false;
+    m_dirty = false;
+
+    tim->DCR = dcr;
+    m_hdma->Parent = this;
+    m_hdma->XferCpltCallback = &pwm_group::burst_cplt_cb;
+    m_hdma->XferHalfCpltCallback = nullptr;
+    m_hdma->XferErrorCallback = &pwm_group::burst_cplt_cb;
+
+    for (uint32_t channel : channels) {
+      HAL_StatusTypeDef status = HAL_TIM_PWM_Start(m_htim, channel);
+      if (status != HAL_OK) {
+        return status;
+      }
+    }
+    return HAL_OK;
+  }
+
+  HAL_StatusTypeDef stop() {
+    if (!valid()) {
+      return HAL_ERROR;
+    }
+    if (m_hdma->Parent != this) {
+      return HAL_OK; // 未启动
+    }
+    __HAL_TIM_DISABLE_DMA(m_htim, TIM_DMA_UPDATE);
+    (void)HAL_DMA_Abort(m_hdma);
+    m_hdma->XferCpltCallback = nullptr;
+    m_hdma->XferErrorCallback = nullptr;
+    m_hdma->Parent = nullptr;
+    m_in_flight = false;
+    HAL_StatusTypeDef result = HAL_OK;
+    for (uint32_t channel : channels) {
+      if (HAL_TIM_PWM_Stop(m_htim, channel) != HAL_OK) {
+        result = HAL_ERROR;
+      }
+    }
+    return result;
+  }
+
+  /// 暂存第 index 个通道（按 Channels 的顺序）的比较值，commit() 前不生效
+  void set(std::size_t index, uint32_t compare) noexcept {
+    if (index < size) {
+      m_staged[index] = compare;
+    }
+  }
+
+  /// 按通道号暂存比较值，通道须在 Channels 中（编译期检查）
+  template <uint32_t Channel> void set(uint32_t compare) noexcept {
+    static_assert(Channel >= channels[0] && Channel <= channels[size - 1] &&
+                      Channel % 4U == 0U,
+                  "Channel is not part of this pwm_group");
+    m_staged[index_of(Channel)] = compare;
+  }
+
+  /// 暂存全部通道的比较值
+  void set(const std::array<uint32_t, size> &compares) noexcept {
+    m_staged = compares;
+  }
+
+  [[nodiscard]] uint32_t staged(std::size_t index) const noexcept {
+    return index < size ? m_staged[index] : 0U;
+  }
+
+  /**
+   * @brief 提交暂存的比较值，下一个更新事件起全部通道同时生效
+   *
+   * 上一次提交的突发还在等待更新事件（一个字都没有传输）时，关闭
+   * 更新 DMA 请求、中止数据流并以新值重新启动，旧值不会被写入。
+   * 突发已经开始传输时只记录新值，由完成中断再发出一次突发，新值
+   * 晚一个 PWM 周期生效。
+   *
+   * @return 未启动或 DMA 启动失败返回 HAL_ERROR
+   */
+  HAL_StatusTypeDef commit() noexcept {
+    if (!valid() || m_hdma->Parent != this) {
+      return HAL_ERROR;
+    }
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    m_committed = m_staged;
+    if (!m_in_flight) {
+      status = launch();
+    } else if (burst_waiting()) {
+      // 数据流在使能时已预读第一个字，只改写 m_burst 不够
+      (void)HAL_DMA_Abort(m_hdma);
+      m_in_flight = false;
+      status = launch();
+    } else {
+      // 突发已经开始：完成中断中以最新的值再发出一次突发
+      m_dirty = true;
+    }
+    __set_PRIMASK(primask);
+    return status;
+  }
+
+  /// 是否有已提交但尚未写入定时器的比较值
+  [[nodiscard]] bool busy() const noexcept { return m_in_flight; }
+
+private:
+  /// 以 m_committed 装填突发缓冲区并等待下一个更新事件，调用时须已关中断
+  HAL_StatusTypeDef launch() noexcept {
+    m_burst = m_committed;
+    m_dirty = false;
+    HAL_StatusTypeDef status = HAL_DMA_Start_IT(
+        m_hdma, reinterpret_cast<uint32_t>(m_burst.data()),
+        reinterpret_cast<uint32_t>(&m_htim->Instance->DMAR),
+        static_cast<uint32_t>(size));
+    if (status != HAL_OK) {
+      return status;
+    }
+    m_in_flight = true;
+    // 更新事件产生 DMA 请求，定时器按 DBL 连续请求 size 次
+    __HAL_TIM_ENABLE_DMA(m_htim, TIM_DMA_UPDATE);
+    return HAL_OK;
+  }
+
+  /**
+   * @brief 进行中的突发是否还在等待更新事件，调用时须已关中断
+   *
+   * 先关闭 UDE，之后定时器不再发出新的请求；读回 DIER 保证关闭已经
+   * 生效，此时 NDTR 仍等于突发长度说明没有任何字写入 DMAR。
+   *
+   * @return true 时 UDE 保持关闭；突发已经开始传输（或已完成、完成
+   *         中断待处理）时返回 false，UDE 恢复
+   */
+  bool burst_waiting() noexcept {
+    TIM_TypeDef *tim = m_htim->Instance;
+    tim->DIER &= ~TIM_DIER_UDE;
+    (void)tim->DIER;
+    if (__HAL_DMA_GET_COUNTER(m_hdma) == size) {
+      return true;
+    }
+    tim->DIER |= TIM_DIER_UDE;
+    return false;
+  }
+
+  static void burst_cplt_cb(DMA_HandleTypeDef *hdma) {
+    auto *self = static_cast<pwm_group *>(hdma->Parent);
+    // 关闭更新 DMA 请求，避免下一次启动时处理残留的请求
+    __HAL_TIM_DISABLE_DMA(self->m_htim, TIM_DMA_UPDATE);
+    self->m_in_flight = false;
+    if (self->m_dirty) {
+      (void)self->launch();
+    }
+  }
+
+  TIM_HandleTypeDef *m_htim{nullptr};
+  DMA_HandleTypeDef *m_hdma{nullptr};
+  std::array<uint32_t, size> m_staged{};    // 任务写入
+  std::array<uint32_t, size> m_committed{}; // 已提交，临界区内访问
+  std::array<uint32_t, size> m_burst{};     // DMA 读取
+  volatile bool m_in_flight{false};
+  bool m_dirty{false};
+};
+
+} // namespace gdut
+
+#endif // BSP_PWM_GROUP_HPP
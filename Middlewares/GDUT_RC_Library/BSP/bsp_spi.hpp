@@ -9,9 +9,18 @@
 #include "stm32f4xx_hal_spi.h"
 #include <chrono>
 #include <cstdint>
+#include <span>
 
 namespace gdut {
 
+/**
+ * @brief dma_spi::receive() 在接收期间向 MOSI 发送的内容
+ */
+enum class spi_receive_mode : uint8_t {
+  in_place, ///< 原地全双工：发送接收缓冲区原有内容，再被接收数据覆盖
+  dummy     ///< 哑字节：从单个字反复发送固定字节（TX DMA 存储器地址不递增）
+};
+
 /**
  * @brief 针对 SPI 外设的 DMA 操作封装
  *
@@ -19,7 +28,19 @@ namespace gdut {
  * 并手动配置 DMA 发起传输。传输完成或出错时，由内部静态回调恢复 SPI HAL 状态
  * 后再通过 dma_proxy::call_dma_callback() 转发用户回调。
  *
+ * 接收有三种方式：
+ * - receive()：默认原地全双工（spi_receive_mode::in_place）；
+ *   set_receive_mode(spi_receive_mode::dummy) 后改为发送哑字节，
+ *   大块读取既不需要额外缓冲区也不需要预先填充
+ * - transmit_receive(tx, rx)：发送与接收使用独立缓冲区的真全双工
+ * - transmit_receive({}, rx)：等价于哑字节模式的 receive()
+ *
+ * transmit_discard(tx) 是以全双工方式实现的纯发送，完成由 RX 代理上报，
+ * 此时最后一个字节已经移出。
+ *
  * @note address 参数对 SPI 无意义，所有传输均忽略该参数。
+ * @note 哑字节发送需要 TX 代理通过 bind_tx() 绑定（走预备传输快速路径），
+ *       仅由 CubeMX 链接 hdmatx 时哑字节接收返回 false。
  * @note 不直接调用 HAL_SPI_Transmit_DMA / HAL_SPI_TransmitReceive_DMA，
  *       以防止 HAL 内部覆盖 dma_proxy 已注册的回调函数。
  */
@@ -32,17 +53,50 @@ public:
   dma_spi(dma_spi &&other) noexcept
       : m_spi(std::exchange(other.m_spi, nullptr)),
         m_tx_dma(std::exchange(other.m_tx_dma, nullptr)),
-        m_rx_dma(std::exchange(other.m_rx_dma, nullptr)) {}
+        m_rx_dma(std::exchange(other.m_rx_dma, nullptr)),
+        m_dummy_word(other.m_dummy_word),
+        m_receive_mode(other.m_receive_mode) {}
 
   dma_spi &operator=(dma_spi &&other) noexcept {
     if (this != std::addressof(other)) {
       m_spi = std::exchange(other.m_spi, nullptr);
       m_tx_dma = std::exchange(other.m_tx_dma, nullptr);
       m_rx_dma = std::exchange(other.m_rx_dma, nullptr);
+      m_dummy_word = other.m_dummy_word;
+      m_receive_mode = other.m_receive_mode;
     }
     return *this;
   }
 
+  void set_receive_mode(spi_receive_mode mode) { m_receive_mode = mode; }
+
+  [[nodiscard]] spi_receive_mode get_receive_mode() const noexcept {
+    return m_receive_mode;
+  }
+
+  /// 设置哑字节模式下发送的字节（默认 0xFF）
+  void set_dummy_byte(uint8_t value) {
+    m_dummy_word = 0x01010101U * value;
+  }
+
+  /**
+   * @brief 只发送 tx，接收到的字节全部写入对象内的同一个丢弃字节
+   *        （RX DMA 存储器地址不递增）
+   *
+   * 完成与错误由 RX 代理上报：RX DMA 收到最后一个字节时它已完整移出，
+   * 调用方无需轮询 TXE/BSY 即可拉高片选或开始下一次传输，
+   * 接收端也不会残留数据或置位 OVR。
+   */
+  bool transmit_discard(std::span<const uint8_t> tx) {
+    // 丢弃字节随对象存放，对象位于 CCMRAM（如任务栈）时 DMA 无法写入
+    if (!check_dma_buffer(&m_discard_word)) {
+      return false;
+    }
+    return start_full_duplex(tx.data(), true,
+                             reinterpret_cast<uint8_t *>(&m_discard_word),
+                             tx.size(), false);
+  }
+
 private:
   friend class dma_transfer_base<dma_spi>;
 
@@ -79,8 +133,10 @@ private:
       return false;
     }
 
-    // 初始化 DMA 代理（调用 HAL_DMA_Init 初始化 DMA 句柄）
-    m_tx_dma->init();
+    // 准备 DMA 代理（仅首次或配置变更后调用 HAL_DMA_Init）
+    if (!m_tx_dma->prepare()) {
+      return false;
+    }
 
     // 覆盖 DMA 句柄的 Parent 与完成/错误回调，以便在 DMA 中断里恢复 SPI 状态
     // 并通过 dma_proxy::call_dma_callback() 转发到用户回调。
@@ -123,8 +179,7 @@ private:
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_spi->pTxBuffPtr));
     const auto dst_addr = static_cast<uint32_t>(
         reinterpret_cast<uintptr_t>(&m_spi->Instance->DR));
-    if (HAL_OK !=
-        HAL_DMA_Start_IT(hdma_tx, src_addr, dst_addr, m_spi->TxXferCount)) {
+    if (HAL_OK != m_tx_dma->launch(src_addr, dst_addr, m_spi->TxXferCount)) {
       SET_BIT(m_spi->ErrorCode, HAL_SPI_ERROR_DMA);
       m_spi->State = HAL_SPI_STATE_READY;
       m_spi->TxXferCount = 0U;
@@ -147,9 +202,44 @@ private:
   bool do_receive(uint8_t *buffer, std::size_t size, uint16_t address) {
     (void)address; // SPI 不使用地址参数，忽略以避免编译器警告
 
+    if (m_receive_mode == spi_receive_mode::dummy) {
+      return start_dummy_receive(buffer, size);
+    }
+    return start_full_duplex(buffer, true, buffer, size);
+  }
+
+  bool do_transmit_receive(std::span<const uint8_t> tx,
+                           std::span<uint8_t> rx) {
+    if (tx.empty()) {
+      return start_dummy_receive(rx.data(), rx.size());
+    }
+    if (tx.size() != rx.size()) {
+      return false;
+    }
+    return start_full_duplex(tx.data(), true, rx.data(), rx.size());
+  }
+
+  bool start_dummy_receive(uint8_t *buffer, std::size_t size) {
+    // 哑字节所在的字随对象存放，对象位于 CCMRAM（如任务栈）时 DMA 无法读取
+    if (!check_dma_buffer(&m_dummy_word)) {
+      return false;
+    }
+    return start_full_duplex(reinterpret_cast<const uint8_t *>(&m_dummy_word),
+                             false, buffer, size);
+  }
+
+  /**
+   * 全双工 DMA 收发的公共实现。
+   * @param tx_increment  为 false 时 TX DMA 存储器地址不递增，反复发送
+   *                      tx 指向的同一个字节
+   * @param rx_increment  为 false 时 RX DMA 存储器地址不递增，接收数据
+   *                      全部写入 buffer 指向的同一个字节
+   */
+  bool start_full_duplex(const uint8_t *tx, bool tx_increment, uint8_t *buffer,
+                         std::size_t size, bool rx_increment = true) {
     // 传输大小超过 HAL uint16_t 范围则拒绝，避免截断导致错误传输
-    if (m_spi == nullptr || m_rx_dma == nullptr || buffer == nullptr ||
-        size == 0U || size > 65535U) {
+    if (m_spi == nullptr || m_rx_dma == nullptr || tx == nullptr ||
+        buffer == nullptr || size == 0U || size > 65535U) {
       return false;
     }
 
@@ -170,8 +260,19 @@ private:
       return false;
     }
 
-    // 初始化 RX DMA 代理（调用 HAL_DMA_Init 初始化 DMA 句柄）
-    m_rx_dma->init();
+    // TX 句柄由 bind_tx() 绑定时走快速路径，否则（仅由 CubeMX 链接）退回
+    // HAL；HAL_DMA_Start_IT 无法临时关闭存储器递增，哑字节发送要求快速路径
+    const bool tx_fast = m_tx_dma != nullptr &&
+                         m_tx_dma->get_handle() == m_spi->hdmatx &&
+                         m_tx_dma->prepare();
+    if (!tx_fast && !tx_increment) {
+      return false;
+    }
+
+    // 准备 RX DMA 代理（仅首次或配置变更后调用 HAL_DMA_Init）
+    if (!m_rx_dma->prepare()) {
+      return false;
+    }
 
     // 覆盖 RX DMA 句柄的 Parent 与完成/错误回调，以便在 DMA 中断里恢复 SPI 状态
     // 并通过 dma_proxy::call_dma_callback() 转发到用户回调。
@@ -194,7 +295,7 @@ private:
 
     // 参考 HAL_SPI_TransmitReceive_DMA 内部实现，手动配置 SPI 状态与 DMA
     m_spi->ErrorCode = HAL_SPI_ERROR_NONE;
-    m_spi->pTxBuffPtr = buffer;
+    m_spi->pTxBuffPtr = const_cast<uint8_t *>(tx);
     m_spi->TxXferSize = static_cast<uint16_t>(size);
     m_spi->TxXferCount = static_cast<uint16_t>(size);
     m_spi->pRxBuffPtr = buffer;
@@ -213,8 +314,8 @@ private:
         reinterpret_cast<uintptr_t>(&m_spi->Instance->DR));
     const auto rx_dst_addr =
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_spi->pRxBuffPtr));
-    if (HAL_OK != HAL_DMA_Start_IT(hdma_rx, rx_src_addr, rx_dst_addr,
-                                   m_spi->RxXferCount)) {
+    if (HAL_OK != m_rx_dma->launch(rx_src_addr, rx_dst_addr,
+                                   m_spi->RxXferCount, rx_increment)) {
       SET_BIT(m_spi->ErrorCode, HAL_SPI_ERROR_DMA);
       m_spi->State = HAL_SPI_STATE_READY;
       __HAL_UNLOCK(m_spi);
@@ -236,8 +337,12 @@ private:
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_spi->pTxBuffPtr));
     const auto tx_dst_addr = static_cast<uint32_t>(
         reinterpret_cast<uintptr_t>(&m_spi->Instance->DR));
-    if (HAL_OK != HAL_DMA_Start_IT(m_spi->hdmatx, tx_src_addr, tx_dst_addr,
-                                   m_spi->TxXferCount)) {
+    const HAL_StatusTypeDef tx_status =
+        tx_fast ? m_tx_dma->launch(tx_src_addr, tx_dst_addr, m_spi->TxXferCount,
+                                   tx_increment)
+                : HAL_DMA_Start_IT(m_spi->hdmatx, tx_src_addr, tx_dst_addr,
+                                   m_spi->TxXferCount);
+    if (HAL_OK != tx_status) {
       // TX DMA 启动失败，回滚已启动的 RX DMA 以避免外设处于不一致状态
       (void)HAL_DMA_Abort(hdma_rx);
       CLEAR_BIT(m_spi->Instance->CR2, SPI_CR2_RXDMAEN);
@@ -284,8 +389,20 @@ private:
           std::error_code(hdma->ErrorCode, dma_error_category::instance()));
   }
 
-  // RX DMA 传输完成回调（全双工）：清除 TXDMAEN/RXDMAEN 位、恢复 SPI
-  // State，然后转发用户回调
+  // 结束全双工的 TX 数据流。RX 收到最后一个字节时 TX 早已搬完全部数据，
+  // 但 TX 的 TC 中断属于另一个数据流中断，可能尚未执行，句柄仍为 BUSY，
+  // 回调中立即启动的下一次传输会以 HAL_BUSY 失败。HAL_DMA_Abort 关闭
+  // 数据流中断、清除标志并把句柄恢复为 READY，之后挂起的 TX 中断在
+  // HAL_DMA_IRQHandler 中找不到标志，不再回调
+  void release_tx_stream() {
+    DMA_HandleTypeDef *hdma_tx = m_spi->hdmatx;
+    if (hdma_tx != nullptr && hdma_tx->State == HAL_DMA_STATE_BUSY) {
+      (void)HAL_DMA_Abort(hdma_tx);
+    }
+  }
+
+  // RX DMA 传输完成回调（全双工）：清除 TXDMAEN/RXDMAEN 位、结束 TX
+  // 数据流并恢复 SPI State，然后转发用户回调
   static void rx_dma_cplt_cb(DMA_HandleTypeDef *hdma) {
     if (!hdma)
       return;
@@ -294,13 +411,14 @@ private:
       return;
     ATOMIC_CLEAR_BIT(self->m_spi->Instance->CR2,
                      SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+    self->release_tx_stream();
     self->m_spi->State = HAL_SPI_STATE_READY;
     if (self->m_rx_dma)
       self->m_rx_dma->call_dma_callback({});
   }
 
-  // RX DMA 错误回调（全双工）：清除 TXDMAEN/RXDMAEN 位、恢复 SPI
-  // State，然后上报错误
+  // RX DMA 错误回调（全双工）：清除 TXDMAEN/RXDMAEN 位、中止另一个
+  // 数据流并恢复 SPI State，然后上报错误
   static void rx_dma_error_cb(DMA_HandleTypeDef *hdma) {
     if (!hdma)
       return;
@@ -309,6 +427,12 @@ private:
       return;
     ATOMIC_CLEAR_BIT(self->m_spi->Instance->CR2,
                      SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+    // 本回调同时挂在 TX 与 RX 句柄上，出错的数据流已由 HAL 关闭
+    self->release_tx_stream();
+    if (self->m_spi->hdmarx != nullptr &&
+        self->m_spi->hdmarx->State == HAL_DMA_STATE_BUSY) {
+      (void)HAL_DMA_Abort(self->m_spi->hdmarx);
+    }
     SET_BIT(self->m_spi->ErrorCode, HAL_SPI_ERROR_DMA);
     self->m_spi->State = HAL_SPI_STATE_READY;
     if (self->m_rx_dma)
@@ -319,6 +443,9 @@ private:
   SPI_HandleTypeDef *m_spi{nullptr};
   dma_proxy *m_tx_dma{nullptr};
   dma_proxy *m_rx_dma{nullptr};
+  uint32_t m_dummy_word{0xFFFFFFFFU}; // 哑字节发送源，DMA 按字节读取首字节
+  uint32_t m_discard_word{0U};        // transmit_discard() 的接收目标
+  spi_receive_mode m_receive_mode{spi_receive_mode::in_place};
 };
 
 // SPI 代理类：封装 HAL SPI 阻塞式传输/接收操作，支持 C++20 chrono 超时
@@ -0,0 +1,241 @@
+#include "bsp_spi_bus.hpp"
+
+namespace gdut {
+
+spi_bus::spi_bus(SPI_HandleTypeDef *hspi, dma_proxy *tx_dma,
+                 dma_proxy *rx_dma)
+    : m_hspi(hspi), m_tx_dma(tx_dma), m_rx_dma(rx_dma), m_dma(hspi) {
+  if (hspi == nullptr || tx_dma == nullptr || rx_dma == nullptr ||
+      tx_dma->get_handle() == nullptr || rx_dma->get_handle() == nullptr) {
+    m_hspi = nullptr;
+    m_tx_dma = nullptr;
+    m_rx_dma = nullptr;
+    return;
+  }
+
+  m_dma.bind(tx_dma, rx_dma);
+  // 接收阶段发送哑字节，调用方无需预先填充接收缓冲区
+  m_dma.set_receive_mode(spi_receive_mode::dummy);
+  // 发送阶段与接收阶段都以全双工 DMA 执行，完成与错误统一由 RX 代理上报
+  rx_dma->set_callback_handler([this](std::error_code ec) { on_dma_done(ec); });
+}
+
+spi_bus::~spi_bus() noexcept {
+  if (!valid()) {
+    return;
+  }
+
+  // 先断开中断到本对象的所有路径：之后即使数据流中断已挂起，
+  // HAL_DMA_IRQHandler 也只清除标志，不再回调 dma_spi / spi_bus
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  m_phase = bus_phase::idle;
+  CLEAR_BIT(m_hspi->Instance->CR2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+  for (dma_proxy *proxy : {m_tx_dma, m_rx_dma}) {
+    DMA_HandleTypeDef *hdma = proxy->get_handle();
+    hdma->XferCpltCallback = nullptr;
+    hdma->XferHalfCpltCallback = nullptr;
+    hdma->XferErrorCallback = nullptr;
+    hdma->XferAbortCallback = nullptr;
+    hdma->Parent = nullptr;
+  }
+  m_rx_dma->set_callback_handler(callback_t{});
+  const bool busy = m_busy;
+  m_busy = false;
+  __set_PRIMASK(primask);
+
+  // 中止仍在运行的数据流（HAL_DMA_Abort 等待 EN 清零并清除中断标志）
+  for (dma_proxy *proxy : {m_tx_dma, m_rx_dma}) {
+    DMA_HandleTypeDef *hdma = proxy->get_handle();
+    if (hdma->State == HAL_DMA_STATE_BUSY) {
+      (void)HAL_DMA_Abort(hdma);
+    }
+  }
+  m_hspi->State = HAL_SPI_STATE_READY;
+  if (busy) {
+    m_current.device->deselect();
+  }
+}
+
+bool spi_bus::submit(spi_transaction &&transaction) {
+  const auto level = std::to_underlying(transaction.priority);
+  // NDTR 为 16 位
+  if (!valid() || transaction.device == nullptr ||
+      transaction.device->m_bus != this || level >= priority_count ||
+      transaction.tx.size() > 0xFFFFU || transaction.rx.size() > 0xFFFFU) {
+    return false;
+  }
+  if (transaction.mode == spi_transfer_mode::full_duplex &&
+      (transaction.tx.empty() ||
+       transaction.tx.size() != transaction.rx.size())) {
+    return false;
+  }
+  if ((!transaction.tx.empty() && !check_dma_buffer(transaction.tx.data())) ||
+      (!transaction.rx.empty() && !check_dma_buffer(transaction.rx.data()))) {
+    return false;
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  bool start = false;
+  if (!m_busy) {
+    // 总线空闲时队列必然为空，直接成为当前事务
+    m_current = std::move(transaction);
+    m_busy = true;
+    start = true;
+  } else {
+    priority_queue &queue = m_queues[level];
+    if (queue.count >= queue_depth) {
+      __set_PRIMASK(primask);
+      return false;
+    }
+    queue.slots[(queue.head + queue.count) % queue_depth] =
+        std::move(transaction);
+    queue.count = queue.count + 1U;
+  }
+  __set_PRIMASK(primask);
+
+  if (start) {
+    start_current();
+  }
+  return true;
+}
+
+std::error_code spi_bus::transfer(spi_transaction &&transaction) {
+  struct wait_state {
+    std::error_code result;
+    osThreadId_t waiter;
+  } state{{}, osThreadGetId()};
+
+  transaction.callback = [&state](std::error_code ec) {
+    state.result = ec;
+    (void)osThreadFlagsSet(state.waiter, wait_flag);
+  };
+  (void)osThreadFlagsClear(wait_flag);
+  if (!submit(std::move(transaction))) {
+    return std::make_error_code(std::errc::resource_unavailable_try_again);
+  }
+  (void)osThreadFlagsWait(wait_flag, osFlagsWaitAny, osWaitForever);
+  return state.result;
+}
+
+std::size_t spi_bus::pending() const noexcept {
+  std::size_t count = 0;
+  for (const priority_queue &queue : m_queues) {
+    count += queue.count;
+  }
+  return count;
+}
+
+bool spi_bus::pop_next() {
+  // 从最高优先级开始查找
+  for (std::size_t level = priority_count; level-- > 0U;) {
+    priority_queue &queue = m_queues[level];
+    if (queue.count != 0U) {
+      m_current = std::move(queue.slots[queue.head]);
+      queue.head = (queue.head + 1U) % queue_depth;
+      queue.count = queue.count - 1U;
+      return true;
+    }
+  }
+  return false;
+}
+
+void spi_bus::start_current() {
+  const spi_device *device = m_current.device;
+  // 先配置时钟极性再拉低片选，保证片选有效时 SCK 空闲电平已正确
+  configure(device);
+  device->select();
+
+  if (m_current.mode == spi_transfer_mode::full_duplex) {
+    // 全双工由 RX DMA 完成上报，直接进入接收阶段
+    m_phase = bus_phase::receive;
+    if (!m_dma.transmit_receive(m_current.tx, m_current.rx)) {
+      finish(std::make_error_code(std::errc::device_or_resource_busy));
+    }
+    return;
+  }
+  if (m_current.tx.empty()) {
+    start_receive();
+    return;
+  }
+  // 纯发送同样以全双工执行（接收字节丢弃），由 RX DMA 上报完成，
+  // 此时最后一个字节已经移出，无需在中断中等待 BSY
+  m_phase = bus_phase::transmit;
+  if (!m_dma.transmit_discard(m_current.tx)) {
+    finish(std::make_error_code(std::errc::device_or_resource_busy));
+  }
+}
+
+void spi_bus::start_receive() {
+  if (m_current.rx.empty()) {
+    finish({});
+    return;
+  }
+  m_phase = bus_phase::receive;
+  if (!m_dma.receive(m_current.rx.data(), m_current.rx.size())) {
+    finish(std::make_error_code(std::errc::device_or_resource_busy));
+  }
+}
+
+void spi_bus::finish(std::error_code ec) {
+  m_phase = bus_phase::idle;
+  m_current.device->deselect();
+  callback_t callback = std::move(m_current.callback);
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const bool next = pop_next();
+  m_busy = next;
+  __set_PRIMASK(primask);
+
+  // 回调中可以再次提交；总线已空闲时由该次提交自行启动
+  if (callback) {
+    callback(ec);
+  }
+  if (next) {
+    start_current();
+  }
+}
+
+void spi_bus::configure(const spi_device *device) {
+  if (device == m_active_device) {
+    return;
+  }
+  m_active_device = device;
+
+  SPI_TypeDef *spi = m_hspi->Instance;
+  const uint32_t cr1 = spi->CR1;
+  if ((cr1 & cr1_config_mask) == device->m_cr1) {
+    return;
+  }
+  // CPOL/CPHA/BR 只能在 SPE 关闭时修改；上一个事务已结束，BSY 为 0。
+  // SPE 由 dma_spi 在下一次传输时重新打开
+  spi->CR1 = cr1 & ~SPI_CR1_SPE;
+  spi->CR1 = (cr1 & ~(cr1_config_mask | SPI_CR1_SPE)) | device->m_cr1;
+
+  // 同步 HAL 句柄中的配置，之后调用 HAL_SPI_Init 不会改回旧配置
+  m_hspi->Init.CLKPolarity = device->m_cr1 & SPI_CR1_CPOL;
+  m_hspi->Init.CLKPhase = device->m_cr1 & SPI_CR1_CPHA;
+  m_hspi->Init.BaudRatePrescaler = device->m_cr1 & SPI_CR1_BR;
+  m_hspi->Init.FirstBit = device->m_cr1 & SPI_CR1_LSBFIRST;
+}
+
+void spi_bus::on_dma_done(std::error_code ec) {
+  switch (m_phase) {
+  case bus_phase::transmit:
+    if (ec) {
+      finish(ec);
+      return;
+    }
+    start_receive();
+    return;
+  case bus_phase::receive:
+    finish(ec);
+    return;
+  case bus_phase::idle:
+    return;
+  }
+}
+
+} // namespace gdut
@@ -0,0 +1,286 @@
+#ifndef BSP_SPI_BUS_HPP
+#define BSP_SPI_BUS_HPP
+
+#include "bsp_dma.hpp"
+#include "bsp_function.hpp"
+#include "bsp_gpio_pin.hpp"
+#include "bsp_spi.hpp"
+#include "bsp_type_traits.hpp"
+#include "bsp_uncopyable.hpp"
+#include "cmsis_os2.h"
+#include "stm32f4xx_hal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+
+namespace gdut {
+
+class spi_bus;
+
+/**
+ * @brief SPI 事务优先级
+ *
+ * 总线每次选择下一个事务时取最高优先级队列的队首，同一优先级按提交顺序
+ * 执行。优先级不抢占正在执行的事务。
+ */
+enum class spi_priority : uint8_t {
+  low = 0,    ///< 批量数据（Flash 写入、日志）
+  normal = 1, ///< 一般外设（OLED 刷新等）
+  high = 2    ///< 时间敏感的读取（IMU）
+};
+
+/**
+ * @brief SPI 事务的传输方式
+ */
+enum class spi_transfer_mode : uint8_t {
+  sequential = 0, ///< 先发送 tx，再发送哑字节接收 rx（两次 DMA）
+  full_duplex = 1 ///< tx 与 rx 等长，一次 DMA 同时收发
+};
+
+/**
+ * @brief SPI 设备的时钟配置
+ *
+ * 数据宽度固定为 8 位。各字段即 CR1 中对应位的取值。
+ */
+struct spi_device_config {
+  spi_clock_polarity polarity{spi_clock_polarity::low};
+  spi_clock_phase phase{spi_clock_phase::first_edge};
+  spi_baud_rate_prescaler prescaler{spi_baud_rate_prescaler::div8};
+  spi_first_bit first_bit{spi_first_bit::msb};
+};
+
+/**
+ * @brief 挂在 spi_bus 上的一个从设备（片选 + 时钟配置）
+ *
+ * 片选引脚由调用方用 gpio_pin 定义并初始化（推挽输出），spi_device
+ * 在构造时从 gpio_pin 的编译期配置中取得端口与引脚，之后通过 BSRR
+ * 在中断中直接拉低/拉高片选。
+ *
+ * @note 设备对象必须比它提交的所有事务活得更久。
+ */
+class spi_device : uncopyable {
+public:
+  using callback_t = function<void(std::error_code)>;
+
+  template <gpio_port Port, GPIO_InitTypeDef InitStruct>
+  spi_device(spi_bus &bus, [[maybe_unused]] gpio_pin<Port, InitStruct> &cs,
+             const spi_device_config &config = {})
+      : m_bus(&bus), m_cs_port(get_gpio_port_ptr(Port)),
+        m_cs_pin(static_cast<uint16_t>(InitStruct.Pin)),
+        m_cr1(std::to_underlying(config.polarity) |
+              std::to_underlying(config.phase) |
+              std::to_underlying(config.prescaler) |
+              std::to_underlying(config.first_bit)) {
+    deselect();
+  }
+
+  /**
+   * @brief 提交一个事务：片选拉低 → 发送 tx → 接收 rx → 片选拉高
+   * @return 入队成功返回 true；队列已满或参数非法返回 false（不调用回调）
+   */
+  bool submit(std::span<const uint8_t> tx, std::span<uint8_t> rx,
+              callback_t &&callback = {},
+              spi_priority priority = spi_priority::normal);
+
+  /// 阻塞版本（仅任务上下文）
+  std::error_code transfer(std::span<const uint8_t> tx, std::span<uint8_t> rx,
+                           spi_priority priority = spi_priority::normal);
+
+  /**
+   * @brief 提交一个全双工事务：片选期间 tx 与 rx 逐字节同时收发
+   *
+   * tx 与 rx 必须等长。命令字节之后的接收内容落在 rx 的对应偏移处，
+   * 整个事务只产生一次 DMA 完成中断，适合高频的寄存器突发读。
+   */
+  bool exchange(std::span<const uint8_t> tx, std::span<uint8_t> rx,
+                callback_t &&callback = {},
+                spi_priority priority = spi_priority::normal);
+
+  [[nodiscard]] spi_bus *get_bus() const noexcept { return m_bus; }
+
+private:
+  friend class spi_bus;
+
+  void select() const {
+    m_cs_port->BSRR = static_cast<uint32_t>(m_cs_pin) << 16U;
+  }
+  void deselect() const { m_cs_port->BSRR = m_cs_pin; }
+
+  spi_bus *m_bus;
+  GPIO_TypeDef *m_cs_port;
+  uint16_t m_cs_pin;
+  uint32_t m_cr1; // CPOL | CPHA | BR | LSBFIRST
+};
+
+/**
+ * @brief 一次 SPI 事务：片选期间先发送 tx，再接收 rx
+ *
+ * - tx 非空、rx 为空：纯写（命令、Flash 编程、显存刷新）
+ * - tx 为空、rx 非空：纯读
+ * - 两者都非空：先写命令/寄存器地址，再在同一次片选内读数据
+ *
+ * 接收阶段 MOSI 上持续发送哑字节 0xFF（dma_spi 哑字节模式），rx 缓冲区
+ * 无需预先填充。
+ *
+ * mode 为 spi_transfer_mode::full_duplex 时 tx 与 rx 必须等长且非空，
+ * 两者在一次 DMA 中同时收发。
+ */
+struct spi_transaction {
+  spi_device *device{nullptr};
+  std::span<const uint8_t> tx{};
+  std::span<uint8_t> rx{};
+  spi_priority priority{spi_priority::normal};
+  function<void(std::error_code)> callback{};
+  spi_transfer_mode mode{spi_transfer_mode::sequential};
+};
+
+/**
+ * @brief SPI 总线管理器：多设备共享一个 SPI，带优先级的 DMA 事务队列
+ *
+ * 持有一个 dma_spi，按优先级依次执行各设备提交的事务。每个事务在 DMA
+ * 完成中断中推进（发送阶段 → 接收阶段 → 释放片选），完成后在同一中断中
+ * 启动下一个事务。
+ *
+ * 特性：
+ * - 三级优先级队列，每级固定深度 queue_depth；高优先级事务总是先于
+ *   已排队的低优先级事务执行（IMU 读取不会排在 Flash 批量写之后）
+ * - 切换设备时才比较并改写 CR1 中的 CPOL/CPHA/BR/LSBFIRST；
+ *   配置相同的设备之间切换不触碰外设
+ * - 片选通过 BSRR 单次写入完成，可在中断中调用
+ * - 全双工事务一次 DMA 完成收发，只产生一次完成回调
+ *
+ * 线程安全：
+ * - 队列由关中断临界区保护，可从多个任务和中断并发提交
+ * - 回调在 DMA 中断上下文执行，禁止阻塞；回调中可以再次提交
+ *
+ * 重要约束：
+ * - SPI 须为主机、双线全双工、8 位数据、软件 NSS
+ * - 接管后不能再对同一 SPI 直接使用 dma_spi / spi_proxy / HAL 传输函数，
+ *   也不能再修改两个 dma_proxy 的回调
+ * - tx/rx 缓冲区在回调前必须保持有效，且不能位于 CCMRAM
+ *
+ * 使用示例：
+ * @code
+ * gdut::dma_proxy spi1_tx(&hdma_spi1_tx);
+ * gdut::dma_proxy spi1_rx(&hdma_spi1_rx);
+ * gdut::spi_bus spi1(&hspi1, &spi1_tx, &spi1_rx);
+ *
+ * gdut::gpio_pin<gdut::gpio_port::A,
+ *                GPIO_InitTypeDef{.Pin = GPIO_PIN_4,
+ *                                 .Mode = GPIO_MODE_OUTPUT_PP}> gyro_cs;
+ * gdut::spi_device gyro(spi1, gyro_cs,
+ *                       {gdut::spi_clock_polarity::high,
+ *                        gdut::spi_clock_phase::second_edge,
+ *                        gdut::spi_baud_rate_prescaler::div8});
+ *
+ * static const uint8_t cmd = 0x02 | 0x80;
+ * static uint8_t rate[6];
+ * gyro.submit({&cmd, 1}, rate, [](std::error_code ec) { ... },
+ *             gdut::spi_priority::high);
+ * @endcode
+ */
+class spi_bus : uncopyable {
+public:
+  using callback_t = function<void(std::error_code)>;
+
+  static constexpr std::size_t queue_depth = 8;
+  static constexpr std::size_t priority_count = 3;
+  /// transfer() 等待完成时使用的线程标志位
+  static constexpr uint32_t wait_flag = 0x00200000U;
+
+  spi_bus(SPI_HandleTypeDef *hspi, dma_proxy *tx_dma, dma_proxy *rx_dma);
+  /**
+   * @brief 关闭 SPI 的 DMA 请求，中止 TX/RX 数据流，
+   *        并撤销 DMA 句柄与 RX 代理中指向本对象的回调。
+   *
+   * 正在执行的事务被放弃（不调用其回调），排队中的事务直接丢弃。
+   */
+  ~spi_bus() noexcept;
+
+  [[nodiscard]] bool valid() const noexcept {
+    return m_hspi != nullptr && m_tx_dma != nullptr && m_rx_dma != nullptr;
+  }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /**
+   * @brief 提交一个事务。
+   * @return 入队成功返回 true；对应优先级队列已满或参数非法返回 false
+   *         （不调用回调）
+   */
+  bool submit(spi_transaction &&transaction);
+
+  /**
+   * @brief 阻塞执行一个事务（仅任务上下文），transaction.callback 被忽略。
+   */
+  std::error_code transfer(spi_transaction &&transaction);
+
+  /// 排队中（不含正在执行）的事务数
+  [[nodiscard]] std::size_t pending() const noexcept;
+
+  /// 是否有事务正在执行
+  [[nodiscard]] bool busy() const noexcept { return m_busy; }
+
+  [[nodiscard]] SPI_HandleTypeDef *get_handle() const noexcept {
+    return m_hspi;
+  }
+
+private:
+  enum class bus_phase : uint8_t {
+    idle,     // 无事务在执行
+    transmit, // 发送 tx
+    receive   // 发送哑字节并接收 rx，或全双工收发
+  };
+
+  struct priority_queue {
+    spi_transaction slots[queue_depth]{};
+    std::size_t head{0};
+    std::size_t count{0};
+  };
+
+  static constexpr uint32_t cr1_config_mask =
+      SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_BR | SPI_CR1_LSBFIRST;
+
+  bool pop_next();
+  void start_current();
+  void start_receive();
+  void finish(std::error_code ec);
+  void configure(const spi_device *device);
+  void on_dma_done(std::error_code ec);
+
+  SPI_HandleTypeDef *m_hspi{nullptr};
+  dma_proxy *m_tx_dma{nullptr};
+  dma_proxy *m_rx_dma{nullptr};
+  dma_spi m_dma;
+
+  priority_queue m_queues[priority_count]{};
+  spi_transaction m_current{};
+  volatile bool m_busy{false};
+  volatile bus_phase m_phase{bus_phase::idle};
+  const spi_device *m_active_device{nullptr};
+};
+
+inline bool spi_device::submit(std::span<const uint8_t> tx,
+                               std::span<uint8_t> rx, callback_t &&callback,
+                               spi_priority priority) {
+  return m_bus->submit({this, tx, rx, priority, std::move(callback)});
+}
+
+inline std::error_code spi_device::transfer(std::span<const uint8_t> tx,
+                                            std::span<uint8_t> rx,
+                                            spi_priority priority) {
+  return m_bus->transfer({this, tx, rx, priority});
+}
+
+inline bool spi_device::exchange(std::span<const uint8_t> tx,
+                                 std::span<uint8_t> rx, callback_t &&callback,
+                                 spi_priority priority) {
+  return m_bus->submit({this, tx, rx, priority, std::move(callback),
+                        spi_transfer_mode::full_duplex});
+}
+
+} // namespace gdut
+
+#endif // BSP_SPI_BUS_HPP
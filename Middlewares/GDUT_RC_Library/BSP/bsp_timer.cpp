@@ -0,0 +1,118 @@
+#include "bsp_timer.hpp"
+
+namespace gdut {
+
+timer *timer_irq_handler::instances[timer_count + 1] = {};
+
+void timer_irq_handler::attach(timer *t) noexcept {
+  if (t == nullptr || t->get_htim() == nullptr) {
+    return;
+  }
+  const auto id =
+      static_cast<std::size_t>(get_timer_id(t->get_htim()->Instance));
+  if (id == 0U) {
+    return; // 非定时器地址
+  }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  instances[id] = t;
+  __set_PRIMASK(primask);
+}
+
+void timer_irq_handler::detach(const timer *t) noexcept {
+  if (t == nullptr || t->get_htim() == nullptr) {
+    return;
+  }
+  const auto id =
+      static_cast<std::size_t>(get_timer_id(t->get_htim()->Instance));
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (id != 0U && instances[id] == t) {
+    instances[id] = nullptr;
+  }
+  __set_PRIMASK(primask);
+}
+
+void timer_irq_handler::replace(const timer *from, timer *to) noexcept {
+  if (to == nullptr || to->get_htim() == nullptr) {
+    return;
+  }
+  const auto id =
+      static_cast<std::size_t>(get_timer_id(to->get_htim()->Instance));
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (id != 0U && instances[id] == from) {
+    instances[id] = to;
+  }
+  __set_PRIMASK(primask);
+}
+
+timer *timer_irq_handler::find(const TIM_TypeDef *instance) noexcept {
+  // 非定时器地址得到 timer_id::none，对应的表项恒为空
+  return instances[static_cast<std::size_t>(get_timer_id(instance))];
+}
+
+void timer_irq_handler::period_elapsed(TIM_HandleTypeDef *htim) noexcept {
+  if (timer *t = find(htim->Instance)) {
+    t->call_period_elapsed_callback();
+  }
+}
+
+void timer_irq_handler::capture(TIM_HandleTypeDef *htim) noexcept {
+  if (timer *t = find(htim->Instance)) {
+    // HAL_TIM_ACTIVE_CHANNEL_CLEARED 换算为 33，call_capture_callback 忽略
+    t->call_capture_callback(channel_number(htim->Channel));
+  }
+}
+
+void timer_irq_handler::compare(TIM_HandleTypeDef *htim) noexcept {
+  if (timer *t = find(htim->Instance)) {
+    t->call_compare_callback(channel_number(htim->Channel));
+  }
+}
+
+void timer_irq_handler::pulse_finished(TIM_HandleTypeDef *htim) noexcept {
+  if (timer *t = find(htim->Instance)) {
+    t->call_pulse_finished_callback();
+  }
+}
+
+void timer_irq_handler::pulse_half(TIM_HandleTypeDef *htim) noexcept {
+  if (timer *t = find(htim->Instance)) {
+    t->call_pulse_half_callback();
+  }
+}
+
+void timer_irq_handler::error(TIM_HandleTypeDef *htim) noexcept {
+  if (timer *t = find(htim->Instance)) {
+    t->call_error_callback();
+  }
+}
+
+} // namespace gdut
+
+// 强符号定义以可靠覆盖 HAL 的 __weak 默认实现
+extern "C" void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
+  gdut::timer_irq_handler::period_elapsed(htim);
+}
+
+extern "C" void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim) {
+  gdut::timer_irq_handler::capture(htim);
+}
+
+extern "C" void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim) {
+  gdut::timer_irq_handler::compare(htim);
+}
+
+extern "C" void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim) {
+  gdut::timer_irq_handler::pulse_finished(htim);
+}
+
+extern "C" void
+HAL_TIM_PWM_PulseFinishedHalfCpltCallback(TIM_HandleTypeDef *htim) {
+  gdut::timer_irq_handler::pulse_half(htim);
+}
+
+extern "C" void HAL_TIM_ErrorCallback(TIM_HandleTypeDef *htim) {
+  gdut::timer_irq_handler::error(htim);
+}
@@ -7,13 +7,72 @@
 #include "stm32f4xx_hal_tim.h"
 
 #include "bsp_function.hpp"
+#include "bsp_type_traits.hpp"
 #include "bsp_uncopyable.hpp"
 
+#include <bit>
 #include <functional>
 #include <utility>
 
 namespace gdut {
 
+class timer;
+
+/**
+ * @brief 定时器中断分发表：把 HAL 的定时器回调转发到对应的 timer 对象
+ *
+ * bsp_timer.cpp 以强符号覆盖 HAL_TIM_PeriodElapsedCallback、
+ * HAL_TIM_IC_CaptureCallback、HAL_TIM_OC_DelayElapsedCallback、
+ * HAL_TIM_PWM_PulseFinishedCallback、
+ * HAL_TIM_PWM_PulseFinishedHalfCpltCallback 与 HAL_TIM_ErrorCallback，
+ * 由 htim->Instance 查表（get_timer_id：一次查表加一次比较）找到
+ * timer 对象并调用其回调，用户不再需要按 TIM1~TIM14 逐个比较句柄。
+ *
+ * 特性：
+ * - timer 构造时自动登记，析构时注销，移动时更新表项
+ * - 捕获通道由 HAL_TIM_ACTIVE_CHANNEL_x（独热码）经 countr_zero 换算，
+ *   无分支
+ * - 分发为常数时间，与登记的定时器数量无关
+ *
+ * 重要约束：
+ * - 每个 TIMx 同一时刻只能有一个 timer 对象，后构造的覆盖先登记的
+ * - 应用代码中不能再定义上述 HAL 回调（会导致重复定义）；HAL 时基
+ *   使用 TIMx 时，CubeMX 生成的 HAL_TIM_PeriodElapsedCallback 须删除，
+ *   改为为该定时器构造 timer 并在更新回调中调用 HAL_IncTick()
+ */
+class timer_irq_handler {
+public:
+  timer_irq_handler() = delete;
+
+  /// 登记 t（按其 TIM_HandleTypeDef 的 Instance）
+  static void attach(timer *t) noexcept;
+  /// 表项仍指向 t 时注销
+  static void detach(const timer *t) noexcept;
+  /// 移动后把表项从 from 改为 to
+  static void replace(const timer *from, timer *to) noexcept;
+
+  [[nodiscard]] static timer *find(const TIM_TypeDef *instance) noexcept;
+
+  static void period_elapsed(TIM_HandleTypeDef *htim) noexcept;
+  static void capture(TIM_HandleTypeDef *htim) noexcept;
+  static void compare(TIM_HandleTypeDef *htim) noexcept;
+  static void pulse_finished(TIM_HandleTypeDef *htim) noexcept;
+  static void pulse_half(TIM_HandleTypeDef *htim) noexcept;
+  static void error(TIM_HandleTypeDef *htim) noexcept;
+
+  /// HAL_TIM_ACTIVE_CHANNEL_1~4（0x1/0x2/0x4/0x8）→ 通道号 1~4
+  [[nodiscard]] static constexpr uint32_t
+  channel_number(HAL_TIM_ActiveChannel channel) noexcept {
+    return static_cast<uint32_t>(
+               std::countr_zero(static_cast<uint32_t>(channel))) +
+           1U;
+  }
+
+private:
+  // 以 timer_id 为下标，下标 0（timer_id::none）恒为空
+  static timer *instances[timer_count + 1];
+};
+
 class timer : private uncopyable {
 public:
   using callback_t = gdut::function<void()>;
@@ -22,9 +81,13 @@ public:
   timer(TIM_HandleTypeDef *htim, DMA_HandleTypeDef *hdma = nullptr)
       : m_htim(htim), m_hdma(nullptr) {
     attach_dma(hdma);
+    timer_irq_handler::attach(this);
   }
 
-  ~timer() { deinit(); }
+  ~timer() {
+    timer_irq_handler::detach(this);
+    deinit();
+  }
 
   // 移动构造函数
   timer(timer &&other) noexcept
@@ -35,11 +98,13 @@ public:
     }
     other.m_htim = nullptr;
     other.m_hdma = nullptr;
+    timer_irq_handler::replace(&other, this);
   }
 
   // 移动赋值运算符
   timer &operator=(timer &&other) noexcept {
     if (this != std::addressof(other)) {
+      timer_irq_handler::detach(this);
       deinit();
       m_htim = other.m_htim;
       m_hdma = other.m_hdma;
@@ -49,6 +114,7 @@ public:
       }
       other.m_htim = nullptr;
       other.m_hdma = nullptr;
+      timer_irq_handler::replace(&other, this);
     }
     return *this;
   }
@@ -118,10 +184,28 @@ public:
     return false;
   }
 
+  // 输出比较中断回调（通道 1~4）
+  [[nodiscard]] bool register_compare_callback(uint32_t channel,
+                                               callback_t cb) {
+    if (channel >= 1 && channel <= 4) {
+      m_callbacks.compare_cbs[channel - 1] = std::move(cb);
+      return true;
+    }
+    return false;
+  }
+
   void register_error_callback(callback_t cb) {
     m_callbacks.error_cb = std::move(cb);
   }
 
+  // PWM 脉冲结束回调（pwm_start_dma 的传输完成/半完成也经由这里）
+  void register_pulse_finished_callback(callback_t cb) {
+    m_callbacks.pulse_finished_cb = std::move(cb);
+  }
+  void register_pulse_half_callback(callback_t cb) {
+    m_callbacks.pulse_half_cb = std::move(cb);
+  }
+
   // 回调调用接口（供中断服务例程使用）
   void call_period_elapsed_callback() {
     if (m_callbacks.period_elapsed_cb) {
@@ -135,12 +219,30 @@ public:
     }
   }
 
+  void call_compare_callback(uint32_t channel) {
+    if (channel >= 1 && channel <= 4 && m_callbacks.compare_cbs[channel - 1]) {
+      std::invoke(m_callbacks.compare_cbs[channel - 1]);
+    }
+  }
+
   void call_error_callback() {
     if (m_callbacks.error_cb) {
       std::invoke(m_callbacks.error_cb);
     }
   }
 
+  void call_pulse_finished_callback() {
+    if (m_callbacks.pulse_finished_cb) {
+      std::invoke(m_callbacks.pulse_finished_cb);
+    }
+  }
+
+  void call_pulse_half_callback() {
+    if (m_callbacks.pulse_half_cb) {
+      std::invoke(m_callbacks.pulse_half_cb);
+    }
+  }
+
   // DMA 注册接口（委托给 callback_mgr_）
   void register_dma_xfer_cplt_callback(callback_t cb) {
     m_callbacks.dma_xfer_cplt_cb = std::move(cb);
@@ -155,6 +257,32 @@ public:
   TIM_HandleTypeDef *get_htim() { return m_htim; }
   const TIM_HandleTypeDef *get_htim() const { return m_htim; }
 
+  // 计数器时钟频率（Hz，PSC 分频之后）
+  uint32_t get_counter_frequency() const {
+    if (!m_htim) {
+      return 0;
+    }
+    const TIM_TypeDef *tim = m_htim->Instance;
+    // TIM1/8/9/10/11 位于 APB2
+    const bool apb2 = reinterpret_cast<uintptr_t>(tim) >= APB2PERIPH_BASE;
+    const uint32_t pclk =
+        apb2 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+    const uint32_t ppre =
+        apb2 ? (RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos
+             : (RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos;
+    // APB 分频不为 1 时定时器时钟为 PCLK 的两倍
+    const uint32_t clock = (ppre & 0x4U) != 0U ? pclk * 2U : pclk;
+    return clock / (tim->PSC + 1U);
+  }
+
+  // 更新事件频率（Hz）
+  uint32_t get_frequency() const {
+    if (!m_htim) {
+      return 0;
+    }
+    return get_counter_frequency() / (m_htim->Instance->ARR + 1U);
+  }
+
   // timer提供时钟基功能
   class timer_proxy {
   public:
@@ -450,7 +578,10 @@ protected:
   struct timer_callbacks {
     callback_t period_elapsed_cb{}; // 更新中断回调
     callback_t capture_cbs[4]{};    // 捕获中断回调（最多4个通道）
+    callback_t compare_cbs[4]{};    // 输出比较中断回调
     callback_t error_cb{};
+    callback_t pulse_finished_cb{}; // PWM 脉冲结束（含 PWM DMA 完成）
+    callback_t pulse_half_cb{};     // PWM DMA 半完成
     callback_t dma_xfer_cplt_cb{};
     callback_t dma_xfer_half_cb{};
     callback_t dma_error_cb{};
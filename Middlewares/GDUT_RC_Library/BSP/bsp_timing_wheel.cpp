@@ -0,0 +1,288 @@
+#include "bsp_timing_wheel.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace gdut {
+
+deadline::~deadline() noexcept {
+  if (timing_wheel *wheel = m_wheel) {
+    (void)wheel->cancel(*this);
+  }
+}
+
+timing_wheel::timing_wheel(timer &tim, uint32_t channel)
+    : m_timer(&tim), m_channel(channel) {
+  if (tim.get_htim() == nullptr || channel > TIM_CHANNEL_4 ||
+      channel % 4U != 0U) {
+    m_timer = nullptr;
+    return;
+  }
+  (void)tim.register_compare_callback(channel / 4U + 1U,
+                                      [this] { on_compare(); });
+}
+
+timing_wheel::~timing_wheel() noexcept {
+  if (m_timer == nullptr) {
+    return;
+  }
+  (void)stop();
+  (void)m_timer->register_compare_callback(m_channel / 4U + 1U, {});
+  // 仍挂着的节点与本对象脱离，之后析构不再回访
+  for (uint16_t slot = 0; slot <= overflow_slot + 1U; ++slot) {
+    link &head = slot_head(slot);
+    for (link *l = head.next; l != &head; l = l->next) {
+      static_cast<deadline *>(l)->m_wheel = nullptr;
+    }
+  }
+}
+
+HAL_StatusTypeDef timing_wheel::start() {
+  if (!valid()) {
+    return HAL_ERROR;
+  }
+  TIM_TypeDef *tim = m_timer->get_htim()->Instance;
+  const uint32_t arr = tim->ARR;
+  // 自由计数且量程为 2 的幂，扩展时才能用掩码求差
+  if (arr < 0xFFFFU || (arr & (arr + 1U)) != 0U) {
+    return HAL_ERROR;
+  }
+  m_tick_hz = m_timer->get_counter_frequency();
+  if (m_tick_hz == 0U) {
+    return HAL_ERROR;
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (m_mask == 0U) {
+    // 首次启动：扩展时间的低位与 CNT 对齐，比较值可直接取低位
+    m_last_count = tim->CNT;
+    m_hw_time = m_last_count;
+    m_now = m_hw_time;
+  }
+  m_mask = arr;
+  m_max_step = (static_cast<uint64_t>(arr) + 1U) / 2U;
+  __set_PRIMASK(primask);
+
+  const HAL_StatusTypeDef status = timer::timer_oc(m_timer).oc_start_it(
+      m_channel);
+  if (status != HAL_OK) {
+    return status;
+  }
+  primask = __get_PRIMASK();
+  __disable_irq();
+  program();
+  __set_PRIMASK(primask);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef timing_wheel::stop() {
+  if (!valid()) {
+    return HAL_ERROR;
+  }
+  m_programmed = none;
+  return timer::timer_oc(m_timer).oc_stop_it(m_channel);
+}
+
+uint64_t timing_wheel::now() noexcept {
+  if (m_mask == 0U) {
+    return 0;
+  }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const uint64_t t = hw_now();
+  __set_PRIMASK(primask);
+  return t;
+}
+
+uint64_t timing_wheel::to_ticks(std::chrono::microseconds us) const noexcept {
+  if (us.count() <= 0) {
+    return 0;
+  }
+  const auto count = static_cast<uint64_t>(us.count());
+  return (count * m_tick_hz + 999999U) / 1000000U;
+}
+
+bool timing_wheel::arm_at(deadline &d, uint64_t expiry) noexcept {
+  if (!valid() || m_mask == 0U) {
+    return false;
+  }
+  if (timing_wheel *wheel = d.m_wheel) {
+    (void)wheel->cancel(d);
+  }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  d.m_expiry = expiry;
+  d.m_wheel = this;
+  insert(d);
+  // 只有比已设置的比较点更早时才需要改写比较寄存器
+  if (expiry < m_programmed) {
+    program();
+  }
+  __set_PRIMASK(primask);
+  return true;
+}
+
+bool timing_wheel::cancel(deadline &d) noexcept {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (d.m_wheel != this) {
+    __set_PRIMASK(primask);
+    return false;
+  }
+  unlink(d);
+  d.m_wheel = nullptr;
+  __set_PRIMASK(primask);
+  return true;
+}
+
+void timing_wheel::on_compare() noexcept {
+  while (true) {
+    deadline *expired = nullptr;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const bool more = step(expired);
+    if (!more) {
+      program();
+    }
+    __set_PRIMASK(primask);
+    if (expired != nullptr && expired->m_callback) {
+      expired->m_callback();
+    }
+    if (!more) {
+      return;
+    }
+  }
+}
+
+bool timing_wheel::step(deadline *&expired) noexcept {
+  link &draining = m_overflow[m_overflow_index ^ 1U];
+  if (draining.next != &draining) {
+    // 刚跨越 span 边界：先把上一条溢出链表的节点逐个重新分层
+    auto &d = static_cast<deadline &>(*draining.next);
+    unlink(d);
+    insert(d);
+    return true;
+  }
+  const uint64_t now = hw_now();
+  std::size_t level = 0;
+  const uint64_t t = next_event(level);
+  if (t == none || t > now) {
+    // 中间没有任何事件，时间轮可以直接跳到当前时刻
+    m_now = now;
+    return false;
+  }
+  m_now = t;
+  if (level == levels) {
+    // 换一条链表收集新的溢出节点，重新分层时远的节点不会回到待处理的一条
+    m_overflow_index ^= 1U;
+    return true;
+  }
+  const auto slot = static_cast<uint16_t>(
+      level * slots + ((t >> (level * slot_bits)) & (slots - 1U)));
+  auto &d = static_cast<deadline &>(*slot_head(slot).next);
+  unlink(d);
+  if (level == 0U) {
+    d.m_wheel = nullptr;
+    expired = &d;
+  } else {
+    // 级联：相对新的 m_now 重新选层，必然落到更低的层
+    insert(d);
+  }
+  return true;
+}
+
+void timing_wheel::program() noexcept {
+  TIM_HandleTypeDef *htim = m_timer->get_htim();
+  const uint64_t now = hw_now();
+  std::size_t level = 0;
+  const uint64_t next = next_event(level);
+  const uint64_t limit = now + m_max_step;
+  const uint64_t target = std::min(next, limit);
+  m_programmed = target;
+  __HAL_TIM_SET_COMPARE(htim, m_channel,
+                        static_cast<uint32_t>(target) & m_mask);
+  // 写入前后目标可能已经过去：软件产生一次比较事件，立即进中断
+  if (hw_now() >= target) {
+    htim->Instance->EGR = TIM_EGR_CC1G << (m_channel / 4U);
+  }
+}
+
+uint64_t timing_wheel::hw_now() noexcept {
+  const uint32_t count = m_timer->get_htim()->Instance->CNT;
+  m_hw_time += (count - m_last_count) & m_mask;
+  m_last_count = count;
+  return m_hw_time;
+}
+
+uint64_t timing_wheel::next_event(std::size_t &level) const noexcept {
+  uint64_t best = none;
+  for (std::size_t k = 0; k < levels; ++k) {
+    if (m_occupied[k] == 0U) {
+      continue;
+    }
+    // 第 k 层的节点与 m_now 在更高位上相同，按占用的最低槽位得到时刻
+    const std::size_t shift = k * slot_bits;
+    const uint64_t base = m_now & ~((uint64_t{1} << (shift + slot_bits)) - 1U);
+    const auto index = static_cast<uint64_t>(std::countr_zero(m_occupied[k]));
+    const uint64_t t = base + (index << shift);
+    if (t < best) {
+      best = t;
+      level = k;
+    }
+  }
+  const link &overflow = m_overflow[m_overflow_index];
+  if (overflow.next != &overflow) {
+    const uint64_t t = (m_now & ~(span - 1U)) + span;
+    if (t < best) {
+      best = t;
+      level = levels;
+    }
+  }
+  return best;
+}
+
+void timing_wheel::insert(deadline &d) noexcept {
+  const uint64_t expiry = std::max(d.m_expiry, m_now);
+  // 与 m_now 的最高不同位决定层：低于该层的位在到期前都会被走完
+  const uint64_t diff = expiry ^ m_now;
+  const std::size_t level =
+      diff == 0U ? 0U
+                 : (static_cast<std::size_t>(std::bit_width(diff)) - 1U) /
+                       slot_bits;
+  link *head = &m_overflow[m_overflow_index];
+  if (level < levels) {
+    const auto index = static_cast<std::size_t>(
+        (expiry >> (level * slot_bits)) & (slots - 1U));
+    head = &m_slots[level][index];
+    m_occupied[level] |= uint64_t{1} << index;
+    d.m_slot = static_cast<uint16_t>(level * slots + index);
+  } else {
+    d.m_slot = static_cast<uint16_t>(overflow_slot + m_overflow_index);
+  }
+  d.prev = head->prev;
+  d.next = head;
+  head->prev->next = &d;
+  head->prev = &d;
+}
+
+void timing_wheel::unlink(deadline &d) noexcept {
+  d.prev->next = d.next;
+  d.next->prev = d.prev;
+  const link *head = &slot_head(d.m_slot);
+  if (d.m_slot < overflow_slot && head->next == head) {
+    m_occupied[d.m_slot / slots] &= ~(uint64_t{1} << (d.m_slot % slots));
+  }
+  d.prev = &d;
+  d.next = &d;
+}
+
+timing_wheel::link &timing_wheel::slot_head(uint16_t slot) noexcept {
+  if (slot >= overflow_slot) {
+    return m_overflow[slot - overflow_slot];
+  }
+  return m_slots[slot / slots][slot % slots];
+}
+
+} // namespace gdut
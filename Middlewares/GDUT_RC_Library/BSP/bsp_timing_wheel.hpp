@@ -0,0 +1,195 @@
+#ifndef BSP_TIMING_WHEEL_HPP
+#define BSP_TIMING_WHEEL_HPP
+
+#include "bsp_function.hpp"
+#include "bsp_timer.hpp"
+#include "bsp_uncopyable.hpp"
+#include "stm32f4xx_hal.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace gdut {
+
+class timing_wheel;
+
+namespace detail {
+
+/// 侵入式双向循环链表节点，槽位以自身为哨兵
+struct wheel_link {
+  wheel_link *prev{this};
+  wheel_link *next{this};
+};
+
+} // namespace detail
+
+/**
+ * @brief 挂在 timing_wheel 上的一个软件定时点（侵入式节点）
+ *
+ * 节点由调用者持有，wheel 只串联指针，不做任何分配。
+ * 到期时在定时器比较中断中调用回调；回调内可以再次 arm（周期定时）。
+ */
+class deadline : detail::wheel_link, uncopyable {
+public:
+  using callback_t = function<void()>;
+
+  deadline() = default;
+  explicit deadline(callback_t callback) : m_callback(std::move(callback)) {}
+  /// 仍在 wheel 上时自动取消
+  ~deadline() noexcept;
+
+  /// 只能在未挂起（!active()）时修改
+  void set_callback(callback_t callback) noexcept {
+    m_callback = std::move(callback);
+  }
+
+  /// 已 arm 且尚未到期或取消
+  [[nodiscard]] bool active() const noexcept { return m_wheel != nullptr; }
+
+  /// 最近一次 arm 的到期时刻（计数器节拍，见 timing_wheel::now()）
+  [[nodiscard]] uint64_t expiry() const noexcept { return m_expiry; }
+
+private:
+  friend class timing_wheel;
+
+  timing_wheel *volatile m_wheel{nullptr};
+  uint64_t m_expiry{};
+  uint16_t m_slot{};
+  callback_t m_callback{};
+};
+
+/**
+ * @brief 由一个定时器比较通道驱动的分层时间轮
+ *
+ * FreeRTOS 软件定时器的每次操作都要经过定时器任务的队列，分辨率为
+ * 1 ms 系统节拍。timing_wheel 直接以定时器计数器节拍（如 1 MHz）为
+ * 时间单位，把大量超时（电机掉线、通信重发、看门狗）挂在 4 层、每层
+ * 64 槽的时间轮上，并把比较寄存器只设置到下一个到期时刻（无空转节拍）。
+ *
+ * 特性：
+ * - arm/cancel 为 O(1)：按到期时刻与当前时刻的最高不同位选层，
+ *   直接挂入槽位链表并置位占用位图
+ * - 下一个到期时刻由每层占用位图的 countr_zero 得到，O(层数)
+ * - 高层槽位到期时把节点下移（级联），每个节点最多级联 4 次
+ * - 超过 2^24 个节拍的节点挂在溢出链表上，每 2^24 个节拍重新分层一次，
+ *   同样每个临界区只移动一个节点
+ * - 16 位计数器在软件中扩展为 64 位，比较间隔不超过计数器量程的一半
+ *
+ * 线程安全：
+ * - arm/cancel/now 可在任务与中断中调用，内部以保存/恢复 PRIMASK 的
+ *   临界区保护，每个临界区只处理一个节点
+ * - 回调在比较中断中、临界区之外执行
+ *
+ * 重要约束：
+ * - 定时器须自由计数：ARR 为 0xFFFF（或 32 位定时器的 0xFFFFFFFF）；
+ *   分辨率由 PSC 决定（如 PSC 使计数器为 1 MHz）
+ * - 比较通道配置为 Output Compare No Output（Frozen），并使能定时器中断
+ * - 比较中断经由 timer_irq_handler 分发，应用不得再定义
+ *   HAL_TIM_OC_DelayElapsedCallback
+ * - 中断的响应延迟须小于计数器量程的一半，否则扩展时间会少计一圈
+ * - 节点在到期或取消之前不能销毁或移动（析构时会自动取消）
+ *
+ * 使用示例：
+ * @code
+ * gdut::timer wheel_timer(&htim5); // PSC 使计数器为 1 MHz，ARR=0xFFFFFFFF
+ * gdut::timing_wheel wheel(wheel_timer, TIM_CHANNEL_1);
+ *
+ * gdut::deadline motor_timeout([] { motor_offline(); });
+ *
+ * wheel.start();
+ *
+ * // 每收到一帧电机反馈
+ * wheel.arm(motor_timeout, std::chrono::microseconds(20000));
+ * @endcode
+ */
+class timing_wheel : uncopyable {
+public:
+  static constexpr std::size_t levels = 4;
+  static constexpr std::size_t slot_bits = 6;
+  static constexpr std::size_t slots = std::size_t{1} << slot_bits;
+  /// 分层覆盖的节拍范围，更远的节点进入溢出链表
+  static constexpr uint64_t span = uint64_t{1} << (levels * slot_bits);
+
+  /**
+   * @brief 绑定定时器比较通道并接管该通道的比较回调
+   */
+  timing_wheel(timer &tim, uint32_t channel);
+  ~timing_wheel() noexcept;
+
+  [[nodiscard]] bool valid() const noexcept { return m_timer != nullptr; }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /**
+   * @brief 检查计数器配置并启动比较中断
+   *
+   * @return ARR 不是 2^n−1（n ≥ 16）时返回 HAL_ERROR
+   */
+  HAL_StatusTypeDef start();
+  HAL_StatusTypeDef stop();
+
+  /// 当前时刻（计数器节拍，64 位不回绕）
+  [[nodiscard]] uint64_t now() noexcept;
+
+  /// 计数器频率（Hz），start() 之后有效
+  [[nodiscard]] uint32_t tick_frequency() const noexcept { return m_tick_hz; }
+
+  /// 微秒换算为节拍（向上取整）
+  [[nodiscard]] uint64_t to_ticks(std::chrono::microseconds us) const noexcept;
+
+  /**
+   * @brief 在绝对时刻 expiry（节拍）到期；已挂起的节点先被取消
+   *
+   * 早于当前时刻的 expiry 在下一次比较中断中立即到期。
+   * 周期定时在回调中用 arm_at(d, d.expiry() + period) 可避免累积漂移。
+   *
+   * @return 未 start() 时返回 false
+   */
+  bool arm_at(deadline &d, uint64_t expiry) noexcept;
+
+  /// 从现在起 delay 后到期
+  bool arm(deadline &d, std::chrono::microseconds delay) noexcept {
+    return arm_at(d, now() + to_ticks(delay));
+  }
+
+  /// @return 节点不在本 wheel 上（已到期或从未 arm）时返回 false
+  bool cancel(deadline &d) noexcept;
+
+private:
+  using link = detail::wheel_link;
+
+  static constexpr uint64_t none = std::numeric_limits<uint64_t>::max();
+  // 两条溢出链表交替使用，槽位号为 overflow_slot + 0/1
+  static constexpr uint16_t overflow_slot = levels * slots;
+
+  void on_compare() noexcept;
+  bool step(deadline *&expired) noexcept;
+  void program() noexcept;
+  uint64_t hw_now() noexcept;
+  uint64_t next_event(std::size_t &level) const noexcept;
+  void insert(deadline &d) noexcept;
+  void unlink(deadline &d) noexcept;
+  link &slot_head(uint16_t slot) noexcept;
+
+  timer *m_timer{nullptr};
+  uint32_t m_channel{};
+  uint32_t m_tick_hz{};
+  uint32_t m_mask{};      // 计数器量程 − 1（ARR）
+  uint32_t m_last_count{};
+  uint64_t m_max_step{};  // 比较间隔上限：量程的一半
+  uint64_t m_hw_time{};   // 扩展为 64 位的计数器
+  uint64_t m_now{};       // 时间轮已处理到的时刻
+  uint64_t m_programmed{none};
+  std::array<uint64_t, levels> m_occupied{};
+  std::array<std::array<link, slots>, levels> m_slots{};
+  // 当前收集溢出节点的一条，另一条在跨越 span 边界时逐个重新分层
+  std::array<link, 2> m_overflow{};
+  uint8_t m_overflow_index{0};
+};
+
+} // namespace gdut
+
+#endif // BSP_TIMING_WHEEL_HPP
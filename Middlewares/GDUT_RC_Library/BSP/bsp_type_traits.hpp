@@ -1,9 +1,11 @@
 #ifndef BSP_TYPE_TRAITS_HPP
 #define BSP_TYPE_TRAITS_HPP
 
+#include "bsp_meta.hpp"
 #include "stm32f407xx.h"
 #include "stm32f4xx_hal.h"
 #include "stm32f4xx_hal_dma.h"
+#include <array>
 #include <chrono>
 #include <cmsis_os2.h>
 #include <cstddef>
@@ -21,19 +23,16 @@
  */
 #define GDUT_CCMRAM __attribute__((section(".ccmram")))
 
-namespace gdut {
-
-template <std::size_t Value> struct is_power_of_two {
-  static constexpr bool value = Value && (Value & (Value - 1)) == 0;
-};
-
-template <std::size_t Value>
-inline constexpr bool is_power_of_two_v = is_power_of_two<Value>::value;
-
-template <typename> struct always_false : std::false_type {};
+/**
+ * @brief 将对象放置到 DMA 缓冲区段（.dma_buffer）的属性
+ *
+ * 该段由链接脚本放在主 SRAM（SRAM1/SRAM2）中，并按 16 字节对齐以满足
+ * 4 拍字突发（INC4）的地址要求。段为 NOLOAD，启动代码不会清零，
+ * 其中的对象须由构造函数或使用者自行初始化。
+ */
+#define GDUT_DMA_BUFFER __attribute__((section(".dma_buffer"), aligned(16)))
 
-template <typename T>
-inline constexpr bool always_false_v = always_false<T>::value;
+namespace gdut {
 
 /**
  * @brief 类型安全的 GPIO 端口枚举
@@ -90,7 +89,27 @@ enum class gpio_port : uint8_t { A = 1, B, C, D, E, F, G, H, I };
   }
 }
 
+/**
+ * @brief GPIO 端口的基地址（整数，可在常量表达式中使用）
+ *
+ * GPIOA~GPIOI 在 AHB1 上以 0x400 为间隔连续排列。
+ * 与 get_gpio_port_ptr() 不同，结果可作为模板参数或 constexpr 变量，
+ * 由它 reinterpret_cast 得到的指针在编译期即确定，访问寄存器无需查表。
+ */
+[[nodiscard]] constexpr uintptr_t get_gpio_port_base(gpio_port port) {
+  const auto index = static_cast<uintptr_t>(port);
+  if (index < static_cast<uintptr_t>(gpio_port::A) ||
+      index > static_cast<uintptr_t>(gpio_port::I)) {
+    return 0; // 端口非法
+  }
+  return GPIOA_BASE + (index - 1U) * (GPIOB_BASE - GPIOA_BASE);
+}
+
+static_assert(get_gpio_port_base(gpio_port::I) == GPIOI_BASE,
+              "GPIO ports must be evenly spaced");
+
 enum class timer_id : uint8_t {
+  none = 0, ///< 非定时器地址
   tim1 = 1,
   tim2,
   tim3,
@@ -98,9 +117,18 @@ enum class timer_id : uint8_t {
   tim5,
   tim9,
   tim10,
-  tim11
+  tim11,
+  tim6,
+  tim7,
+  tim8,
+  tim12,
+  tim13,
+  tim14
 };
 
+/// timer_id 的有效取值为 1 ~ timer_count
+inline constexpr std::size_t timer_count = 14;
+
 [[nodiscard]] constexpr TIM_TypeDef *get_timer_ptr(timer_id id) {
   switch (id) {
   case timer_id::tim1:
@@ -119,11 +147,81 @@ enum class timer_id : uint8_t {
     return TIM10;
   case timer_id::tim11:
     return TIM11;
+  case timer_id::tim6:
+    return TIM6;
+  case timer_id::tim7:
+    return TIM7;
+  case timer_id::tim8:
+    return TIM8;
+  case timer_id::tim12:
+    return TIM12;
+  case timer_id::tim13:
+    return TIM13;
+  case timer_id::tim14:
+    return TIM14;
   default:
     return nullptr; // 定时器 ID 非法
   }
 }
 
+namespace detail {
+
+/// 按 timer_id 顺序排列的定时器基地址（下标 0 对应 timer_id::none）
+inline constexpr std::array<uintptr_t, timer_count + 1> timer_bases{
+    0U,         TIM1_BASE,  TIM2_BASE,  TIM3_BASE,  TIM4_BASE,
+    TIM5_BASE,  TIM9_BASE,  TIM10_BASE, TIM11_BASE, TIM6_BASE,
+    TIM7_BASE,  TIM8_BASE,  TIM12_BASE, TIM13_BASE, TIM14_BASE};
+
+/**
+ * @brief 定时器基地址的 6 位散列键
+ *
+ * 地址位 [14:10] 加上 APB2 标志（位 16）：APB1 的 TIM2~TIM7、TIM12~TIM14
+ * 为 0~8，APB2 的 TIM1/TIM8 为 32/33，TIM9~TIM11 为 48~50，互不冲突。
+ */
+[[nodiscard]] constexpr std::size_t timer_key(uintptr_t address) {
+  return ((address >> 10U) & 0x1FU) | ((address >> 11U) & 0x20U);
+}
+
+[[nodiscard]] constexpr std::array<uint8_t, 64> make_timer_keys() {
+  std::array<uint8_t, 64> keys{};
+  for (std::size_t id = 1; id <= timer_count; ++id) {
+    keys[timer_key(timer_bases[id])] = static_cast<uint8_t>(id);
+  }
+  return keys;
+}
+
+inline constexpr std::array<uint8_t, 64> timer_keys = make_timer_keys();
+
+[[nodiscard]] constexpr bool timer_keys_unique() {
+  for (std::size_t id = 1; id <= timer_count; ++id) {
+    if (timer_keys[timer_key(timer_bases[id])] != id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(timer_keys_unique(), "timer base address keys collide");
+
+} // namespace detail
+
+/**
+ * @brief 由定时器基地址得到 timer_id（常数时间：一次查表加一次比较）
+ *
+ * 可在编译期使用：constexpr auto id = get_timer_id(TIM3_BASE);
+ * 其他外设地址可能与某个键相同，查表后比较基地址排除，返回 timer_id::none。
+ */
+[[nodiscard]] constexpr timer_id get_timer_id(uintptr_t address) {
+  const uint8_t id = detail::timer_keys[detail::timer_key(address)];
+  return id != 0U && detail::timer_bases[id] == address
+             ? static_cast<timer_id>(id)
+             : timer_id::none;
+}
+
+[[nodiscard]] inline timer_id get_timer_id(const TIM_TypeDef *instance) {
+  return get_timer_id(reinterpret_cast<uintptr_t>(instance));
+}
+
 // 获取UART实例索引
 [[nodiscard]] constexpr uint8_t get_uart_index(USART_TypeDef *uart_instance) {
   switch (reinterpret_cast<uintptr_t>(uart_instance)) {
@@ -144,6 +242,20 @@ enum class timer_id : uint8_t {
   }
 }
 
+// 获取I2C实例索引
+[[nodiscard]] constexpr uint8_t get_i2c_index(I2C_TypeDef *i2c_instance) {
+  switch (reinterpret_cast<uintptr_t>(i2c_instance)) {
+  case I2C1_BASE:
+    return 0;
+  case I2C2_BASE:
+    return 1;
+  case I2C3_BASE:
+    return 2;
+  default:
+    return 0xFF;
+  }
+}
+
 enum class dma_stream_type : uint8_t {
   dma1_stream0,
   dma1_stream1,
@@ -203,6 +315,23 @@ get_dma_stream(dma_stream_type type) {
   }
 }
 
+/// 地址是否位于 CCM RAM（0x10000000~0x1000FFFF）
+[[nodiscard]] inline bool is_ccmram_address(const void *address) noexcept {
+  const auto addr = reinterpret_cast<uintptr_t>(address);
+  return addr - CCMDATARAM_BASE <= CCMDATARAM_END - CCMDATARAM_BASE;
+}
+
+/**
+ * @brief 地址能否作为 DMA 的存储器端
+ *
+ * F407 上 CCM RAM 只连接在 D 总线上，任何 DMA 控制器都无法访问。
+ * CCM 是独立的 64 KB 区域，合法缓冲区不会跨越其边界，只需检查起始地址；
+ * 一次减法加一次比较，可放在每次传输的启动路径上。
+ */
+[[nodiscard]] inline bool is_dma_capable_address(const void *address) noexcept {
+  return !is_ccmram_address(address);
+}
+
 enum class dma_channel : uint32_t {
   channel_0 = DMA_CHANNEL_0,
   channel_1 = DMA_CHANNEL_1,
@@ -78,8 +78,11 @@ private:
       return false;
     }
 
-    // 初始化 DMA 代理（调用 HAL_DMA_Init 初始化 DMA 句柄）
-    m_tx_dma->init();
+    // 准备 DMA 代理（仅首次或配置变更后调用 HAL_DMA_Init）
+    if (!m_tx_dma->prepare()) {
+      m_uart->ErrorCode = HAL_UART_ERROR_DMA;
+      return false;
+    }
 
     // 覆盖 DMA 句柄的 Parent 与完成/错误回调，以便在 DMA 中断里恢复 UART 状态
     // 并通过 dma_proxy::call_dma_callback() 转发到用户回调。
@@ -104,8 +107,8 @@ private:
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data));
     const auto dst_addr = static_cast<uint32_t>(
         reinterpret_cast<uintptr_t>(&m_uart->Instance->DR));
-    if (HAL_DMA_Start_IT(hdma_tx, src_addr, dst_addr,
-                         static_cast<uint16_t>(size)) != HAL_OK) {
+    if (m_tx_dma->launch(src_addr, dst_addr, static_cast<uint16_t>(size)) !=
+        HAL_OK) {
       m_uart->ErrorCode = HAL_UART_ERROR_DMA;
       m_uart->gState = HAL_UART_STATE_READY;
       return false;
@@ -129,8 +132,11 @@ private:
       return false; // 已有接收在进行中
     }
 
-    // 初始化 DMA 代理（调用 HAL_DMA_Init 初始化 DMA 句柄）
-    m_rx_dma->init();
+    // 准备 DMA 代理（仅首次或配置变更后调用 HAL_DMA_Init）
+    if (!m_rx_dma->prepare()) {
+      m_uart->ErrorCode = HAL_UART_ERROR_DMA;
+      return false;
+    }
 
     // 覆盖 DMA 句柄的 Parent 与完成/错误回调，以便在 DMA 中断里恢复 UART 状态
     // 并通过 dma_proxy::call_dma_callback() 转发到用户回调。
@@ -154,8 +160,8 @@ private:
         reinterpret_cast<uintptr_t>(&m_uart->Instance->DR));
     const auto dst_addr =
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buffer));
-    if (HAL_DMA_Start_IT(hdma_rx, src_addr, dst_addr,
-                         static_cast<uint16_t>(size)) != HAL_OK) {
+    if (m_rx_dma->launch(src_addr, dst_addr, static_cast<uint16_t>(size)) !=
+        HAL_OK) {
       m_uart->ErrorCode = HAL_UART_ERROR_DMA;
       m_uart->RxState = HAL_UART_STATE_READY;
       return false;
@@ -0,0 +1,184 @@
+#include "bsp_w25q.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gdut {
+
+namespace {
+
+constexpr uint8_t cmd_write_enable = 0x06;
+constexpr uint8_t cmd_read_status1 = 0x05;
+constexpr uint8_t cmd_read_data = 0x03;
+constexpr uint8_t cmd_page_program = 0x02;
+constexpr uint8_t cmd_sector_erase = 0x20;
+constexpr uint8_t cmd_block_erase = 0xD8;
+constexpr uint8_t cmd_release_power_down = 0xAB;
+constexpr uint8_t cmd_jedec_id = 0x9F;
+
+constexpr uint8_t status_busy = 0x01;
+
+// 数据手册中的最长时间
+constexpr uint32_t page_program_max_ms = 3;
+constexpr uint32_t sector_erase_max_ms = 400;
+constexpr uint32_t block_erase_max_ms = 2000;
+
+// 24 位地址上限（容量代码 0x18）
+constexpr uint32_t max_capacity = 1U << 24U;
+
+} // namespace
+
+std::error_code w25q_flash::init() {
+  // m_status 与 m_buffer 随对象存放，对象位于 CCMRAM（如任务栈）时
+  // DMA 无法访问
+  if (!check_dma_buffer(m_buffer)) {
+    return std::make_error_code(std::errc::bad_address);
+  }
+  // 芯片可能处于掉电模式；唤醒后 3 µs 内不能发送其他命令
+  m_buffer[0] = cmd_release_power_down;
+  if (std::error_code ec =
+          m_device->transfer({m_buffer, 1}, {}, spi_priority::low)) {
+    return ec;
+  }
+  (void)osDelay(1);
+
+  m_buffer[0] = cmd_jedec_id;
+  if (std::error_code ec = m_device->transfer({m_buffer, 1}, {&m_buffer[1], 3},
+                                              spi_priority::low)) {
+    return ec;
+  }
+  const uint8_t manufacturer = m_buffer[1];
+  const uint8_t capacity_code = m_buffer[3];
+  // 未接芯片时 MISO 全 0 或全 1；容量代码为 2 的幂次（0x14 = 1 MB）
+  if (manufacturer == 0x00U || manufacturer == 0xFFU ||
+      capacity_code < 0x10U || capacity_code > 0x22U) {
+    return w25q_error_code::not_found;
+  }
+  m_jedec_id = (static_cast<uint32_t>(manufacturer) << 16U) |
+               (static_cast<uint32_t>(m_buffer[2]) << 8U) | capacity_code;
+  m_capacity = capacity_code >= 24U ? max_capacity : 1U << capacity_code;
+
+  // 复位前可能有未完成的擦除
+  return wait_ready(block_erase_max_ms);
+}
+
+std::error_code w25q_flash::read(uint32_t address, std::span<uint8_t> buffer) {
+  if (address > m_capacity || buffer.size() > m_capacity - address) {
+    return w25q_error_code::out_of_range;
+  }
+  if (std::error_code ec = wait_previous()) {
+    return ec;
+  }
+  // 单次 DMA 传输不超过 65535 字节
+  while (!buffer.empty()) {
+    const std::size_t chunk = std::min<std::size_t>(buffer.size(), 0xFFFFU);
+    set_address(cmd_read_data, address);
+    if (std::error_code ec = m_device->transfer(
+            {m_buffer, 4}, buffer.first(chunk), spi_priority::low)) {
+      return ec;
+    }
+    address += static_cast<uint32_t>(chunk);
+    buffer = buffer.subspan(chunk);
+  }
+  return {};
+}
+
+std::error_code w25q_flash::program(uint32_t address,
+                                    std::span<const uint8_t> data) {
+  if (data.empty() || address >= m_capacity ||
+      data.size() > m_capacity - address ||
+      (address % page_size) + data.size() > page_size) {
+    return w25q_error_code::out_of_range;
+  }
+  if (std::error_code ec = wait_previous()) {
+    return ec;
+  }
+  if (std::error_code ec = write_enable()) {
+    return ec;
+  }
+  set_address(cmd_page_program, address);
+  std::memcpy(&m_buffer[4], data.data(), data.size());
+  if (std::error_code ec = m_device->transfer({m_buffer, 4 + data.size()}, {},
+                                              spi_priority::low)) {
+    return ec;
+  }
+  m_ready_timeout_ms = page_program_max_ms;
+  return {};
+}
+
+std::error_code w25q_flash::erase(uint32_t address) {
+  return start_erase(cmd_sector_erase, address, erase_size,
+                     sector_erase_max_ms);
+}
+
+std::error_code w25q_flash::erase_block(uint32_t address) {
+  return start_erase(cmd_block_erase, address, block_size,
+                     block_erase_max_ms);
+}
+
+bool w25q_flash::busy() {
+  m_buffer[0] = cmd_read_status1;
+  std::error_code ec =
+      m_device->transfer({m_buffer, 1}, {&m_status, 1}, spi_priority::low);
+  const bool is_busy = ec || (m_status & status_busy) != 0U;
+  if (!is_busy) {
+    m_ready_timeout_ms = 0;
+  }
+  return is_busy;
+}
+
+std::error_code w25q_flash::wait_ready(uint32_t timeout_ms) {
+  const uint32_t start = osKernelGetTickCount();
+  const uint32_t timeout_ticks =
+      (timeout_ms * osKernelGetTickFreq() + 999U) / 1000U;
+  while (busy()) {
+    if (osKernelGetTickCount() - start > timeout_ticks) {
+      return w25q_error_code::timeout;
+    }
+    (void)osDelay(1);
+  }
+  return {};
+}
+
+std::error_code w25q_flash::wait_previous() {
+  // 没有未完成的命令时不查询状态
+  if (m_ready_timeout_ms == 0U) {
+    return {};
+  }
+  return wait_ready(m_ready_timeout_ms);
+}
+
+std::error_code w25q_flash::write_enable() {
+  m_buffer[0] = cmd_write_enable;
+  return m_device->transfer({m_buffer, 1}, {}, spi_priority::low);
+}
+
+std::error_code w25q_flash::start_erase(uint8_t command, uint32_t address,
+                                        std::size_t size,
+                                        uint32_t timeout_ms) {
+  if (address >= m_capacity) {
+    return w25q_error_code::out_of_range;
+  }
+  if (std::error_code ec = wait_previous()) {
+    return ec;
+  }
+  if (std::error_code ec = write_enable()) {
+    return ec;
+  }
+  set_address(command, address & ~static_cast<uint32_t>(size - 1U));
+  if (std::error_code ec =
+          m_device->transfer({m_buffer, 4}, {}, spi_priority::low)) {
+    return ec;
+  }
+  m_ready_timeout_ms = timeout_ms;
+  return {};
+}
+
+void w25q_flash::set_address(uint8_t command, uint32_t address) {
+  m_buffer[0] = command;
+  m_buffer[1] = static_cast<uint8_t>(address >> 16U);
+  m_buffer[2] = static_cast<uint8_t>(address >> 8U);
+  m_buffer[3] = static_cast<uint8_t>(address);
+}
+
+} // namespace gdut
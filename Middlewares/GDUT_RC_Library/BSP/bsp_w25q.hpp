@@ -0,0 +1,173 @@
+#ifndef BSP_W25Q_HPP
+#define BSP_W25Q_HPP
+
+#include "bsp_spi_bus.hpp"
+#include "bsp_uncopyable.hpp"
+#include "cmsis_os2.h"
+#include "stm32f4xx_hal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+
+namespace gdut {
+
+/**
+ * @brief W25Qxx 驱动错误码（SPI 传输错误沿用 spi_bus 的错误码）
+ */
+enum class w25q_error_code : uint32_t {
+  none = 0,
+  not_found,   ///< JEDEC ID 无效（未接 Flash 或片选错误）
+  timeout,     ///< 等待编程/擦除完成超时
+  out_of_range ///< 地址越界或编程跨页
+};
+
+/**
+ * @brief w25q_error_code 的 std::error_category 实现
+ */
+class w25q_error_category : public std::error_category {
+public:
+  constexpr w25q_error_category() noexcept = default;
+
+  const char *name() const noexcept override { return "w25q_error_code"; }
+
+  std::string message(int ev) const override {
+    switch (static_cast<w25q_error_code>(ev)) {
+    case w25q_error_code::none:
+      return "No error";
+    case w25q_error_code::not_found:
+      return "Invalid JEDEC ID";
+    case w25q_error_code::timeout:
+      return "Program/erase timeout";
+    case w25q_error_code::out_of_range:
+      return "Address out of range";
+    default:
+      return "Unknown error";
+    }
+  }
+
+  static const w25q_error_category &instance() {
+    static w25q_error_category instance;
+    return instance;
+  }
+};
+
+inline std::error_code make_error_code(w25q_error_code e) {
+  return {static_cast<int>(e), w25q_error_category::instance()};
+}
+
+} // namespace gdut
+
+namespace std {
+
+/// 启用 gdut::w25q_error_code 到 std::error_code 的隐式转换
+template <> struct is_error_code_enum<gdut::w25q_error_code> : true_type {};
+
+} // namespace std
+
+namespace gdut {
+
+/**
+ * @brief W25Qxx 系列 SPI NOR Flash 驱动（24 位地址，最大 16 MB）
+ *
+ * 挂在 spi_bus 上，所有命令都是低优先级事务，页编程与读取的数据阶段
+ * 由 DMA 完成；等待编程/擦除期间任务休眠，总线可供其他设备使用。
+ *
+ * 特性：
+ * - program()/erase() 发出命令后立即返回，不等待芯片完成；下一条命令
+ *   发出前才等待 BUSY 清零。调用方可以在编程/擦除期间做其他事，
+ *   用 busy() 查询进度（后台擦除）
+ * - 容量由 JEDEC ID 的容量字节得出，兼容同类 JEDEC 标准 SPI NOR
+ *
+ * 线程安全：
+ * - 不提供内部同步，应由单一任务使用；所有接口仅任务上下文
+ *
+ * 重要约束：
+ * - 对象内的 m_status 与 m_buffer 是 DMA 收发缓冲区，对象不能位于 CCMRAM。
+ *   任务栈与 pvPortMalloc 的内存默认来自 CCM（见 bsp_heap.hpp），因此不要
+ *   把 w25q_flash 定义为任务函数的局部变量或用 new 创建，应定义为全局/
+ *   静态对象（可加 GDUT_DMA_BUFFER）；init() 检查对象地址，位于 CCMRAM 时
+ *   返回 bad_address（GDUT_DMA_BUFFER_CHECK_FATAL 时直接终止）
+ * - read() 的缓冲区不能位于 CCMRAM
+ * - 超过 16 MB 的芯片只使用前 16 MB（不切换 4 字节地址模式）
+ *
+ * 使用示例：
+ * @code
+ * gdut::spi_device flash_dev(spi1, flash_cs,
+ *                            {gdut::spi_clock_polarity::low,
+ *                             gdut::spi_clock_phase::first_edge,
+ *                             gdut::spi_baud_rate_prescaler::div4});
+ * gdut::w25q_flash flash(flash_dev); // 全局对象，不在任务栈上
+ *
+ * if (!flash.init()) {
+ *   flash.erase(0x000000);        // 发出扇区擦除后立即返回
+ *   flash.program(0x000000, page); // 先等待擦除完成，再编程
+ * }
+ * @endcode
+ */
+class w25q_flash : uncopyable {
+public:
+  static constexpr std::size_t page_size = 256;
+  /// erase() 的擦除单位（扇区）
+  static constexpr std::size_t erase_size = 4096;
+  /// erase_block() 的擦除单位
+  static constexpr std::size_t block_size = 65536;
+
+  explicit w25q_flash(spi_device &device) : m_device(&device) {}
+  ~w25q_flash() noexcept = default;
+
+  /**
+   * @brief 唤醒芯片并读取 JEDEC ID、确定容量
+   * @return 对象位于 CCMRAM（DMA 无法访问内部缓冲区）时返回 bad_address
+   */
+  std::error_code init();
+
+  [[nodiscard]] uint32_t capacity() const noexcept { return m_capacity; }
+  /// 制造商 ID（高字节）、存储器类型、容量代码
+  [[nodiscard]] uint32_t jedec_id() const noexcept { return m_jedec_id; }
+
+  /// 读取任意长度的数据（等待上一条编程/擦除完成）
+  std::error_code read(uint32_t address, std::span<uint8_t> buffer);
+
+  /**
+   * @brief 页编程：data 不能跨越 256 字节页边界
+   *
+   * 数据复制到驱动内部缓冲区后发出，调用返回后 data 即可复用。
+   * 不等待编程完成（典型 0.7 ms）。
+   */
+  std::error_code program(uint32_t address, std::span<const uint8_t> data);
+
+  /// 发出 4 KB 扇区擦除后立即返回（典型 45 ms，最长 400 ms）
+  std::error_code erase(uint32_t address);
+
+  /// 发出 64 KB 块擦除后立即返回（典型 150 ms，最长 2 s）
+  std::error_code erase_block(uint32_t address);
+
+  /// 芯片是否仍在编程/擦除；读取状态失败时按忙处理
+  [[nodiscard]] bool busy();
+
+  /// 等待编程/擦除完成，期间任务休眠
+  std::error_code wait_ready(uint32_t timeout_ms);
+
+private:
+  std::error_code wait_previous();
+  std::error_code write_enable();
+  std::error_code start_erase(uint8_t command, uint32_t address,
+                              std::size_t size, uint32_t timeout_ms);
+  void set_address(uint8_t command, uint32_t address);
+
+  spi_device *m_device;
+  uint32_t m_capacity{0};
+  uint32_t m_jedec_id{0};
+  /// 上一条命令的最长完成时间，下一条命令前以此为等待上限
+  uint32_t m_ready_timeout_ms{0};
+
+  uint8_t m_status{0};
+  // 命令 + 24 位地址 + 一页数据，作为 DMA 发送缓冲区
+  uint8_t m_buffer[4 + page_size]{};
+};
+
+} // namespace gdut
+
+#endif // BSP_W25Q_HPP
@@ -0,0 +1,141 @@
+#include "bsp_ws2812.hpp"
+
+namespace gdut {
+
+namespace {
+
+// 0.4 µs / 1.25 µs 与 0.8 µs / 1.25 µs，以 1/25 周期为单位
+constexpr uint32_t code0_25ths = 8U;
+constexpr uint32_t code1_25ths = 16U;
+constexpr uint32_t min_bit_rate = 700000U;
+constexpr uint32_t max_bit_rate = 900000U;
+
+} // namespace
+
+ws2812::ws2812(timer &tim, uint32_t channel, std::span<rgb_color> pixels)
+    : m_timer(&tim), m_pwm(&tim), m_channel(channel), m_pixels(pixels) {
+  TIM_HandleTypeDef *htim = tim.get_htim();
+  if (htim == nullptr || channel > TIM_CHANNEL_4 || channel % 4U != 0U) {
+    return;
+  }
+  m_hdma = htim->hdma[TIM_DMA_ID_CC1 + channel / 4U];
+  if (m_hdma == nullptr) {
+    return;
+  }
+  tim.register_pulse_half_callback([this] { on_transfer_half(0); });
+  tim.register_pulse_finished_callback([this] { on_transfer_half(1); });
+}
+
+ws2812::~ws2812() noexcept {
+  if (!valid()) {
+    return;
+  }
+  if (m_busy) {
+    (void)m_pwm.pwm_stop_dma(m_channel);
+    m_busy = false;
+  }
+  m_timer->register_pulse_half_callback({});
+  m_timer->register_pulse_finished_callback({});
+}
+
+HAL_StatusTypeDef ws2812::start() {
+  if (!valid() || m_busy) {
+    return HAL_ERROR;
+  }
+  const DMA_InitTypeDef &init = m_hdma->Init;
+  if (init.Direction != DMA_MEMORY_TO_PERIPH || init.Mode != DMA_CIRCULAR ||
+      init.MemInc != DMA_MINC_ENABLE ||
+      init.PeriphDataAlignment != DMA_PDATAALIGN_WORD ||
+      init.MemDataAlignment != DMA_MDATAALIGN_WORD ||
+      !check_dma_buffer(m_buffer)) {
+    return HAL_ERROR;
+  }
+  const uint32_t bit_rate = m_timer->get_frequency();
+  if (bit_rate < min_bit_rate || bit_rate > max_bit_rate) {
+    return HAL_ERROR;
+  }
+
+  TIM_TypeDef *tim = m_timer->get_htim()->Instance;
+  const uint32_t period = tim->ARR + 1U;
+  m_code0 = period * code0_25ths / 25U;
+  m_code1 = period * code1_25ths / 25U;
+
+  // 复位所需的 PWM 周期数，向上取整到半区
+  const uint32_t reset_bits = reset_us * (bit_rate / 1000U) / 1000U + 1U;
+  m_reset_pairs = (reset_bits + half_size - 1U) / half_size;
+
+  // OCxPE：DMA 写入预装载寄存器，每个比较值恰好占一个完整周期
+  const std::size_t index = m_channel / 4U;
+  volatile uint32_t &ccmr = index < 2U ? tim->CCMR1 : tim->CCMR2;
+  ccmr |= index % 2U != 0U ? TIM_CCMR1_OC2PE : TIM_CCMR1_OC1PE;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef ws2812::show() {
+  if (!valid() || m_code1 == 0U) {
+    return HAL_ERROR;
+  }
+  if (m_busy) {
+    return HAL_BUSY;
+  }
+  m_data_pairs = (m_pixels.size() + leds_per_half - 1U) / leds_per_half;
+  m_total_pairs = m_data_pairs + m_reset_pairs;
+  m_sent = 0;
+  encode(0, 0);
+  encode(1, 1);
+  // 第一个半区发送完毕之前不会进入回调，先置位再启动
+  m_busy = true;
+  // HAL 的 PWM DMA 回调经 hdma->Parent 找回 htim，其它驱动可能改写过它
+  m_hdma->Parent = m_timer->get_htim();
+  __HAL_TIM_SET_COMPARE(m_timer->get_htim(), m_channel, 0U);
+  const HAL_StatusTypeDef status =
+      m_pwm.pwm_start_dma(m_channel, m_buffer, 2U * half_size);
+  if (status != HAL_OK) {
+    m_busy = false;
+  }
+  return status;
+}
+
+void ws2812::on_transfer_half(std::size_t half) noexcept {
+  const TIM_HandleTypeDef *htim = m_timer->get_htim();
+  // 同一定时器其它通道的脉冲结束中断也会进入这里
+  if (!m_busy || htim->Channel != (1U << (m_channel / 4U))) {
+    return;
+  }
+  m_sent = m_sent + 1U;
+  if (m_sent >= m_total_pairs) {
+    (void)m_pwm.pwm_stop_dma(m_channel);
+    m_busy = false;
+    return;
+  }
+  // 另一个半区正在发送第 m_sent 对，刚发完的半区装入下一对
+  encode(half, m_sent + 1U);
+}
+
+void ws2812::encode(std::size_t half, std::size_t pair) noexcept {
+  uint32_t *out = m_buffer + half * half_size;
+  std::size_t index = pair * leds_per_half;
+  for (std::size_t i = 0; i < leds_per_half; ++i, ++index) {
+    if (index >= m_pixels.size()) {
+      // 数据之后全为 0：比较值 0 即整个周期低电平，构成复位
+      for (std::size_t bit = 0; bit < bits_per_led; ++bit) {
+        *out++ = 0U;
+      }
+      continue;
+    }
+    const rgb_color &c = m_pixels[index];
+    out = encode_byte(out, scale(c.g));
+    out = encode_byte(out, scale(c.r));
+    out = encode_byte(out, scale(c.b));
+  }
+}
+
+uint32_t *ws2812::encode_byte(uint32_t *out, uint8_t value) const noexcept {
+  // 高位先发
+  for (uint32_t mask = 0x80U; mask != 0U; mask >>= 1U) {
+    *out++ = (value & mask) != 0U ? m_code1 : m_code0;
+  }
+  return out;
+}
+
+} // namespace gdut
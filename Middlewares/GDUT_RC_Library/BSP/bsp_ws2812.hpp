@@ -0,0 +1,137 @@
+#ifndef BSP_WS2812_HPP
+#define BSP_WS2812_HPP
+
+#include "bsp_dma.hpp"
+#include "bsp_timer.hpp"
+#include "bsp_uncopyable.hpp"
+#include "stm32f4xx_hal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gdut {
+
+/// 一个像素的颜色（发送时按 WS2812 的 GRB 顺序编码）
+struct rgb_color {
+  uint8_t r{};
+  uint8_t g{};
+  uint8_t b{};
+};
+
+/**
+ * @brief 以定时器 PWM + 循环 DMA 驱动 WS2812 灯带
+ *
+ * 每个数据位对应一个 PWM 周期（800 kHz），比较值决定高电平宽度。
+ * 预先把整条灯带编码成比较值需要每个 LED 24 个字；本类只保留两个半区、
+ * 每个半区两个 LED 的比较值缓冲区，经 timer_pwm::pwm_start_dma() 以循环
+ * DMA 发送，在半完成/完成中断中把下一对 LED 编码进刚发完的半区。
+ *
+ * 特性：
+ * - 缓冲区大小固定（96 个字），与灯带长度无关
+ * - 每个中断编码两个 LED，只做移位与比较，开销约 1 µs
+ * - 数据发完后自动追加不少于 reset_us 的低电平作为复位（锁存），
+ *   随后停止 DMA
+ * - 全局亮度在编码时缩放，像素缓冲区保存原始颜色
+ *
+ * 线程安全：
+ * - show()/busy()/set_brightness() 只能由同一个任务调用
+ * - busy() 为 true 期间不要修改像素缓冲区，否则本帧可能前后不一致
+ *
+ * 重要约束：
+ * - 定时器 PSC/ARR 须配置为 800 kHz（允许 700~900 kHz）的 PWM，
+ *   start() 检查实际频率
+ * - 通道的 DMA（htim->hdma[TIM_DMA_ID_CCx]）须配置为：存储器到外设、
+ *   循环模式、存储器地址递增、外设与存储器数据宽度均为字（Word），
+ *   并使能 DMA 中断；该 DMA 句柄不要再传给 timer 的构造函数
+ * - 传输完成/半完成经由 timer_irq_handler 分发，应用不得再定义
+ *   HAL_TIM_PWM_PulseFinishedCallback / ...HalfCpltCallback
+ * - DMA 中断须在一个半区的发送时间（约 60 µs）内得到响应，
+ *   否则灯带收到的数据错位
+ * - 两帧之间通道输出关闭，数据引脚须配置下拉（或外接下拉电阻）
+ * - 对象内含 DMA 缓冲区，不能定义在 CCMRAM 中
+ *
+ * 使用示例：
+ * @code
+ * gdut::timer led_timer(&htim3); // PSC=0, ARR=104（84 MHz / 105 = 800 kHz）
+ * std::array<gdut::rgb_color, 16> leds{};
+ * gdut::ws2812 strip(led_timer, TIM_CHANNEL_1, leds);
+ *
+ * leds.fill({0, 0, 255}); // 蓝方
+ * strip.set_brightness(64);
+ * strip.show();
+ * @endcode
+ */
+class ws2812 : uncopyable {
+public:
+  static constexpr std::size_t bits_per_led = 24;
+  static constexpr std::size_t leds_per_half = 2;
+  static constexpr std::size_t half_size = bits_per_led * leds_per_half;
+  /// 复位低电平时长（WS2812B 新批次要求 280 µs 以上）
+  static constexpr uint32_t reset_us = 300;
+
+  /**
+   * @brief 绑定定时器通道并接管定时器的 PWM 脉冲结束回调
+   *
+   * @param pixels  像素缓冲区，由调用者持有，生命周期须长于本对象
+   */
+  ws2812(timer &tim, uint32_t channel, std::span<rgb_color> pixels);
+  ~ws2812() noexcept;
+
+  [[nodiscard]] bool valid() const noexcept { return m_hdma != nullptr; }
+
+  explicit operator bool() const noexcept { return valid(); }
+
+  /**
+   * @brief 检查定时器与 DMA 配置，并根据 ARR 计算 0/1 码的比较值
+   *
+   * @return 配置不符合要求或缓冲区位于 CCMRAM 时返回 HAL_ERROR
+   */
+  HAL_StatusTypeDef start();
+
+  /**
+   * @brief 发送一帧（整条灯带）并在其后追加复位低电平
+   *
+   * @return 上一帧仍在发送时返回 HAL_BUSY
+   */
+  HAL_StatusTypeDef show();
+
+  /// 正在发送一帧（含复位时间）
+  [[nodiscard]] bool busy() const noexcept { return m_busy; }
+
+  /// 全局亮度，0~255，255 为原始颜色
+  void set_brightness(uint8_t brightness) noexcept {
+    m_scale = static_cast<uint16_t>(brightness) + 1U;
+  }
+
+  [[nodiscard]] std::span<rgb_color> pixels() const noexcept {
+    return m_pixels;
+  }
+
+private:
+  void on_transfer_half(std::size_t half) noexcept;
+  void encode(std::size_t half, std::size_t pair) noexcept;
+  uint32_t *encode_byte(uint32_t *out, uint8_t value) const noexcept;
+  [[nodiscard]] uint8_t scale(uint8_t value) const noexcept {
+    return static_cast<uint8_t>((value * m_scale) >> 8U);
+  }
+
+  timer *m_timer{nullptr};
+  timer::timer_pwm m_pwm;
+  DMA_HandleTypeDef *m_hdma{nullptr};
+  uint32_t m_channel{};
+  std::span<rgb_color> m_pixels{};
+  uint32_t m_code0{}; // 0 码高电平宽度（约 0.4 µs）
+  uint32_t m_code1{}; // 1 码高电平宽度（约 0.8 µs）
+  uint16_t m_scale{256};
+  std::size_t m_reset_pairs{}; // 复位低电平占用的半区数
+  std::size_t m_data_pairs{};  // 数据占用的半区数
+  std::size_t m_total_pairs{}; // 数据加复位的半区数
+  std::size_t m_sent{};        // 已发送完毕的半区数
+  volatile bool m_busy{false};
+  uint32_t m_buffer[2 * half_size]{};
+};
+
+} // namespace gdut
+
+#endif // BSP_WS2812_HPP
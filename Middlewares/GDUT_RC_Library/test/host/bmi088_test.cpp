@@ -0,0 +1,454 @@
+#include "bsp_bmi088.hpp"
+#include "host_test.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <system_error>
+
+namespace {
+
+using gdut::bmi088;
+using gdut::bmi088_chip;
+
+/**
+ * 脚本化的 BMI088：按数据手册模拟两颗芯片的寄存器、加速度计上电后的
+ * I2C 模式、软复位与上电后的等待时间；可注入传输错误、提交失败与
+ * 被芯片忽略的写入。时间只由 delay_ms() 推进。
+ */
+class fake_bmi088 final : public gdut::bmi088_transport {
+public:
+  struct chip_state {
+    std::array<uint8_t, 128> regs{};
+    std::array<bool, 128> ignore_write{};
+    bool spi_mode{true};
+    uint32_t ready_at_ms{0};
+    uint32_t resets{0};
+  };
+
+  fake_bmi088() {
+    reset(accel);
+    reset(gyro);
+    accel.regs[0x00] = accel_id;
+    gyro.regs[0x00] = gyro_id;
+    // 加速度计上电后处于 I2C 模式
+    accel.spi_mode = false;
+  }
+
+  std::error_code transfer(bmi088_chip chip, std::span<const uint8_t> tx,
+                           std::span<uint8_t> rx) override {
+    const uint32_t index = transfers++;
+    if (fail_transfer_at == index) {
+      return fail_code;
+    }
+    chip_state &state = select(chip);
+    if (time_ms < state.ready_at_ms) {
+      ++timing_violations;
+    }
+    if (!state.spi_mode) {
+      // 片选的上升沿把加速度计切换到 SPI，本次访问无效
+      state.spi_mode = true;
+      std::fill(rx.begin(), rx.end(), 0x00);
+      return {};
+    }
+
+    const uint8_t reg = tx[0] & 0x7FU;
+    if ((tx[0] & 0x80U) == 0U) {
+      if (tx.size() == 2 && !rx.empty()) {
+        ++protocol_errors;
+      }
+      for (std::size_t i = 1; i < tx.size(); ++i) {
+        write(chip, static_cast<uint8_t>(reg + i - 1), tx[i]);
+      }
+      return {};
+    }
+    // 加速度计的读时序在地址之后多一个哑字节
+    const std::size_t skip = chip == bmi088_chip::accel ? 1U : 0U;
+    for (std::size_t i = 0; i < rx.size(); ++i) {
+      rx[i] = i < skip ? 0xA5 : read(chip, reg + (i - skip));
+    }
+    return {};
+  }
+
+  bool exchange(bmi088_chip chip, std::span<const uint8_t> tx,
+                std::span<uint8_t> rx, callback_t &&callback) override {
+    if (reject_exchange || pending || tx.size() != rx.size()) {
+      return false;
+    }
+    pending.emplace(chip, tx, rx, std::move(callback));
+    return true;
+  }
+
+  void delay_ms(uint32_t ms) override {
+    time_ms += ms;
+    delayed_ms += ms;
+  }
+
+  [[nodiscard]] uint32_t now() noexcept override { return cycles; }
+
+  /// 以“DMA 完成中断”结束挂起的 exchange()：按全双工时序填充接收缓冲区
+  bool complete(std::error_code ec = {}) {
+    if (!pending) {
+      return false;
+    }
+    exchange_request request = std::move(*pending);
+    pending.reset();
+    const std::size_t skip = request.chip == bmi088_chip::accel ? 2U : 1U;
+    const uint8_t reg = request.tx[0] & 0x7FU;
+    for (std::size_t i = 0; i < request.rx.size(); ++i) {
+      request.rx[i] = i < skip ? 0xA5 : read(request.chip, reg + (i - skip));
+    }
+    if (request.callback) {
+      request.callback(ec);
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool has_pending(bmi088_chip chip) const {
+    return pending && pending->chip == chip;
+  }
+
+  chip_state &select(bmi088_chip chip) {
+    return chip == bmi088_chip::accel ? accel : gyro;
+  }
+
+  void set_le16(bmi088_chip chip, uint8_t reg, int16_t value) {
+    select(chip).regs[reg] = static_cast<uint8_t>(value);
+    select(chip).regs[reg + 1] =
+        static_cast<uint8_t>(static_cast<uint16_t>(value) >> 8U);
+  }
+
+  chip_state accel;
+  chip_state gyro;
+  uint32_t time_ms{0};
+  uint32_t delayed_ms{0};
+  uint32_t cycles{0};
+  uint32_t transfers{0};
+  uint32_t timing_violations{0};
+  uint32_t protocol_errors{0};
+
+  uint8_t accel_id{0x1E};
+  uint8_t gyro_id{0x0F};
+  std::optional<uint32_t> fail_transfer_at;
+  std::error_code fail_code{std::make_error_code(std::errc::timed_out)};
+  bool reject_exchange{false};
+
+private:
+  struct exchange_request {
+    exchange_request(bmi088_chip chip, std::span<const uint8_t> tx,
+                     std::span<uint8_t> rx, callback_t &&callback)
+        : chip(chip), tx(tx), rx(rx), callback(std::move(callback)) {}
+
+    bmi088_chip chip;
+    std::span<const uint8_t> tx;
+    std::span<uint8_t> rx;
+    callback_t callback;
+  };
+
+  void reset(chip_state &state) {
+    state.regs.fill(0);
+    state.spi_mode = true;
+    ++state.resets;
+  }
+
+  void write(bmi088_chip chip, uint8_t reg, uint8_t value) {
+    chip_state &state = select(chip);
+    if (state.ignore_write[reg & 0x7FU]) {
+      return;
+    }
+    if (chip == bmi088_chip::accel && reg == 0x7E && value == 0xB6) {
+      reset(state);
+      state.spi_mode = false;
+      state.regs[0x00] = accel_id;
+      state.ready_at_ms = time_ms + 1;
+      return;
+    }
+    if (chip == bmi088_chip::gyro && reg == 0x14 && value == 0xB6) {
+      reset(state);
+      state.regs[0x00] = gyro_id;
+      state.ready_at_ms = time_ms + 30;
+      return;
+    }
+    state.regs[reg & 0x7FU] = value;
+    if (chip == bmi088_chip::accel && reg == 0x7D && value == 0x04) {
+      // 使能加速度计后须等待 5 ms 才能访问配置寄存器
+      state.ready_at_ms = time_ms + 5;
+    }
+  }
+
+  uint8_t read(bmi088_chip chip, std::size_t reg) {
+    const chip_state &state = select(chip);
+    uint8_t value = state.regs[reg & 0x7FU];
+    if (chip == bmi088_chip::gyro && reg == 0x10) {
+      value |= 0x80U; // GYRO_BANDWIDTH 的 bit7 读出恒为 1
+    }
+    return value;
+  }
+
+  std::optional<exchange_request> pending;
+};
+
+bool near(float a, float b) { return std::fabs(a - b) <= 1e-4F; }
+
+const gdut::bmi088_config test_config{
+    .gyro_range = gdut::bmi088_gyro_range::dps500,
+    .gyro_odr = gdut::bmi088_gyro_odr::hz1000_bw116,
+    .accel_range = gdut::bmi088_accel_range::g12,
+    .accel_odr = gdut::bmi088_accel_odr::hz800};
+
+void test_init_sequence() {
+  fake_bmi088 sensor;
+  bmi088 imu(sensor);
+  HOST_CHECK(!imu.init(test_config));
+
+  HOST_CHECK(sensor.timing_violations == 0);
+  HOST_CHECK(sensor.protocol_errors == 0);
+  HOST_CHECK(sensor.accel.resets == 2); // 上电 + 软复位
+  HOST_CHECK(sensor.gyro.resets == 2);
+  HOST_CHECK(sensor.accel.spi_mode);
+  HOST_CHECK(sensor.delayed_ms >= 1 + 30 + 5);
+
+  HOST_CHECK(sensor.accel.regs[0x7C] == 0x00);
+  HOST_CHECK(sensor.accel.regs[0x7D] == 0x04);
+  HOST_CHECK(sensor.accel.regs[0x40] == 0xAB); // normal 滤波 + 800 Hz
+  HOST_CHECK(sensor.accel.regs[0x41] == 0x02);
+  HOST_CHECK(sensor.gyro.regs[0x0F] == 0x02);
+  HOST_CHECK(sensor.gyro.regs[0x10] == 0x02);
+  HOST_CHECK(sensor.gyro.regs[0x15] == 0x80);
+  HOST_CHECK(sensor.gyro.regs[0x16] == 0x01);
+  HOST_CHECK(sensor.gyro.regs[0x18] == 0x01);
+  HOST_CHECK(!imu.running());
+}
+
+void test_init_errors() {
+  {
+    fake_bmi088 sensor;
+    sensor.accel_id = 0x00;
+    bmi088 imu(sensor);
+    HOST_CHECK(imu.init() == gdut::bmi088_error_code::accel_not_found);
+  }
+  {
+    fake_bmi088 sensor;
+    sensor.gyro_id = 0xFF;
+    bmi088 imu(sensor);
+    HOST_CHECK(imu.init() == gdut::bmi088_error_code::gyro_not_found);
+  }
+  {
+    fake_bmi088 sensor;
+    sensor.accel.ignore_write[0x41] = true; // ACC_RANGE
+    bmi088 imu(sensor);
+    HOST_CHECK(imu.init(test_config) ==
+               gdut::bmi088_error_code::config_rejected);
+  }
+  {
+    fake_bmi088 sensor;
+    sensor.gyro.ignore_write[0x10] = true; // GYRO_BANDWIDTH
+    bmi088 imu(sensor);
+    HOST_CHECK(imu.init(test_config) ==
+               gdut::bmi088_error_code::config_rejected);
+  }
+
+  // 初始化序列中任何一次传输失败都原样上报
+  fake_bmi088 reference;
+  bmi088 reference_imu(reference);
+  HOST_CHECK(!reference_imu.init());
+  HOST_CHECK(reference.transfers > 10);
+  for (uint32_t index = 0; index < reference.transfers; ++index) {
+    fake_bmi088 sensor;
+    sensor.fail_transfer_at = index;
+    bmi088 imu(sensor);
+    HOST_CHECK(imu.init() == std::errc::timed_out);
+  }
+}
+
+void test_decode() {
+  const uint8_t gyro_frame[bmi088::gyro_frame_size] = {
+      0x00, 0x34, 0x12, 0xFE, 0xFF, 0x00, 0x80};
+  uint8_t accel_frame[bmi088::accel_frame_size] = {0x00, 0xA5, 0x10, 0x00,
+                                                    0xF0, 0xFF, 0xFF, 0x7F};
+  // 温度：MSB 0x20、LSB 高 3 位 010 → 258 → 55.25 °C
+  accel_frame[2 + 0x10] = 0x20;
+  accel_frame[2 + 0x11] = 0x40;
+
+  gdut::bmi088_raw_sample raw =
+      bmi088::decode(1234, gyro_frame, accel_frame);
+  HOST_CHECK(raw.timestamp == 1234);
+  HOST_CHECK(raw.gyro[0] == 0x1234);
+  HOST_CHECK(raw.gyro[1] == -2);
+  HOST_CHECK(raw.gyro[2] == -32768);
+  HOST_CHECK(raw.accel[0] == 16);
+  HOST_CHECK(raw.accel[1] == -16);
+  HOST_CHECK(raw.accel[2] == 32767);
+  HOST_CHECK(raw.temperature == 258);
+
+  // 负温度的符号扩展：0xF0 << 3 = 1920 → -128 → 7 °C
+  accel_frame[2 + 0x10] = 0xF0;
+  accel_frame[2 + 0x11] = 0x00;
+  raw = bmi088::decode(0, gyro_frame, accel_frame);
+  HOST_CHECK(raw.temperature == -128);
+
+  fake_bmi088 sensor;
+  bmi088 imu(sensor);
+  HOST_CHECK(!imu.init(test_config));
+  const gdut::bmi088_sample sample = imu.convert(raw);
+  HOST_CHECK(near(sample.temperature, 7.0F));
+  const float dps = 500.0F / 32768.0F;
+  HOST_CHECK(near(sample.gyro[0], 0x1234 * dps *
+                                      std::numbers::pi_v<float> / 180.0F));
+  HOST_CHECK(near(sample.accel[2], 32767 * 12.0F / 32768.0F * 9.80665F));
+}
+
+/// 完成一次数据就绪触发的两段读取，返回是否入队
+bool acquire(fake_bmi088 &sensor, bmi088 &imu, uint32_t timestamp,
+             uint32_t latency) {
+  const uint32_t before = imu.stats().samples;
+  sensor.cycles = timestamp;
+  imu.data_ready_irq_handler();
+  if (!sensor.complete()) {
+    return false;
+  }
+  sensor.cycles = timestamp + latency;
+  return sensor.complete() && imu.stats().samples == before + 1;
+}
+
+void test_acquisition() {
+  fake_bmi088 sensor;
+  bmi088 imu(sensor);
+  HOST_CHECK(!imu.init(test_config));
+  sensor.set_le16(bmi088_chip::gyro, 0x02, 100);
+  sensor.set_le16(bmi088_chip::gyro, 0x04, -200);
+  sensor.set_le16(bmi088_chip::gyro, 0x06, 300);
+  sensor.set_le16(bmi088_chip::accel, 0x12, -1000);
+  sensor.set_le16(bmi088_chip::accel, 0x14, 2000);
+  sensor.set_le16(bmi088_chip::accel, 0x16, 2731);
+  sensor.accel.regs[0x22] = 0x01; // 8 → 24 °C
+
+  // 未 start() 时忽略数据就绪
+  imu.on_data_ready(10);
+  HOST_CHECK(!sensor.has_pending(bmi088_chip::gyro));
+
+  imu.start();
+  sensor.cycles = 1000;
+  imu.data_ready_irq_handler();
+  HOST_CHECK(sensor.has_pending(bmi088_chip::gyro));
+  HOST_CHECK(sensor.complete());
+  // 陀螺仪读取完成后才提交加速度计读取
+  HOST_CHECK(sensor.has_pending(bmi088_chip::accel));
+  HOST_CHECK(imu.available() == 0);
+  sensor.cycles = 1600;
+  HOST_CHECK(sensor.complete());
+  HOST_CHECK(imu.available() == 1);
+
+  gdut::bmi088_sample samples[4];
+  HOST_CHECK(imu.read(samples) == 1);
+  HOST_CHECK(samples[0].timestamp == 1000);
+  const float gyro_scale =
+      500.0F / 32768.0F * std::numbers::pi_v<float> / 180.0F;
+  const float accel_scale = 12.0F / 32768.0F * 9.80665F;
+  HOST_CHECK(near(samples[0].gyro[0], 100 * gyro_scale));
+  HOST_CHECK(near(samples[0].gyro[1], -200 * gyro_scale));
+  HOST_CHECK(near(samples[0].gyro[2], 300 * gyro_scale));
+  HOST_CHECK(near(samples[0].accel[0], -1000 * accel_scale));
+  HOST_CHECK(near(samples[0].accel[1], 2000 * accel_scale));
+  HOST_CHECK(near(samples[0].accel[2], 2731 * accel_scale));
+  HOST_CHECK(near(samples[0].temperature, 24.0F));
+
+  gdut::bmi088_stats stats = imu.stats();
+  HOST_CHECK(stats.samples == 1);
+  HOST_CHECK(stats.latency_max == 600);
+  HOST_CHECK(stats.jitter() == 0);
+
+  // 读取未完成时到来的数据就绪被丢弃
+  sensor.cycles = 2000;
+  imu.data_ready_irq_handler();
+  imu.on_data_ready(2400);
+  HOST_CHECK(sensor.complete());
+  HOST_CHECK(sensor.complete());
+  stats = imu.stats();
+  HOST_CHECK(stats.dropped_busy == 1);
+  HOST_CHECK(stats.samples == 2);
+  // 周期：1000、400
+  HOST_CHECK(stats.period_min == 400);
+  HOST_CHECK(stats.period_max == 1000);
+  HOST_CHECK(stats.jitter() == 600);
+}
+
+void test_bus_errors() {
+  fake_bmi088 sensor;
+  bmi088 imu(sensor);
+  HOST_CHECK(!imu.init());
+  imu.start();
+
+  // 提交失败
+  sensor.reject_exchange = true;
+  imu.on_data_ready(100);
+  sensor.reject_exchange = false;
+  HOST_CHECK(imu.stats().bus_errors == 1);
+  // 失败后不会卡在“读取中”
+  HOST_CHECK(acquire(sensor, imu, 200, 10));
+
+  // 陀螺仪读取出错：不提交加速度计读取
+  imu.on_data_ready(300);
+  HOST_CHECK(sensor.complete(std::make_error_code(std::errc::io_error)));
+  HOST_CHECK(!sensor.has_pending(bmi088_chip::accel));
+  // 加速度计读取出错：不入队半个样本
+  imu.on_data_ready(400);
+  HOST_CHECK(sensor.complete());
+  HOST_CHECK(sensor.complete(std::make_error_code(std::errc::io_error)));
+
+  const gdut::bmi088_stats stats = imu.stats();
+  HOST_CHECK(stats.bus_errors == 3);
+  HOST_CHECK(stats.samples == 1);
+  HOST_CHECK(imu.available() == 1);
+  HOST_CHECK(acquire(sensor, imu, 500, 10));
+
+  imu.reset_stats();
+  HOST_CHECK(imu.stats().bus_errors == 0);
+  HOST_CHECK(imu.stats().samples == 0);
+}
+
+void test_ring_overflow() {
+  fake_bmi088 sensor;
+  bmi088 imu(sensor);
+  HOST_CHECK(!imu.init());
+  imu.start();
+
+  const uint32_t total = bmi088::ring_size + 3;
+  for (uint32_t i = 0; i < total; ++i) {
+    imu.on_data_ready(i * 500U);
+    sensor.complete();
+    sensor.complete();
+  }
+  const gdut::bmi088_stats stats = imu.stats();
+  HOST_CHECK(stats.samples == bmi088::ring_size);
+  HOST_CHECK(stats.dropped_full == 3);
+  HOST_CHECK(imu.available() == bmi088::ring_size);
+
+  // 丢弃的是新样本，已入队的样本保持时间顺序
+  gdut::bmi088_raw_sample raw[bmi088::ring_size + 1];
+  HOST_CHECK(imu.read_raw(raw) == bmi088::ring_size);
+  for (uint32_t i = 0; i < bmi088::ring_size; ++i) {
+    HOST_CHECK(raw[i].timestamp == i * 500U);
+  }
+  HOST_CHECK(imu.available() == 0);
+
+  // stop() 后不再响应
+  imu.stop();
+  imu.on_data_ready(123456);
+  HOST_CHECK(!sensor.has_pending(bmi088_chip::gyro));
+}
+
+} // namespace
+
+int main() {
+  test_init_sequence();
+  test_init_errors();
+  test_decode();
+  test_acquisition();
+  test_bus_errors();
+  test_ring_overflow();
+  return host_test::finish();
+}
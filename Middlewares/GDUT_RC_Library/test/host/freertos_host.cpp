@@ -0,0 +1,33 @@
+#include "freertos_host.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// 链接脚本符号：.ccmram 之后剩余的 CCM RAM。_eccm_heap 由 CMake 以
+// --defsym 定义为 _sccm_heap + GDUT_HOST_CCM_HEAP_SIZE
+extern "C" {
+alignas(8) uint8_t _sccm_heap[host_test::host_ccm_heap_size];
+}
+
+namespace host_test {
+
+int &scheduler_suspended() {
+  static int depth = 0;
+  return depth;
+}
+
+} // namespace host_test
+
+// bsp_heap.cpp 用到的调度器接口：只记录挂起深度，供测试检查成对调用
+extern "C" {
+
+void vTaskSuspendAll(void) { ++host_test::scheduler_suspended(); }
+
+BaseType_t xTaskResumeAll(void) {
+  if (--host_test::scheduler_suspended() < 0) {
+    abort();
+  }
+  return pdFALSE;
+}
+
+} // extern "C"
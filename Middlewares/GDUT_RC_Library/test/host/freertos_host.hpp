@@ -0,0 +1,17 @@
+#ifndef FREERTOS_HOST_HPP
+#define FREERTOS_HOST_HPP
+
+#include <cstddef>
+
+// 链接 bsp_heap.cpp 的主机测试共用的 FreeRTOS 替身（freertos_host.cpp）
+namespace host_test {
+
+/// 模拟的 CCM 堆区域字节数（CMakeLists.txt 中的 GDUT_HOST_CCM_HEAP_SIZE）
+inline constexpr std::size_t host_ccm_heap_size = GDUT_HOST_CCM_HEAP_SIZE;
+
+/// vTaskSuspendAll() 尚未配对 xTaskResumeAll() 的次数
+int &scheduler_suspended();
+
+} // namespace host_test
+
+#endif // FREERTOS_HOST_HPP
@@ -0,0 +1,201 @@
+#include "bsp_heap.hpp"
+#include "bsp_memory_resource.hpp"
+#include "freertos_host.hpp"
+#include "host_test.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// 同一份测试以默认配置（heap_test）与 GDUT_HEAP_PREFER_FAST=0
+// （heap_sram_only_test）各编译一次
+
+namespace {
+
+using gdut::heap_region;
+using gdut::rtos_heap;
+
+heap_region region_of(const void *p) {
+  heap_region region{};
+  HOST_CHECK(rtos_heap::region_of(p, region));
+  return region;
+}
+
+/// pvPortMalloc 的默认区域
+constexpr heap_region default_region =
+    GDUT_HEAP_PREFER_FAST ? heap_region::fast : heap_region::dma;
+
+void test_initial_state() {
+  // 统计会先初始化堆
+  const gdut::heap_region_stats fast = rtos_heap::stats(heap_region::fast);
+  const gdut::heap_region_stats dma = rtos_heap::stats(heap_region::dma);
+  HOST_CHECK(fast.size == host_test::host_ccm_heap_size);
+  HOST_CHECK(dma.size == GDUT_HEAP_DMA_SIZE);
+  HOST_CHECK(fast.free_bytes > 0 && fast.free_bytes < fast.size);
+  HOST_CHECK(dma.free_bytes > 0 && dma.free_bytes < dma.size);
+  HOST_CHECK(fast.free_blocks == 1 && dma.free_blocks == 1);
+  HOST_CHECK(rtos_heap::free_bytes() == fast.free_bytes + dma.free_bytes);
+  HOST_CHECK(xPortGetFreeHeapSize() == rtos_heap::free_bytes());
+  HOST_CHECK(pvPortMalloc(0) == nullptr);
+  vPortFree(nullptr);
+
+  int outside = 0;
+  heap_region region{};
+  HOST_CHECK(!rtos_heap::region_of(&outside, region));
+}
+
+void test_default_region() {
+  const std::size_t before = rtos_heap::free_bytes();
+  void *p = pvPortMalloc(100);
+  HOST_CHECK(p != nullptr);
+  HOST_CHECK(reinterpret_cast<uintptr_t>(p) % rtos_heap::alignment == 0);
+  HOST_CHECK(region_of(p) == default_region);
+  HOST_CHECK(rtos_heap::free_bytes() < before);
+  vPortFree(p);
+  HOST_CHECK(rtos_heap::free_bytes() == before);
+
+  // portable_resource 与 pvPortMalloc 使用同一策略
+  std::pmr::memory_resource *portable =
+      gdut::pmr::portable_resource::get_instance();
+  void *q = portable->allocate(64, rtos_heap::alignment);
+  HOST_CHECK(region_of(q) == default_region);
+  portable->deallocate(q, 64, rtos_heap::alignment);
+
+#if !GDUT_HEAP_PREFER_FAST
+  // 只从主 SRAM 分配：CCM 区域不被 pvPortMalloc 使用
+  HOST_CHECK(rtos_heap::stats(heap_region::fast).allocations == 0);
+#endif
+}
+
+void test_pinned_regions() {
+  // DMA 缓冲区的做法：显式指定 dma 区域，不受默认区域影响
+  void *dma = rtos_heap::allocate(256, heap_region::dma);
+  HOST_CHECK(dma != nullptr && region_of(dma) == heap_region::dma);
+  void *fast = rtos_heap::allocate(256, heap_region::fast);
+  HOST_CHECK(fast != nullptr && region_of(fast) == heap_region::fast);
+  vPortFree(dma);
+  vPortFree(fast);
+
+  std::pmr::memory_resource *dma_resource =
+      gdut::pmr::heap_region_resource<heap_region::dma>::get_instance();
+  void *buffer = dma_resource->allocate(128, rtos_heap::alignment);
+  HOST_CHECK(region_of(buffer) == heap_region::dma);
+  // 对齐要求超过堆的对齐时拒绝，而不是返回未对齐的内存
+  HOST_CHECK(dma_resource->allocate(16, rtos_heap::alignment * 2) == nullptr);
+  dma_resource->deallocate(buffer, 128, rtos_heap::alignment);
+
+  // 按区域分配不回退：区域耗尽时返回 nullptr 并计入该区域的失败次数
+  const uint32_t failures = rtos_heap::stats(heap_region::dma).failures;
+  HOST_CHECK(rtos_heap::allocate(GDUT_HEAP_DMA_SIZE, heap_region::dma) ==
+             nullptr);
+  HOST_CHECK(rtos_heap::stats(heap_region::dma).failures == failures + 1);
+}
+
+void test_fallback() {
+  // 默认区域写满后 pvPortMalloc 的去向
+  std::vector<void *> blocks;
+  void *p = nullptr;
+  while ((p = pvPortMalloc(512)) != nullptr) {
+    blocks.push_back(p);
+  }
+  std::size_t in_fast = 0;
+  std::size_t in_dma = 0;
+  for (void *block : blocks) {
+    (region_of(block) == heap_region::fast ? in_fast : in_dma) += 1;
+  }
+#if GDUT_HEAP_PREFER_FAST
+  // 先用完 CCM，再回退到主 SRAM
+  HOST_CHECK(in_fast > 0 && in_dma > 0);
+  HOST_CHECK(region_of(blocks.front()) == heap_region::fast);
+  HOST_CHECK(region_of(blocks.back()) == heap_region::dma);
+  // 两个区域都只剩不足一块的空间
+  HOST_CHECK(xPortGetMinimumEverFreeHeapSize() < 512 * 4);
+#else
+  HOST_CHECK(in_fast == 0 && in_dma > 0);
+  // CCM 仍可显式使用
+  void *fast = rtos_heap::allocate(512, heap_region::fast);
+  HOST_CHECK(fast != nullptr);
+  vPortFree(fast);
+#endif
+  for (void *block : blocks) {
+    vPortFree(block);
+  }
+}
+
+/// 随机分配/释放，检查对齐、内容不被覆盖，全部释放后空闲块完全合并
+void test_random_churn() {
+  const std::size_t initial = rtos_heap::free_bytes();
+  const gdut::heap_region_stats fast0 = rtos_heap::stats(heap_region::fast);
+  const gdut::heap_region_stats dma0 = rtos_heap::stats(heap_region::dma);
+
+  struct live_block {
+    unsigned char *p;
+    std::size_t bytes;
+    unsigned char fill;
+  };
+  std::vector<live_block> live;
+  std::mt19937 rng(1);
+  bool aligned = true;
+  bool intact = true;
+  unsigned char next_fill = 1;
+  for (int step = 0; step < 200000; ++step) {
+    if (live.empty() || rng() % 2 == 0) {
+      const std::size_t bytes = 1 + rng() % 600;
+      auto *p = static_cast<unsigned char *>(pvPortMalloc(bytes));
+      if (p == nullptr) {
+        continue;
+      }
+      aligned = aligned &&
+                reinterpret_cast<uintptr_t>(p) % rtos_heap::alignment == 0;
+      std::memset(p, next_fill, bytes);
+      live.push_back({p, bytes, next_fill});
+      next_fill = static_cast<unsigned char>(next_fill % 250 + 1);
+    } else {
+      const std::size_t k = rng() % live.size();
+      const live_block b = live[k];
+      for (std::size_t i = 0; i < b.bytes; ++i) {
+        intact = intact && b.p[i] == b.fill;
+      }
+      vPortFree(b.p);
+      live[k] = live.back();
+      live.pop_back();
+    }
+  }
+  HOST_CHECK(aligned);
+  HOST_CHECK(intact);
+  for (const live_block &b : live) {
+    vPortFree(b.p);
+  }
+
+  HOST_CHECK(rtos_heap::free_bytes() == initial);
+  const gdut::heap_region_stats fast = rtos_heap::stats(heap_region::fast);
+  const gdut::heap_region_stats dma = rtos_heap::stats(heap_region::dma);
+  HOST_CHECK(fast.free_blocks == 1 && dma.free_blocks == 1);
+  HOST_CHECK(fast.largest_free_block == fast0.largest_free_block);
+  HOST_CHECK(dma.largest_free_block == dma0.largest_free_block);
+  HOST_CHECK(fast.allocations - fast.frees == 0);
+  HOST_CHECK(dma.allocations - dma.frees == 0);
+
+  HeapStats_t heap{};
+  vPortGetHeapStats(&heap);
+  HOST_CHECK(heap.xAvailableHeapSpaceInBytes == initial);
+  HOST_CHECK(heap.xNumberOfFreeBlocks == 2);
+  HOST_CHECK(heap.xNumberOfSuccessfulAllocations ==
+             heap.xNumberOfSuccessfulFrees);
+  HOST_CHECK(heap.xMinimumEverFreeBytesRemaining <= initial);
+}
+
+} // namespace
+
+int main() {
+  test_initial_state();
+  test_default_region();
+  test_pinned_regions();
+  test_fallback();
+  test_random_churn();
+  // 每次 vTaskSuspendAll() 都有配对的 xTaskResumeAll()
+  HOST_CHECK(host_test::scheduler_suspended() == 0);
+  return host_test::finish();
+}
@@ -0,0 +1,35 @@
+#ifndef HOST_TEST_HPP
+#define HOST_TEST_HPP
+
+#include <cstdio>
+
+// 主机端测试的最小断言：失败时打印位置并计数，不中止，Release 下同样生效
+namespace host_test {
+
+inline int &failures() {
+  static int count = 0;
+  return count;
+}
+
+/// main() 的返回值：全部通过返回 0
+inline int finish() {
+  if (failures() != 0) {
+    std::fprintf(stderr, "%d check(s) failed\n", failures());
+    return 1;
+  }
+  std::puts("all checks passed");
+  return 0;
+}
+
+} // namespace host_test
+
+#define HOST_CHECK(condition)                                                  \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__,    \
+                   #condition);                                                \
+      ++host_test::failures();                                                 \
+    }                                                                          \
+  } while (0)
+
+#endif // HOST_TEST_HPP
@@ -0,0 +1,180 @@
+#include "bsp_memory_resource.hpp"
+#include "host_test.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t block_size = 40;
+constexpr std::size_t block_count = 16;
+
+using pool_t = gdut::pmr::lock_free_pool_resource<block_size, block_count>;
+
+void test_single_thread() {
+  pool_t pool;
+  HOST_CHECK(pool.available() == block_count);
+
+  std::vector<void *> blocks;
+  std::set<void *> unique;
+  for (std::size_t i = 0; i < block_count; ++i) {
+    void *p = pool.try_allocate();
+    HOST_CHECK(p != nullptr);
+    HOST_CHECK(pool.owns(p));
+    HOST_CHECK(reinterpret_cast<uintptr_t>(p) %
+                   alignof(std::max_align_t) ==
+               0);
+    std::memset(p, static_cast<int>(i), block_size);
+    blocks.push_back(p);
+    unique.insert(p);
+  }
+  HOST_CHECK(unique.size() == block_count);
+  HOST_CHECK(pool.try_allocate() == nullptr);
+  HOST_CHECK(pool.available() == 0 && pool.min_available() == 0);
+
+  // 块之间互不重叠
+  bool intact = true;
+  for (std::size_t i = 0; i < block_count; ++i) {
+    const auto *bytes = static_cast<const unsigned char *>(blocks[i]);
+    for (std::size_t j = 0; j < block_size; ++j) {
+      intact = intact && bytes[j] == static_cast<unsigned char>(i);
+    }
+  }
+  HOST_CHECK(intact);
+
+  // 不属于本池或不在块起点的指针被忽略
+  int outside = 0;
+  pool.release(&outside);
+  pool.release(static_cast<std::byte *>(blocks[0]) + 1);
+  HOST_CHECK(pool.available() == 0);
+
+  // 后进先出
+  pool.release(blocks[3]);
+  HOST_CHECK(pool.available() == 1);
+  HOST_CHECK(pool.try_allocate() == blocks[3]);
+  for (void *p : blocks) {
+    pool.release(p);
+  }
+  HOST_CHECK(pool.available() == block_count);
+  HOST_CHECK(pool.min_available() == 0);
+
+  // memory_resource 接口：超过块大小或对齐要求更高的请求不能满足
+  // （经 allocate() 会终止程序，这里只检查 fits()）
+  HOST_CHECK(!pool.fits(block_size + 1, 1));
+  HOST_CHECK(!pool.fits(8, alignof(std::max_align_t) * 2));
+  HOST_CHECK(!pool.fits(0, 1));
+  HOST_CHECK(pool.fits(block_size, alignof(std::max_align_t)));
+  std::pmr::memory_resource &resource = pool;
+  void *p = resource.allocate(block_size, alignof(std::max_align_t));
+  HOST_CHECK(p != nullptr);
+  resource.deallocate(p, block_size, alignof(std::max_align_t));
+  HOST_CHECK(pool.available() == block_count);
+}
+
+/**
+ * 多个线程（模拟任务与中断）同时分配与释放。每个块有一个占用标记：
+ * 分配后置位前必须为空，两个线程同时持有同一块即被发现；持有期间
+ * 写满线程专属的字节并在释放前检查，链表损坏导致的块重叠会破坏内容。
+ */
+void test_concurrent_stress() {
+  constexpr int thread_count = 6;
+  constexpr int rounds = 200000;
+  constexpr int hold_max = 3;
+
+  pool_t pool;
+  std::array<std::atomic<int>, block_count> owner{};
+  std::atomic<int> double_owned{0};
+  std::atomic<int> corrupted{0};
+  std::atomic<bool> go{false};
+
+  // 初始空闲栈自顶向下为 0 号块、1 号块……，首次分配得到 0 号块
+  auto *base = static_cast<std::byte *>(pool.try_allocate());
+  pool.release(base);
+  const std::size_t stride =
+      (block_size + alignof(std::max_align_t) - 1) /
+      alignof(std::max_align_t) * alignof(std::max_align_t);
+
+  auto worker = [&](int id) {
+    const auto fill = static_cast<unsigned char>(0x10 + id);
+    void *held[hold_max]{};
+    uint32_t state = static_cast<uint32_t>(id) * 2654435761U + 1U;
+    while (!go.load(std::memory_order_acquire)) {
+    }
+    for (int round = 0; round < rounds; ++round) {
+      state = state * 1103515245U + 12345U;
+      const int count = 1 + static_cast<int>((state >> 16) % hold_max);
+      int got = 0;
+      for (; got < count; ++got) {
+        void *p = pool.try_allocate();
+        if (p == nullptr) {
+          break;
+        }
+        const auto index = static_cast<std::size_t>(
+                               static_cast<std::byte *>(p) - base) /
+                           stride;
+        if (owner[index].exchange(id + 1, std::memory_order_relaxed) != 0) {
+          double_owned.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::memset(p, fill, block_size);
+        held[got] = p;
+      }
+      for (int i = 0; i < got; ++i) {
+        const auto *bytes = static_cast<const unsigned char *>(held[i]);
+        for (std::size_t j = 0; j < block_size; ++j) {
+          if (bytes[j] != fill) {
+            corrupted.fetch_add(1, std::memory_order_relaxed);
+            break;
+          }
+        }
+        const auto index = static_cast<std::size_t>(
+                               static_cast<const std::byte *>(held[i]) -
+                               base) /
+                           stride;
+        owner[index].store(0, std::memory_order_relaxed);
+        pool.release(held[i]);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int id = 0; id < thread_count; ++id) {
+    threads.emplace_back(worker, id);
+  }
+  go.store(true, std::memory_order_release);
+  for (std::thread &t : threads) {
+    t.join();
+  }
+
+  HOST_CHECK(double_owned.load() == 0);
+  HOST_CHECK(corrupted.load() == 0);
+  // 6 个线程每轮最多共持有 18 块，多于池中的 16 块，会走到池空的路径
+  HOST_CHECK(pool.available() == block_count);
+  HOST_CHECK(pool.min_available() < block_count);
+
+  // 没有块丢失或重复：全部取出恰好 block_count 个不同的块
+  std::set<void *> unique;
+  for (std::size_t i = 0; i < block_count; ++i) {
+    void *p = pool.try_allocate();
+    HOST_CHECK(p != nullptr);
+    unique.insert(p);
+  }
+  HOST_CHECK(unique.size() == block_count);
+  HOST_CHECK(pool.try_allocate() == nullptr);
+  for (void *p : unique) {
+    pool.release(p);
+  }
+}
+
+} // namespace
+
+int main() {
+  test_single_thread();
+  test_concurrent_stress();
+  return host_test::finish();
+}
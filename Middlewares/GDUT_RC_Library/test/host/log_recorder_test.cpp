@@ -0,0 +1,359 @@
+#include "bsp_log_recorder.hpp"
+#include "host_test.hpp"
+
+#include <cstdint>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t page_size = 256;
+constexpr std::size_t erase_size = 4096;
+
+using flash_t = gdut::ram_flash<16 * erase_size, page_size, erase_size>;
+
+/// 转发到 ram_flash 并统计读次数，用于检查挂载的读页数
+template <typename Flash> class counting_flash {
+public:
+  static constexpr std::size_t page_size = Flash::page_size;
+  static constexpr std::size_t erase_size = Flash::erase_size;
+
+  explicit counting_flash(Flash &flash) : m_flash(&flash) {}
+
+  [[nodiscard]] uint32_t capacity() const noexcept {
+    return m_flash->capacity();
+  }
+
+  std::error_code read(uint32_t address, std::span<uint8_t> buffer) {
+    ++reads;
+    return m_flash->read(address, buffer);
+  }
+
+  std::error_code program(uint32_t address, std::span<const uint8_t> data) {
+    return m_flash->program(address, data);
+  }
+
+  std::error_code erase(uint32_t address) { return m_flash->erase(address); }
+
+  [[nodiscard]] bool busy() const noexcept { return m_flash->busy(); }
+
+  uint32_t reads{0};
+
+private:
+  Flash *m_flash;
+};
+
+using recorder_t = gdut::log_recorder<flash_t, 2>;
+
+struct record_copy {
+  uint16_t session;
+  uint8_t type;
+  std::vector<uint8_t> payload;
+};
+
+template <typename Recorder>
+std::vector<record_copy> read_all(Recorder &recorder) {
+  std::vector<record_copy> records;
+  const std::error_code ec =
+      recorder.for_each([&records](const gdut::log_record &record) {
+        records.push_back({record.session, record.type,
+                           {record.payload.begin(), record.payload.end()}});
+      });
+  HOST_CHECK(!ec);
+  return records;
+}
+
+/// 第 index 条测试记录：长度 1~40 字节，内容由 index 决定
+std::vector<uint8_t> payload_of(uint32_t index) {
+  std::vector<uint8_t> payload(1 + index % 40);
+  for (std::size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(index * 7 + i);
+  }
+  return payload;
+}
+
+/// 追加 [first, first + count) 号记录，每条之后推进一步写入
+void append_range(recorder_t &recorder, uint32_t first, uint32_t count) {
+  for (uint32_t index = first; index < first + count; ++index) {
+    const std::vector<uint8_t> payload = payload_of(index);
+    HOST_CHECK(recorder.append(static_cast<uint8_t>(index), payload));
+    (void)recorder.service();
+  }
+}
+
+bool matches(const record_copy &record, uint32_t index, uint16_t session) {
+  return record.session == session &&
+         record.type == static_cast<uint8_t>(index) &&
+         record.payload == payload_of(index);
+}
+
+/// 从 first 号开始连续 count 条记录与 records[offset...] 一致
+bool matches_range(const std::vector<record_copy> &records,
+                   std::size_t offset, uint32_t first, uint32_t count,
+                   uint16_t session) {
+  if (records.size() < offset + count) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    if (!matches(records[offset + i], first + i, session)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void test_mount_and_scan() {
+  flash_t flash;
+  uint32_t used = 0;
+  {
+    recorder_t recorder(flash);
+    HOST_CHECK(recorder.append(1, std::span<const uint8_t>{}) == false);
+    HOST_CHECK(recorder.start() == gdut::log_error_code::not_mounted);
+    HOST_CHECK(!recorder.mount());
+    HOST_CHECK(recorder.session() == 0);
+    HOST_CHECK(recorder.used_bytes() == 0);
+    HOST_CHECK(!recorder.start());
+    append_range(recorder, 0, 100);
+    recorder.stop();
+    HOST_CHECK(!recorder.sync());
+    used = recorder.used_bytes();
+    HOST_CHECK(used > 0 && used % page_size == 0);
+
+    const std::vector<record_copy> records = read_all(recorder);
+    HOST_CHECK(records.size() == 100);
+    HOST_CHECK(matches_range(records, 0, 0, 100, 0));
+    HOST_CHECK(recorder.stats().records == 100);
+    HOST_CHECK(recorder.stats().dropped == 0);
+    HOST_CHECK(recorder.stats().corrupt_records == 0);
+  }
+
+  // 重新挂载：按页头二分查找写入位置，挂载序号递增
+  {
+    counting_flash<flash_t> counted(flash);
+    gdut::log_recorder<counting_flash<flash_t>, 2> recorder(counted);
+    HOST_CHECK(!recorder.mount());
+    HOST_CHECK(recorder.session() == 1);
+    HOST_CHECK(recorder.used_bytes() == used);
+    // 64 页：6 次二分 + 确认空页 + 读上一个完整页
+    HOST_CHECK(counted.reads <= 10);
+  }
+
+  recorder_t recorder(flash);
+  HOST_CHECK(!recorder.mount());
+  HOST_CHECK(!recorder.start());
+  append_range(recorder, 100, 30);
+  recorder.stop();
+  HOST_CHECK(!recorder.sync());
+  const std::vector<record_copy> records = read_all(recorder);
+  HOST_CHECK(records.size() == 130);
+  HOST_CHECK(matches_range(records, 0, 0, 100, 0));
+  HOST_CHECK(matches_range(records, 100, 100, 30, 1));
+
+  // 导出原始字节与清空
+  uint8_t raw[page_size];
+  HOST_CHECK(!recorder.read_raw(0, raw));
+  HOST_CHECK(raw[0] == 0x4C && raw[1] == 0x47);
+  HOST_CHECK(!recorder.erase_log());
+  HOST_CHECK(!recorder.mount());
+  HOST_CHECK(recorder.used_bytes() == 0);
+  HOST_CHECK(recorder.session() == 0);
+  HOST_CHECK(read_all(recorder).empty());
+}
+
+void test_torn_page_recovery() {
+  flash_t flash;
+  uint32_t used = 0;
+  {
+    recorder_t recorder(flash);
+    HOST_CHECK(!recorder.mount());
+    HOST_CHECK(!recorder.start());
+    append_range(recorder, 0, 60);
+    recorder.stop();
+    HOST_CHECK(!recorder.sync());
+    used = recorder.used_bytes();
+  }
+
+  // 掉电：下一页的负载已部分编程，页头仍为 0xFFFF
+  std::span<uint8_t> data = flash.data();
+  for (std::size_t i = 40; i < 120; ++i) {
+    data[used + i] = 0x00;
+  }
+  // 掉电：最后一个已写页的页尾没有编程完成
+  const uint32_t last_page = used - page_size;
+  const uint16_t last_used =
+      static_cast<uint16_t>(data[last_page + 4] | (data[last_page + 5] << 8));
+  data[last_page + last_used - 1] = 0xFF;
+  data[last_page + last_used - 2] = 0xFF;
+
+  recorder_t recorder(flash);
+  HOST_CHECK(!recorder.mount());
+  // 页头未写入但内容非空的页被跳过，不覆盖
+  HOST_CHECK(recorder.used_bytes() == used + page_size);
+  HOST_CHECK(recorder.session() == 1);
+  HOST_CHECK(!recorder.start());
+  append_range(recorder, 1000, 10);
+  recorder.stop();
+  HOST_CHECK(!recorder.sync());
+
+  const std::vector<record_copy> records = read_all(recorder);
+  // 最后一个已写页的末条记录 CRC 失败，其余记录完好
+  HOST_CHECK(recorder.stats().corrupt_records == 1);
+  HOST_CHECK(records.size() == 59 + 10);
+  HOST_CHECK(matches_range(records, 0, 0, 59, 0));
+  HOST_CHECK(matches_range(records, 59, 1000, 10, 1));
+}
+
+/// 第二次挂载的最后一页编程了一半：页头有效，但挂载序号与末条记录未写完
+void test_torn_page_mid_session() {
+  flash_t flash;
+  uint32_t first_used = 0;
+  {
+    recorder_t recorder(flash);
+    HOST_CHECK(!recorder.mount());
+    HOST_CHECK(!recorder.start());
+    append_range(recorder, 0, 30);
+    recorder.stop();
+    HOST_CHECK(!recorder.sync());
+    first_used = recorder.used_bytes();
+  }
+  uint32_t used = 0;
+  {
+    recorder_t recorder(flash);
+    HOST_CHECK(!recorder.mount());
+    HOST_CHECK(recorder.session() == 1);
+    HOST_CHECK(!recorder.start());
+    append_range(recorder, 100, 60);
+    recorder.stop();
+    HOST_CHECK(!recorder.sync());
+    used = recorder.used_bytes();
+  }
+  HOST_CHECK(used >= first_used + 2 * page_size);
+
+  // 掉电：最后一页的挂载序号字段与页尾仍为 0xFF
+  std::span<uint8_t> data = flash.data();
+  const uint32_t last_page = used - page_size;
+  const uint16_t last_used =
+      static_cast<uint16_t>(data[last_page + 4] | (data[last_page + 5] << 8));
+  data[last_page + 2] = 0xFF;
+  data[last_page + 3] = 0xFF;
+  data[last_page + last_used - 1] = 0xFF;
+
+  recorder_t recorder(flash);
+  HOST_CHECK(!recorder.mount());
+  HOST_CHECK(recorder.used_bytes() == used);
+  // 取前一个完整页（第二次挂载）的序号，而不是残缺页头中的 0xFFFF
+  HOST_CHECK(recorder.session() == 2);
+  HOST_CHECK(!recorder.start());
+  append_range(recorder, 1000, 10);
+  recorder.stop();
+  HOST_CHECK(!recorder.sync());
+
+  const std::vector<record_copy> records = read_all(recorder);
+  HOST_CHECK(matches_range(records, 0, 0, 30, 0));
+  HOST_CHECK(matches_range(records, 30, 100, 10, 1));
+  // 本次挂载的记录只以新的序号出现，且不与已有序号混淆
+  std::size_t session_2 = 0;
+  for (const record_copy &record : records) {
+    session_2 += record.session == 2 ? 1 : 0;
+  }
+  HOST_CHECK(session_2 == 10);
+  HOST_CHECK(matches_range(records, records.size() - 10, 1000, 10, 2));
+}
+
+void test_crc_rejection() {
+  flash_t flash;
+  recorder_t recorder(flash);
+  HOST_CHECK(!recorder.mount());
+  HOST_CHECK(!recorder.start());
+  append_range(recorder, 0, 40);
+  recorder.stop();
+  HOST_CHECK(!recorder.sync());
+  HOST_CHECK(recorder.used_bytes() >= 2 * page_size);
+
+  const std::vector<record_copy> intact = read_all(recorder);
+  HOST_CHECK(intact.size() == 40);
+  std::size_t first_page_records = 0;
+  {
+    // 第一页中的记录数：按页内偏移重建
+    const std::span<uint8_t> data = flash.data();
+    const uint16_t used = static_cast<uint16_t>(data[4] | (data[5] << 8));
+    for (std::size_t offset = recorder_t::page_header_size; offset < used;
+         offset += recorder_t::record_header_size + data[offset]) {
+      ++first_page_records;
+    }
+  }
+  HOST_CHECK(first_page_records > 3);
+
+  // 翻转第一页第三条记录负载中的一位
+  std::span<uint8_t> data = flash.data();
+  std::size_t offset = recorder_t::page_header_size;
+  for (int i = 0; i < 2; ++i) {
+    offset += recorder_t::record_header_size + data[offset];
+  }
+  data[offset + recorder_t::record_header_size] ^= 0x10U;
+
+  const std::vector<record_copy> records = read_all(recorder);
+  HOST_CHECK(recorder.stats().corrupt_records == 1);
+  // 校验失败后跳过该页剩余部分，后续页照常读出
+  HOST_CHECK(records.size() == 40 - (first_page_records - 2));
+  HOST_CHECK(matches_range(records, 0, 0, 2, 0));
+  HOST_CHECK(matches_range(records, 2,
+                           static_cast<uint32_t>(first_page_records),
+                           static_cast<uint32_t>(40 - first_page_records),
+                           0));
+
+  // 长度字段被破坏（超出页内已用字节）同样被拒绝
+  data[recorder_t::page_header_size] = 0xFE;
+  const std::vector<record_copy> truncated = read_all(recorder);
+  HOST_CHECK(recorder.stats().corrupt_records == 2);
+  HOST_CHECK(truncated.size() == 40 - first_page_records);
+}
+
+void test_full_flash() {
+  using small_flash_t = gdut::ram_flash<2 * erase_size, page_size, erase_size>;
+  small_flash_t flash;
+  gdut::log_recorder<small_flash_t, 2> recorder(flash);
+  HOST_CHECK(!recorder.mount());
+  HOST_CHECK(!recorder.start());
+
+  uint32_t accepted = 0;
+  uint32_t rejected = 0;
+  std::error_code last{};
+  const std::vector<uint8_t> payload(60, 0x5A);
+  for (int i = 0; i < 2000 && recorder.recording(); ++i) {
+    if (recorder.append(3, payload)) {
+      ++accepted;
+    } else {
+      ++rejected;
+    }
+    if (std::error_code ec = recorder.service()) {
+      last = ec;
+    }
+  }
+  HOST_CHECK(last == gdut::log_error_code::full);
+  HOST_CHECK(!recorder.recording());
+  HOST_CHECK(recorder.used_bytes() == 2 * erase_size);
+  (void)recorder.sync();
+
+  // 写满后丢弃的记录与暂存区满时拒绝的记录都计入 dropped
+  const gdut::log_recorder_stats stats = recorder.stats();
+  std::vector<record_copy> records;
+  HOST_CHECK(!recorder.for_each([&records](const gdut::log_record &record) {
+    records.push_back({record.session, record.type, {}});
+  }));
+  HOST_CHECK(stats.records == accepted);
+  HOST_CHECK(records.size() + stats.dropped == accepted + rejected);
+  HOST_CHECK(stats.pages_written == 2 * erase_size / page_size);
+}
+
+} // namespace
+
+int main() {
+  test_mount_and_scan();
+  test_torn_page_recovery();
+  test_torn_page_mid_session();
+  test_crc_rejection();
+  test_full_flash();
+  return host_test::finish();
+}
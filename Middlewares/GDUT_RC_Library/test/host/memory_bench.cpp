@@ -0,0 +1,85 @@
+// 内存资源的主机基准（不注册为 ctest 测试，手动运行）：
+//   cmake -S Middlewares/GDUT_RC_Library/test/host -B build-bench \
+//     -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench --target memory_bench && build-bench/memory_bench
+//
+// 结果只用于比较同一台主机上的不同资源；目标板上的周期数以
+// docs/BSP/bsp_memory_resource.md 中基于 cycle_counter 的代码实测。
+
+#include "bsp_memory_resource.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory_resource>
+#include <random>
+
+namespace {
+
+constexpr int iterations = 20000000;
+
+/// 64 个随机大小（16/24/48/96 字节）的存活对象上循环“释放一个、再分配
+/// 一个”，返回每对操作的纳秒数
+double mixed_pairs(std::pmr::memory_resource &resource) {
+  constexpr int live = 64;
+  constexpr std::size_t sizes[] = {16, 24, 48, 96};
+  void *blocks[live]{};
+  std::size_t block_bytes[live]{};
+  std::mt19937 rng(1);
+  for (int i = 0; i < live; ++i) {
+    block_bytes[i] = sizes[rng() % 4];
+    blocks[i] = resource.allocate(block_bytes[i], 8);
+  }
+
+  const auto begin = std::chrono::steady_clock::now();
+  uint32_t state = 0;
+  for (int i = 0; i < iterations; ++i) {
+    state = state * 1103515245U + 12345U;
+    const int k = static_cast<int>((state >> 16) % live);
+    resource.deallocate(blocks[k], block_bytes[k], 8);
+    block_bytes[k] = sizes[(state >> 8) & 3U];
+    blocks[k] = resource.allocate(block_bytes[k], 8);
+    *static_cast<volatile char *>(blocks[k]) = 1;
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < live; ++i) {
+    resource.deallocate(blocks[i], block_bytes[i], 8);
+  }
+  return std::chrono::duration<double, std::nano>(end - begin).count() /
+         iterations;
+}
+
+/// 单线程连续“分配一个、再释放”，返回每对操作的纳秒数
+double fixed_pairs(std::pmr::memory_resource &resource, std::size_t bytes) {
+  const auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    void *p = resource.allocate(bytes, 8);
+    *static_cast<volatile char *>(p) = 1;
+    resource.deallocate(p, bytes, 8);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() /
+         iterations;
+}
+
+} // namespace
+
+int main() {
+  // 上游用 new_delete_resource：主机上 max_align_t 的对齐超过
+  // portBYTE_ALIGNMENT，portable_resource 会拒绝
+  gdut::pmr::unsynchronized_tlsf_resource tlsf(
+      std::pmr::new_delete_resource(), 16384);
+  gdut::pmr::slab_resource<16, 24, 48, 96> slab(
+      std::pmr::new_delete_resource());
+
+  std::printf("mixed sizes, free+alloc pair:\n");
+  std::printf("  unsynchronized_tlsf_resource %6.2f ns\n", mixed_pairs(tlsf));
+  std::printf("  slab_resource                %6.2f ns\n", mixed_pairs(slab));
+
+  gdut::pmr::lock_free_pool_resource<64, 32> pool;
+  std::printf("fixed size, alloc+free pair:\n");
+  std::printf("  lock_free_pool_resource      %6.2f ns\n",
+              fixed_pairs(pool, 64));
+  return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/*
+ * 主机测试用的 FreeRTOS 移植层头文件，替代 portable/GCC/ARM_CM4F。
+ *
+ * 只提供 FreeRTOS.h、task.h 与固件的 FreeRTOSConfig.h 需要的类型和宏，
+ * 使依赖 FreeRTOS 头文件的模块（bsp_heap、bsp_memory_resource）能在主机上
+ * 编译；调度器本身不参与测试。configASSERT 经 portDISABLE_INTERRUPTS()
+ * 展开为 abort()，断言失败时测试进程以错误退出而不是死循环。
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define portCHAR char
+#define portFLOAT float
+#define portDOUBLE double
+#define portLONG long
+#define portSHORT short
+#define portSTACK_TYPE uint32_t
+#define portBASE_TYPE long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if (configUSE_16_BIT_TICKS == 1)
+typedef uint16_t TickType_t;
+#define portMAX_DELAY (TickType_t)0xffff
+#else
+typedef uint32_t TickType_t;
+#define portMAX_DELAY (TickType_t)0xffffffffUL
+#endif
+
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+#define portSTACK_GROWTH (-1)
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT 8
+
+#define portYIELD()
+#define portEND_SWITCHING_ISR(xSwitchRequired) (void)(xSwitchRequired)
+#define portYIELD_FROM_ISR(x) portEND_SWITCHING_ISR(x)
+
+#define portSET_INTERRUPT_MASK_FROM_ISR() 0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) (void)(x)
+#define portDISABLE_INTERRUPTS() abort()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters)                       \
+  void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters)                             \
+  void vFunction(void *pvParameters)
+
+#define portNOP()
+#define portINLINE inline
+#define portFORCE_INLINE inline __attribute__((always_inline))
+#define portMEMORY_BARRIER() __asm volatile("" ::: "memory")
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
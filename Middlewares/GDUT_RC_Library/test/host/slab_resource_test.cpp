@@ -0,0 +1,205 @@
+#include "bsp_memory_resource.hpp"
+#include "host_test.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t granule = alignof(std::max_align_t);
+
+/// 记录上游分配的资源，可设置剩余可分配次数以模拟上游耗尽
+class counting_upstream : public std::pmr::memory_resource {
+public:
+  std::size_t live{0};
+  std::size_t allocations{0};
+  std::size_t remaining{SIZE_MAX};
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (remaining == 0) {
+      return nullptr;
+    }
+    --remaining;
+    ++live;
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    --live;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+using slab_t = gdut::pmr::slab_resource<16, 24, 48, 96>;
+
+// 尺寸类按 granule 取整后映射
+static_assert(slab_t::block_sizes[0] == 16);
+static_assert(slab_t::max_block_size == (96 + granule - 1) / granule * granule);
+static_assert(slab_t::class_index(1) == 0);
+static_assert(slab_t::class_index(16) == 0);
+static_assert(slab_t::class_index(17) ==
+              (granule == 16 ? 1 : slab_t::class_index(24)));
+static_assert(slab_t::class_index(96) == slab_t::class_count - 1);
+static_assert(slab_t::class_index(97) == slab_t::class_count);
+
+void test_reuse_and_stats() {
+  counting_upstream upstream;
+  {
+    slab_t slab(&upstream, 256);
+    void *a = slab.allocate(10);
+    void *b = slab.allocate(12);
+    HOST_CHECK(a != nullptr && b != nullptr && a != b);
+    HOST_CHECK(reinterpret_cast<uintptr_t>(a) % granule == 0);
+    HOST_CHECK(reinterpret_cast<uintptr_t>(b) % granule == 0);
+    HOST_CHECK(upstream.allocations == 1);
+
+    gdut::pmr::slab_class_stats s = slab.stats(0);
+    HOST_CHECK(s.block_size == slab_t::block_sizes[0]);
+    HOST_CHECK(s.in_use == 2 && s.peak == 2 && s.pages == 1);
+    HOST_CHECK(s.capacity > 2);
+
+    // 释放的块最先被复用
+    slab.deallocate(a, 10);
+    HOST_CHECK(slab.allocate(16) == a);
+    slab.deallocate(a, 16);
+    slab.deallocate(b, 12);
+    s = slab.stats(0);
+    HOST_CHECK(s.in_use == 0 && s.peak == 2);
+
+    // 各尺寸类的页相互独立
+    void *c = slab.allocate(90);
+    HOST_CHECK(slab.stats(slab_t::class_count - 1).in_use == 1);
+    HOST_CHECK(upstream.allocations == 2);
+    slab.deallocate(c, 90);
+    HOST_CHECK(slab.stats(slab_t::class_count).block_size == 0);
+  }
+  // 析构归还全部页
+  HOST_CHECK(upstream.live == 0);
+}
+
+void test_page_growth() {
+  counting_upstream upstream;
+  slab_t slab(&upstream, 256);
+  std::vector<void *> blocks;
+  for (int i = 0; i < 100; ++i) {
+    blocks.push_back(slab.allocate(40));
+  }
+  const gdut::pmr::slab_class_stats s = slab.stats(slab_t::class_index(40));
+  HOST_CHECK(s.in_use == 100);
+  HOST_CHECK(s.capacity >= 100);
+  HOST_CHECK(s.pages == upstream.allocations);
+  // 页只在当前页用完时申请：容量不超过需要的块数加一页
+  HOST_CHECK(s.capacity - 100 < s.capacity / s.pages);
+  for (void *p : blocks) {
+    slab.deallocate(p, 40);
+  }
+  // 再次分配同样多的块不再申请新页
+  const std::size_t pages = upstream.allocations;
+  for (int i = 0; i < 100; ++i) {
+    blocks[i] = slab.allocate(40);
+  }
+  HOST_CHECK(upstream.allocations == pages);
+  for (void *p : blocks) {
+    slab.deallocate(p, 40);
+  }
+}
+
+void test_upstream_forwarding() {
+  counting_upstream upstream;
+  slab_t slab(&upstream, 256);
+  // 超过最大尺寸类或对齐要求更高：直接转发，不占用尺寸类
+  void *big = slab.allocate(slab_t::max_block_size + 1);
+  HOST_CHECK(upstream.allocations == 1 && upstream.live == 1);
+  void *aligned = slab.allocate(16, granule * 2);
+  HOST_CHECK(reinterpret_cast<uintptr_t>(aligned) % (granule * 2) == 0);
+  HOST_CHECK(upstream.live == 2);
+  for (std::size_t i = 0; i < slab_t::class_count; ++i) {
+    HOST_CHECK(slab.stats(i).pages == 0);
+  }
+  slab.deallocate(big, slab_t::max_block_size + 1);
+  slab.deallocate(aligned, 16, granule * 2);
+  HOST_CHECK(upstream.live == 0);
+
+  // 上游耗尽：当前页用完后分配失败，已有的块不受影响
+  upstream.remaining = 1;
+  std::vector<void *> blocks;
+  void *p = nullptr;
+  while ((p = slab.allocate(96)) != nullptr) {
+    blocks.push_back(p);
+  }
+  HOST_CHECK(!blocks.empty());
+  HOST_CHECK(blocks.size() == slab.stats(slab_t::class_count - 1).capacity);
+  for (void *block : blocks) {
+    slab.deallocate(block, 96);
+  }
+}
+
+/// 随机分配/释放，每个块写入与编号相关的内容，释放前检查未被覆盖
+void test_random_integrity() {
+  counting_upstream upstream;
+  {
+    slab_t slab(&upstream, 512);
+    struct live_block {
+      unsigned char *p;
+      std::size_t bytes;
+      unsigned char fill;
+    };
+    std::vector<live_block> live;
+    std::mt19937 rng(7);
+    bool intact = true;
+    unsigned char next_fill = 1;
+    for (int step = 0; step < 200000; ++step) {
+      if (live.empty() || (live.size() < 300 && rng() % 2 == 0)) {
+        const std::size_t bytes = 1 + rng() % 120;
+        auto *p = static_cast<unsigned char *>(slab.allocate(bytes));
+        std::memset(p, next_fill, bytes);
+        live.push_back({p, bytes, next_fill});
+        next_fill = static_cast<unsigned char>(next_fill % 250 + 1);
+      } else {
+        const std::size_t k = rng() % live.size();
+        const live_block b = live[k];
+        for (std::size_t i = 0; i < b.bytes; ++i) {
+          intact = intact && b.p[i] == b.fill;
+        }
+        slab.deallocate(b.p, b.bytes);
+        live[k] = live.back();
+        live.pop_back();
+      }
+    }
+    HOST_CHECK(intact);
+    std::size_t in_use = 0;
+    for (std::size_t i = 0; i < slab_t::class_count; ++i) {
+      in_use += slab.stats(i).in_use;
+    }
+    std::size_t small = 0;
+    for (const live_block &b : live) {
+      small += b.bytes <= slab_t::max_block_size ? 1 : 0;
+    }
+    HOST_CHECK(in_use == small);
+    for (const live_block &b : live) {
+      slab.deallocate(b.p, b.bytes);
+    }
+  }
+  HOST_CHECK(upstream.live == 0);
+}
+
+} // namespace
+
+int main() {
+  test_reuse_and_stats();
+  test_page_growth();
+  test_upstream_forwarding();
+  test_random_integrity();
+  return host_test::finish();
+}